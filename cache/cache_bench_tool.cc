@@ -21,6 +21,7 @@
 #include "rocksdb/convenience.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
+#include "rocksdb/memory_allocator.h"
 #include "rocksdb/secondary_cache.h"
 #include "rocksdb/system_clock.h"
 #include "rocksdb/table_properties.h"
@@ -82,7 +83,13 @@ DEFINE_bool(lean, false,
 DEFINE_string(secondary_cache_uri, "",
               "Full URI for creating a custom secondary cache object");
 static class std::shared_ptr<ROCKSDB_NAMESPACE::SecondaryCache> secondary_cache;
+
+DEFINE_string(memory_allocator_uri, "",
+              "Full URI for creating a custom memory allocator for the cache "
+              "values, e.g. \"id=HugePageSlabAllocator; capacity=2147483648\"");
 #endif  // ROCKSDB_LITE
+static class std::shared_ptr<ROCKSDB_NAMESPACE::MemoryAllocator>
+    memory_allocator;
 
 DEFINE_string(cache_type, "lru_cache", "Type of block cache.");
 
@@ -228,7 +235,10 @@ struct KeyGen {
 };
 
 char* createValue(Random64& rnd) {
-  char* rv = new char[FLAGS_value_bytes];
+  char* rv = memory_allocator != nullptr
+                 ? static_cast<char*>(memory_allocator->Allocate(
+                       FLAGS_value_bytes))
+                 : new char[FLAGS_value_bytes];
   // Fill with some filler data, and take some CPU time
   for (uint32_t i = 0; i < FLAGS_value_bytes; i += 8) {
     EncodeFixed64(rv + i, rnd.Next());
@@ -236,6 +246,14 @@ char* createValue(Random64& rnd) {
   return rv;
 }
 
+void deleteValue(void* value) {
+  if (memory_allocator != nullptr) {
+    memory_allocator->Deallocate(value);
+  } else {
+    delete[] static_cast<char*>(value);
+  }
+}
+
 // Callbacks for secondary cache
 size_t SizeFn(void* /*obj*/) { return FLAGS_value_bytes; }
 
@@ -247,13 +265,13 @@ Status SaveToFn(void* obj, size_t /*offset*/, size_t size, void* out) {
 // Different deleters to simulate using deleter to gather
 // stats on the code origin and kind of cache entries.
 void deleter1(const Slice& /*key*/, void* value) {
-  delete[] static_cast<char*>(value);
+  deleteValue(value);
 }
 void deleter2(const Slice& /*key*/, void* value) {
-  delete[] static_cast<char*>(value);
+  deleteValue(value);
 }
 void deleter3(const Slice& /*key*/, void* value) {
-  delete[] static_cast<char*>(value);
+  deleteValue(value);
 }
 
 Cache::CacheItemHelper helper1(SizeFn, SaveToFn, deleter1);
@@ -290,12 +308,28 @@ class CacheBench {
       if (max_key > (static_cast<uint64_t>(1) << max_log_)) max_log_++;
     }
 
+#ifndef ROCKSDB_LITE
+    if (!FLAGS_memory_allocator_uri.empty()) {
+      Status s = MemoryAllocator::CreateFromString(
+          ConfigOptions(), FLAGS_memory_allocator_uri, &memory_allocator);
+      if (memory_allocator == nullptr) {
+        fprintf(stderr,
+                "No memory allocator registered matching string: %s "
+                "status=%s\n",
+                FLAGS_memory_allocator_uri.c_str(), s.ToString().c_str());
+        exit(1);
+      }
+    }
+#endif  // ROCKSDB_LITE
+
     if (FLAGS_cache_type == "clock_cache") {
       fprintf(stderr, "Old clock cache implementation has been removed.\n");
       exit(1);
     } else if (FLAGS_cache_type == "hyper_clock_cache") {
       cache_ = HyperClockCacheOptions(FLAGS_cache_size, FLAGS_value_bytes,
-                                      FLAGS_num_shard_bits)
+                                      FLAGS_num_shard_bits,
+                                      false /*strict_capacity_limit*/,
+                                      memory_allocator)
                    .MakeSharedCache();
     } else if (FLAGS_cache_type == "fast_lru_cache") {
       cache_ = NewFastLRUCache(
@@ -305,6 +339,7 @@ class CacheBench {
       LRUCacheOptions opts(FLAGS_cache_size, FLAGS_num_shard_bits,
                            false /* strict_capacity_limit */,
                            0.5 /* high_pri_pool_ratio */);
+      opts.memory_allocator = memory_allocator;
 #ifndef ROCKSDB_LITE
       if (!FLAGS_secondary_cache_uri.empty()) {
         Status s = SecondaryCache::CreateFromString(
@@ -409,6 +444,26 @@ class CacheBench {
 
     printf("\n%s", stats_report.c_str());
 
+    HugePageSlabAllocatorStats slab_stats;
+    if (GetHugePageSlabAllocatorStats(memory_allocator.get(), &slab_stats)
+            .ok()) {
+      printf("\nHuge page slab allocator:\n");
+      printf("Reserved            : %s%s\n",
+             BytesToHumanString(slab_stats.reserved_bytes).c_str(),
+             slab_stats.huge_pages ? " (huge pages)" : "");
+      printf("Slabs               : %s\n",
+             BytesToHumanString(slab_stats.slab_bytes).c_str());
+      printf("Allocated           : %s in %" PRIu64 " allocations\n",
+             BytesToHumanString(slab_stats.allocated_bytes).c_str(),
+             slab_stats.num_allocations);
+      printf("Fragmentation       : %.2f%%\n",
+             slab_stats.slab_bytes == 0
+                 ? 0.0
+                 : 100.0 * slab_stats.free_bytes / slab_stats.slab_bytes);
+      printf("Fallback allocations: %" PRIu64 "\n",
+             slab_stats.num_fallback_allocations);
+    }
+
     return true;
   }
 
@@ -629,6 +684,8 @@ class CacheBench {
     printf("Cache size          : %s\n",
            BytesToHumanString(FLAGS_cache_size).c_str());
     printf("Num shard bits      : %u\n", FLAGS_num_shard_bits);
+    printf("Memory allocator    : %s\n",
+           memory_allocator != nullptr ? memory_allocator->Name() : "new[]");
     printf("Max key             : %" PRIu64 "\n", max_key_);
     printf("Resident ratio      : %g\n", FLAGS_resident_ratio);
     printf("Skew degree         : %u\n", FLAGS_skew);
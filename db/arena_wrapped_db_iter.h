@@ -16,6 +16,7 @@
 #include "db/db_iter.h"
 #include "db/range_del_aggregator.h"
 #include "memory/arena.h"
+#include "monitoring/user_operation_registry.h"
 #include "options/cf_options.h"
 #include "rocksdb/db.h"
 #include "rocksdb/iterator.h"
@@ -36,6 +37,8 @@ class Version;
 class ArenaWrappedDBIter : public Iterator {
  public:
   ~ArenaWrappedDBIter() override {
+    // Before the column family may go away with the super version
+    user_op_.Unregister();
     if (db_iter_ != nullptr) {
       db_iter_->~DBIter();
     } else {
@@ -60,16 +63,32 @@ class ArenaWrappedDBIter : public Iterator {
   }
 
   bool Valid() const override { return db_iter_->Valid(); }
-  void SeekToFirst() override { db_iter_->SeekToFirst(); }
-  void SeekToLast() override { db_iter_->SeekToLast(); }
+  void SeekToFirst() override {
+    ActiveUserOperationGuard active_user_op(&user_op_);
+    db_iter_->SeekToFirst();
+  }
+  void SeekToLast() override {
+    ActiveUserOperationGuard active_user_op(&user_op_);
+    db_iter_->SeekToLast();
+  }
   // 'target' does not contain timestamp, even if user timestamp feature is
   // enabled.
-  void Seek(const Slice& target) override { db_iter_->Seek(target); }
+  void Seek(const Slice& target) override {
+    ActiveUserOperationGuard active_user_op(&user_op_);
+    db_iter_->Seek(target);
+  }
   void SeekForPrev(const Slice& target) override {
+    ActiveUserOperationGuard active_user_op(&user_op_);
     db_iter_->SeekForPrev(target);
   }
-  void Next() override { db_iter_->Next(); }
-  void Prev() override { db_iter_->Prev(); }
+  void Next() override {
+    ActiveUserOperationGuard active_user_op(&user_op_);
+    db_iter_->Next();
+  }
+  void Prev() override {
+    ActiveUserOperationGuard active_user_op(&user_op_);
+    db_iter_->Prev();
+  }
   Slice key() const override { return db_iter_->key(); }
   Slice value() const override { return db_iter_->value(); }
   const WideColumns& columns() const override { return db_iter_->columns(); }
@@ -89,6 +108,14 @@ class ArenaWrappedDBIter : public Iterator {
             ReadCallback* read_callback, DBImpl* db_impl, ColumnFamilyData* cfd,
             bool expose_blob_index, bool allow_refresh);
 
+  // Reports the iterator as a live user operation in `registry` until it is
+  // destroyed. No-op if `registry` is nullptr. `cf_name` has to outlive the
+  // iterator.
+  void RegisterUserOperation(UserOperationRegistry* registry,
+                             const std::string& cf_name) {
+    user_op_.Register(registry, UserOperation::kIterator, &cf_name);
+  }
+
   // Store some parameters so we can refresh the iterator at a later point
   // with these same params
   void StoreRefreshInfo(DBImpl* db_impl, ColumnFamilyData* cfd,
@@ -112,6 +139,7 @@ class ArenaWrappedDBIter : public Iterator {
   // If this is nullptr, it means the mutable memtable does not contain range
   // tombstone when added under this DBIter.
   TruncatedRangeDelIterator** memtable_range_tombstone_iter_ = nullptr;
+  UserOperation user_op_;
 };
 
 // Generate the arena wrapped iterator class.
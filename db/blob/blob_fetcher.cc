@@ -5,7 +5,10 @@
 
 #include "db/blob/blob_fetcher.h"
 
+#include <vector>
+
 #include "db/version_set.h"
+#include "db/wide/wide_column_serialization.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -31,4 +34,50 @@ Status BlobFetcher::FetchBlob(const Slice& user_key,
                            blob_value, bytes_read);
 }
 
+Status BlobFetcher::ResolveEntity(const Slice& user_key, const Slice& entity,
+                                  std::string* resolved_entity,
+                                  uint64_t* bytes_read) const {
+  assert(version_);
+  assert(resolved_entity);
+
+  Slice input = entity;
+  WideColumns columns;
+  std::vector<WideColumnSerialization::ColumnValueType> value_types;
+
+  Status s = WideColumnSerialization::DeserializeWithBlobIndices(
+      input, columns, value_types);
+  if (!s.ok()) {
+    return s;
+  }
+
+  std::vector<PinnableSlice> blob_values(columns.size());
+  uint64_t total_bytes_read = 0;
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (value_types[i] != WideColumnSerialization::kColumnBlobIndex) {
+      continue;
+    }
+
+    constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
+    uint64_t blob_bytes_read = 0;
+
+    s = FetchBlob(user_key, columns[i].value(), prefetch_buffer,
+                  &blob_values[i], &blob_bytes_read);
+    if (!s.ok()) {
+      return s;
+    }
+
+    total_bytes_read += blob_bytes_read;
+    columns[i].value() = blob_values[i];
+  }
+
+  if (bytes_read) {
+    *bytes_read = total_bytes_read;
+  }
+
+  resolved_entity->clear();
+
+  return WideColumnSerialization::Serialize(columns, *resolved_entity);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
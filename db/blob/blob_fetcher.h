@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "rocksdb/options.h"
 #include "rocksdb/status.h"
 
@@ -30,6 +32,13 @@ class BlobFetcher {
                    FilePrefetchBuffer* prefetch_buffer,
                    PinnableSlice* blob_value, uint64_t* bytes_read) const;
 
+  // Fetches the values of the columns of a wide-column entity that are stored
+  // in blob files, and serializes the entity with all of its values inline
+  // into `resolved_entity`.
+  Status ResolveEntity(const Slice& user_key, const Slice& entity,
+                       std::string* resolved_entity,
+                       uint64_t* bytes_read) const;
+
  private:
   const Version* version_;
   ReadOptions read_options_;
@@ -67,6 +67,8 @@ BlobFileBuilder::BlobFileBuilder(
       blob_file_size_(mutable_cf_options->blob_file_size),
       blob_compression_type_(mutable_cf_options->blob_compression_type),
       prepopulate_blob_cache_(mutable_cf_options->prepopulate_blob_cache),
+      separate_wide_column_values_(
+          mutable_cf_options->enable_wide_column_blob_files),
       file_options_(file_options),
       db_id_(std::move(db_id)),
       db_session_id_(std::move(db_session_id)),
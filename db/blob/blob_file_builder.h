@@ -72,6 +72,11 @@ class BlobFileBuilder {
   Status Finish();
   void Abandon(const Status& s);
 
+  // Whether the column values of wide-column entities are to be added too
+  bool separate_wide_column_values() const {
+    return separate_wide_column_values_;
+  }
+
  private:
   bool IsBlobFileOpen() const;
   Status OpenBlobFileIfNeeded();
@@ -91,6 +96,7 @@ class BlobFileBuilder {
   uint64_t blob_file_size_;
   CompressionType blob_compression_type_;
   PrepopulateBlobCache prepopulate_blob_cache_;
+  bool separate_wide_column_values_;
   const FileOptions* file_options_;
   const std::string db_id_;
   const std::string db_session_id_;
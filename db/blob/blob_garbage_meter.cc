@@ -5,62 +5,57 @@
 
 #include "db/blob/blob_garbage_meter.h"
 
+#include <vector>
+
 #include "db/blob/blob_index.h"
 #include "db/blob/blob_log_format.h"
 #include "db/dbformat.h"
+#include "db/wide/wide_column_serialization.h"
 
 namespace ROCKSDB_NAMESPACE {
 
 Status BlobGarbageMeter::ProcessInFlow(const Slice& key, const Slice& value) {
-  uint64_t blob_file_number = kInvalidBlobFileNumber;
-  uint64_t bytes = 0;
+  BlobReferences blobs;
 
-  const Status s = Parse(key, value, &blob_file_number, &bytes);
+  const Status s = Parse(key, value, &blobs);
   if (!s.ok()) {
     return s;
   }
 
-  if (blob_file_number == kInvalidBlobFileNumber) {
-    return Status::OK();
+  for (const auto& blob : blobs) {
+    flows_[blob.first].AddInFlow(blob.second);
   }
 
-  flows_[blob_file_number].AddInFlow(bytes);
-
   return Status::OK();
 }
 
 Status BlobGarbageMeter::ProcessOutFlow(const Slice& key, const Slice& value) {
-  uint64_t blob_file_number = kInvalidBlobFileNumber;
-  uint64_t bytes = 0;
+  BlobReferences blobs;
 
-  const Status s = Parse(key, value, &blob_file_number, &bytes);
+  const Status s = Parse(key, value, &blobs);
   if (!s.ok()) {
     return s;
   }
 
-  if (blob_file_number == kInvalidBlobFileNumber) {
-    return Status::OK();
-  }
+  for (const auto& blob : blobs) {
+    // Note: in order to measure the amount of additional garbage, we only need
+    // to track the outflow for preexisting files, i.e. those that also had
+    // inflow. (Newly written files would only have outflow.)
+    auto it = flows_.find(blob.first);
+    if (it == flows_.end()) {
+      continue;
+    }
 
-  // Note: in order to measure the amount of additional garbage, we only need to
-  // track the outflow for preexisting files, i.e. those that also had inflow.
-  // (Newly written files would only have outflow.)
-  auto it = flows_.find(blob_file_number);
-  if (it == flows_.end()) {
-    return Status::OK();
+    it->second.AddOutFlow(blob.second);
   }
 
-  it->second.AddOutFlow(bytes);
-
   return Status::OK();
 }
 
 Status BlobGarbageMeter::Parse(const Slice& key, const Slice& value,
-                               uint64_t* blob_file_number, uint64_t* bytes) {
-  assert(blob_file_number);
-  assert(*blob_file_number == kInvalidBlobFileNumber);
-  assert(bytes);
-  assert(*bytes == 0);
+                               BlobReferences* blobs) {
+  assert(blobs);
+  assert(blobs->empty());
 
   ParsedInternalKey ikey;
 
@@ -72,14 +67,48 @@ Status BlobGarbageMeter::Parse(const Slice& key, const Slice& value,
     }
   }
 
-  if (ikey.type != kTypeBlobIndex) {
+  if (ikey.type == kTypeBlobIndex) {
+    return AddBlobReference(ikey.user_key, value, blobs);
+  }
+
+  if (ikey.type != kTypeWideColumnEntity ||
+      !WideColumnSerialization::HasBlobIndices(value)) {
     return Status::OK();
   }
 
+  Slice input = value;
+  WideColumns columns;
+  std::vector<WideColumnSerialization::ColumnValueType> value_types;
+
+  {
+    const Status s = WideColumnSerialization::DeserializeWithBlobIndices(
+        input, columns, value_types);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (value_types[i] != WideColumnSerialization::kColumnBlobIndex) {
+      continue;
+    }
+
+    const Status s = AddBlobReference(ikey.user_key, columns[i].value(), blobs);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status BlobGarbageMeter::AddBlobReference(const Slice& user_key,
+                                          const Slice& blob_index_slice,
+                                          BlobReferences* blobs) {
   BlobIndex blob_index;
 
   {
-    const Status s = blob_index.DecodeFrom(value);
+    const Status s = blob_index.DecodeFrom(blob_index_slice);
     if (!s.ok()) {
       return s;
     }
@@ -89,10 +118,14 @@ Status BlobGarbageMeter::Parse(const Slice& key, const Slice& value,
     return Status::Corruption("Unexpected TTL/inlined blob index");
   }
 
-  *blob_file_number = blob_index.file_number();
-  *bytes =
+  if (blob_index.file_number() == kInvalidBlobFileNumber) {
+    return Status::OK();
+  }
+
+  blobs->emplace_back(
+      blob_index.file_number(),
       blob_index.size() +
-      BlobLogRecord::CalculateAdjustmentForRecordHeader(ikey.user_key.size());
+          BlobLogRecord::CalculateAdjustmentForRecordHeader(user_key.size()));
 
   return Status::OK();
 }
@@ -8,10 +8,12 @@
 #include <cassert>
 #include <cstdint>
 #include <unordered_map>
+#include <utility>
 
 #include "db/blob/blob_constants.h"
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/status.h"
+#include "util/autovector.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -93,8 +95,14 @@ class BlobGarbageMeter {
   }
 
  private:
+  // The blob file number and size of each blob referenced by an entry
+  using BlobReferences = autovector<std::pair<uint64_t, uint64_t>, 1>;
+
   static Status Parse(const Slice& key, const Slice& value,
-                      uint64_t* blob_file_number, uint64_t* bytes);
+                      BlobReferences* blobs);
+  static Status AddBlobReference(const Slice& user_key,
+                                 const Slice& blob_index_slice,
+                                 BlobReferences* blobs);
 
   std::unordered_map<uint64_t, BlobInOutFlow> flows_;
 };
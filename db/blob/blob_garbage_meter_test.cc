@@ -11,6 +11,7 @@
 #include "db/blob/blob_index.h"
 #include "db/blob/blob_log_format.h"
 #include "db/dbformat.h"
+#include "db/wide/wide_column_serialization.h"
 #include "test_util/testharness.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -138,6 +139,53 @@ TEST(BlobGarbageMeterTest, PlainValue) {
   ASSERT_TRUE(blob_garbage_meter.flows().empty());
 }
 
+TEST(BlobGarbageMeterTest, WideColumnEntity) {
+  constexpr char user_key[] = "user_key";
+  constexpr SequenceNumber seq = 123;
+
+  const InternalKey key(user_key, seq, kTypeWideColumnEntity);
+  const Slice key_slice = key.Encode();
+
+  // Two column values stored in blob file 4 and one inline
+  std::string first_blob_index;
+  BlobIndex::EncodeBlob(&first_blob_index, 4, 1234, 555, kNoCompression);
+  std::string second_blob_index;
+  BlobIndex::EncodeBlob(&second_blob_index, 4, 6789, 1010, kNoCompression);
+
+  const WideColumns columns{
+      {"a", first_blob_index}, {"b", "inline"}, {"c", second_blob_index}};
+  const std::vector<WideColumnSerialization::ColumnValueType> value_types{
+      WideColumnSerialization::kColumnBlobIndex,
+      WideColumnSerialization::kColumnValue,
+      WideColumnSerialization::kColumnBlobIndex};
+
+  std::string entity;
+  ASSERT_OK(WideColumnSerialization::SerializeWithBlobIndices(
+      columns, value_types, entity));
+
+  BlobGarbageMeter blob_garbage_meter;
+
+  ASSERT_OK(blob_garbage_meter.ProcessInFlow(key_slice, entity));
+
+  const auto& flows = blob_garbage_meter.flows();
+  ASSERT_EQ(flows.size(), 1);
+
+  const auto it = flows.find(4);
+  ASSERT_NE(it, flows.end());
+
+  const auto& in = it->second.GetInFlow();
+  ASSERT_EQ(in.GetCount(), 2);
+  ASSERT_EQ(in.GetBytes(),
+            555 + 1010 +
+                2 * BlobLogRecord::CalculateAdjustmentForRecordHeader(
+                        sizeof(user_key) - 1));
+
+  // The entity gets written out unchanged, so there is no garbage
+  ASSERT_OK(blob_garbage_meter.ProcessOutFlow(key_slice, entity));
+  ASSERT_TRUE(it->second.IsValid());
+  ASSERT_FALSE(it->second.HasGarbage());
+}
+
 TEST(BlobGarbageMeterTest, CorruptInternalKey) {
   constexpr char corrupt_key[] = "i_am_corrupt";
   const Slice key_slice(corrupt_key);
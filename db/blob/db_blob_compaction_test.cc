@@ -789,6 +789,60 @@ TEST_F(DBBlobCompactionTest, CompactionReadaheadGarbageCollection) {
   Close();
 }
 
+TEST_F(DBBlobCompactionTest, GarbageCollectionByFileRatio) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+  options.enable_blob_garbage_collection = true;
+  options.blob_garbage_collection_age_cutoff = 0.0;
+  options.blob_garbage_collection_file_ratio_threshold = 0.5;
+  options.disable_auto_compactions = true;
+
+  Reopen(options);
+
+  ASSERT_OK(Put("a", "a1"));
+  ASSERT_OK(Put("b", "b1"));
+  ASSERT_OK(Put("c", "c1"));
+  ASSERT_OK(Put("d", "d1"));
+  ASSERT_OK(Flush());
+
+  ASSERT_OK(Put("a", "a2"));
+  ASSERT_OK(Put("b", "b2"));
+  ASSERT_OK(Put("c", "c2"));
+  ASSERT_OK(Flush());
+
+  const std::vector<uint64_t> original_blob_files = GetBlobFileNumbers();
+  ASSERT_EQ(original_blob_files.size(), 2);
+
+  // Turns three quarters of the first blob file into garbage. Its blobs were
+  // not garbage when the compaction started, so they are not relocated.
+  constexpr Slice* begin = nullptr;
+  constexpr Slice* end = nullptr;
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), begin, end));
+  ASSERT_EQ(GetBlobFileNumbers(), original_blob_files);
+
+  // The SST linked to the first blob file gets compacted, relocating its
+  // last valid blob even though the age cutoff excludes all blob files. The
+  // second blob file has no garbage and stays.
+  ASSERT_OK(db_->SetOptions({{"disable_auto_compactions", "false"}}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  const std::vector<uint64_t> blob_files = GetBlobFileNumbers();
+  ASSERT_EQ(std::find(blob_files.begin(), blob_files.end(),
+                      original_blob_files[0]),
+            blob_files.end());
+  ASSERT_NE(std::find(blob_files.begin(), blob_files.end(),
+                      original_blob_files[1]),
+            blob_files.end());
+
+  ASSERT_EQ(Get("a"), "a2");
+  ASSERT_EQ(Get("b"), "b2");
+  ASSERT_EQ(Get("c"), "c2");
+  ASSERT_EQ(Get("d"), "d1");
+
+  Close();
+}
+
 TEST_F(DBBlobCompactionTest, CompactionReadaheadFilter) {
   Options options = GetDefaultOptions();
 
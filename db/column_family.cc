@@ -783,13 +783,13 @@ const double kNearStopSlowdownRatio = 0.6;
 const double kDelayRecoverSlowdownRatio = 1.4;
 
 namespace {
+const uint64_t kMinWriteRate = 16 * 1024u;  // Minimum write rate 16KB/s.
+
 // If penalize_stop is true, we further reduce slowdown rate.
 std::unique_ptr<WriteControllerToken> SetupDelay(
     WriteController* write_controller, uint64_t compaction_needed_bytes,
     uint64_t prev_compaction_need_bytes, bool penalize_stop,
     bool auto_compactions_disabled) {
-  const uint64_t kMinWriteRate = 16 * 1024u;  // Minimum write rate 16KB/s.
-
   uint64_t max_write_rate = write_controller->max_delayed_write_rate();
   uint64_t write_rate = write_controller->delayed_write_rate();
 
@@ -847,6 +847,27 @@ std::unique_ptr<WriteControllerToken> SetupDelay(
   return write_controller->GetDelayToken(write_rate);
 }
 
+// Used instead of SetupDelay() with `smooth_write_delay`. `stop_distance` is
+// how far the column family is from its slowdown threshold (0) to its stop
+// threshold (1). The write rate falls linearly with it from what compaction
+// can sustain, or the user's rate if lower or unknown, down to the minimum.
+std::unique_ptr<WriteControllerToken> SetupSmoothDelay(
+    WriteController* write_controller, double stop_distance,
+    uint64_t sustainable_write_rate) {
+  uint64_t max_write_rate = write_controller->max_delayed_write_rate();
+  uint64_t write_rate = max_write_rate;
+  if (max_write_rate > kMinWriteRate) {
+    if (sustainable_write_rate > 0 && sustainable_write_rate < write_rate) {
+      write_rate = sustainable_write_rate;
+    }
+    stop_distance = std::min(std::max(stop_distance, 0.0), 1.0);
+    write_rate = std::max(
+        kMinWriteRate, static_cast<uint64_t>(static_cast<double>(write_rate) *
+                                             (1.0 - stop_distance)));
+  }
+  return write_controller->GetDelayToken(write_rate);
+}
+
 int GetL0ThresholdSpeedupCompaction(int level0_file_num_compaction_trigger,
                                     int level0_slowdown_writes_trigger) {
   // SanitizeOptions() ensures it.
@@ -936,6 +957,8 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
 
     bool was_stopped = write_controller->IsStopped();
     bool needed_delay = write_controller->NeedsDelay();
+    bool smooth_delay = ioptions_.smooth_write_delay &&
+                        !mutable_cf_options.disable_auto_compactions;
 
     if (write_stall_condition == WriteStallCondition::kStopped &&
         write_stall_cause == WriteStallCause::kMemtableLimit) {
@@ -988,10 +1011,24 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
       // L0 is the last two files from stopping.
       bool near_stop = vstorage->l0_delay_trigger_count() >=
                        mutable_cf_options.level0_stop_writes_trigger - 2;
-      write_controller_token_ =
-          SetupDelay(write_controller, compaction_needed_bytes,
-                     prev_compaction_needed_bytes_, was_stopped || near_stop,
-                     mutable_cf_options.disable_auto_compactions);
+      if (smooth_delay) {
+        int slowdown_trigger =
+            mutable_cf_options.level0_slowdown_writes_trigger;
+        int stop_trigger = mutable_cf_options.level0_stop_writes_trigger;
+        double stop_distance =
+            stop_trigger > slowdown_trigger
+                ? static_cast<double>(vstorage->l0_delay_trigger_count() -
+                                      slowdown_trigger) /
+                      (stop_trigger - slowdown_trigger)
+                : 1.0;
+        write_controller_token_ = SetupSmoothDelay(
+            write_controller, stop_distance, GetSustainableWriteRate());
+      } else {
+        write_controller_token_ =
+            SetupDelay(write_controller, compaction_needed_bytes,
+                       prev_compaction_needed_bytes_, was_stopped || near_stop,
+                       mutable_cf_options.disable_auto_compactions);
+      }
       internal_stats_->AddCFStats(InternalStats::L0_FILE_COUNT_LIMIT_SLOWDOWNS,
                                   1);
       if (compaction_picker_->IsLevel0CompactionInProgress()) {
@@ -1017,10 +1054,26 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
                    mutable_cf_options.soft_pending_compaction_bytes_limit) /
                   4;
 
-      write_controller_token_ =
-          SetupDelay(write_controller, compaction_needed_bytes,
-                     prev_compaction_needed_bytes_, was_stopped || near_stop,
-                     mutable_cf_options.disable_auto_compactions);
+      if (smooth_delay) {
+        uint64_t soft_limit =
+            mutable_cf_options.soft_pending_compaction_bytes_limit;
+        uint64_t hard_limit =
+            mutable_cf_options.hard_pending_compaction_bytes_limit;
+        // Without a hard limit, writes are only held to what compaction
+        // can sustain
+        double stop_distance =
+            hard_limit > soft_limit
+                ? static_cast<double>(compaction_needed_bytes - soft_limit) /
+                      (hard_limit - soft_limit)
+                : 0.0;
+        write_controller_token_ = SetupSmoothDelay(
+            write_controller, stop_distance, GetSustainableWriteRate());
+      } else {
+        write_controller_token_ =
+            SetupDelay(write_controller, compaction_needed_bytes,
+                       prev_compaction_needed_bytes_, was_stopped || near_stop,
+                       mutable_cf_options.disable_auto_compactions);
+      }
       internal_stats_->AddCFStats(
           InternalStats::PENDING_COMPACTION_BYTES_LIMIT_SLOWDOWNS, 1);
       ROCKS_LOG_WARN(
@@ -1081,6 +1134,19 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
   return write_stall_condition;
 }
 
+uint64_t ColumnFamilyData::GetSustainableWriteRate() {
+#ifndef ROCKSDB_LITE
+  // Every byte written costs (write amplification - 1) bytes of compaction
+  // beyond its flush
+  InternalStats::CompactionForecast forecast;
+  internal_stats_->GetCompactionForecast(&forecast);
+  return static_cast<uint64_t>(forecast.compaction_bytes_per_sec /
+                               std::max(1.0, forecast.estimated_write_amp - 1));
+#else
+  return 0;
+#endif  // !ROCKSDB_LITE
+}
+
 const FileOptions* ColumnFamilyData::soptions() const {
   return &(column_family_set_->file_options_);
 }
@@ -1426,6 +1492,12 @@ Status ColumnFamilyData::ValidateOptions(
           "The garbage ratio threshold for forcing blob garbage collection "
           "should be in the range [0.0, 1.0].");
     }
+    if (cf_options.blob_garbage_collection_file_ratio_threshold <= 0.0 ||
+        cf_options.blob_garbage_collection_file_ratio_threshold > 1.0) {
+      return Status::InvalidArgument(
+          "The per file garbage ratio threshold for blob garbage collection "
+          "should be in the range (0.0, 1.0].");
+    }
   }
 
   if (cf_options.compaction_style == kCompactionStyleFIFO &&
@@ -548,6 +548,11 @@ class ColumnFamilyData {
 
   std::vector<std::string> GetDbPaths() const;
 
+  // The write rate that the compaction throughput measured over the last
+  // minute or two, all concurrent compactions together, can keep up with, or
+  // 0 if unknown. Used with `smooth_write_delay`.
+  uint64_t GetSustainableWriteRate();
+
   uint32_t id_;
   const std::string name_;
   Version* dummy_versions_;  // Head of circular doubly-linked list of versions.
@@ -14,6 +14,7 @@
 
 #include "db/db_impl/db_impl.h"
 #include "db/db_test_util.h"
+#include "env/composite_env_wrapper.h"
 #include "options/options_parser.h"
 #include "port/port.h"
 #include "port/stack_trace.h"
@@ -22,6 +23,7 @@
 #include "rocksdb/env.h"
 #include "rocksdb/iterator.h"
 #include "rocksdb/utilities/object_registry.h"
+#include "test_util/mock_time_env.h"
 #include "test_util/sync_point.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
@@ -2724,6 +2726,119 @@ TEST_P(ColumnFamilyTest, WriteStallSingleColumnFamily) {
   ASSERT_EQ(kBaseRate / 1.25, GetDbDelayedWriteRate());
 }
 
+TEST_P(ColumnFamilyTest, SmoothWriteStallSingleColumnFamily) {
+  const uint64_t kBaseRate = 800000u;
+  db_options_.delayed_write_rate = kBaseRate;
+  db_options_.smooth_write_delay = true;
+
+  Open({"default"});
+  ColumnFamilyData* cfd =
+      static_cast<ColumnFamilyHandleImpl*>(db_->DefaultColumnFamily())->cfd();
+
+  VersionStorageInfo* vstorage = cfd->current()->storage_info();
+
+  MutableCFOptions mutable_cf_options(column_family_options_);
+
+  mutable_cf_options.level0_slowdown_writes_trigger = 20;
+  mutable_cf_options.level0_stop_writes_trigger = 30;
+  mutable_cf_options.soft_pending_compaction_bytes_limit = 200;
+  mutable_cf_options.hard_pending_compaction_bytes_limit = 2000;
+  mutable_cf_options.disable_auto_compactions = false;
+
+  // No compaction has run, so the rate only follows the distance from the
+  // slowdown to the stop threshold, whichever way the debt moves.
+  vstorage->TEST_set_estimated_compaction_needed_bytes(200);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(dbfull()->TEST_write_controler().NeedsDelay());
+  ASSERT_EQ(kBaseRate, GetDbDelayedWriteRate());
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(1100);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_EQ(kBaseRate / 2, GetDbDelayedWriteRate());
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(1550);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_EQ(kBaseRate / 4, GetDbDelayedWriteRate());
+
+  // Unchanged debt keeps the rate
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_EQ(kBaseRate / 4, GetDbDelayedWriteRate());
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(1999);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!IsDbWriteStopped());
+  ASSERT_EQ(16 * 1024u, GetDbDelayedWriteRate());
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(650);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_EQ(kBaseRate / 4 * 3, GetDbDelayedWriteRate());
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(2000);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(IsDbWriteStopped());
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(0);
+  vstorage->set_l0_delay_trigger_count(25);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!IsDbWriteStopped());
+  ASSERT_TRUE(dbfull()->TEST_write_controler().NeedsDelay());
+  ASSERT_EQ(kBaseRate / 2, GetDbDelayedWriteRate());
+
+  vstorage->set_l0_delay_trigger_count(0);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!dbfull()->TEST_write_controler().NeedsDelay());
+}
+
+#ifndef ROCKSDB_LITE
+TEST_P(ColumnFamilyTest, SmoothWriteStallConcurrentCompactions) {
+  const uint64_t kBaseRate = 800000u;
+  auto mock_clock = std::make_shared<MockSystemClock>(env_->GetSystemClock());
+  CompositeEnvWrapper env(env_, mock_clock);
+  db_options_.env = &env;
+  db_options_.delayed_write_rate = kBaseRate;
+  db_options_.smooth_write_delay = true;
+  db_options_.max_background_compactions = 2;
+
+  Open({"default"});
+  ColumnFamilyData* cfd =
+      static_cast<ColumnFamilyHandleImpl*>(db_->DefaultColumnFamily())->cfd();
+
+  VersionStorageInfo* vstorage = cfd->current()->storage_info();
+
+  MutableCFOptions mutable_cf_options(column_family_options_);
+
+  mutable_cf_options.soft_pending_compaction_bytes_limit = 200;
+  mutable_cf_options.hard_pending_compaction_bytes_limit = 2000;
+  mutable_cf_options.disable_auto_compactions = false;
+
+  // Two compactions ran side by side for ten seconds, reading 1MB each
+  const uint64_t kJobBytes = 1 << 20;
+  mock_clock->MockSleepForSeconds(10);
+  InternalStats::CompactionStats stats;
+  stats.micros = 10 * 1000000;
+  stats.bytes_read_non_output_levels = kJobBytes;
+  dbfull()->TEST_LockMutex();
+  cfd->internal_stats()->AddCompactionStats(1, Env::Priority::LOW, stats);
+  cfd->internal_stats()->AddCompactionStats(1, Env::Priority::LOW, stats);
+  dbfull()->TEST_UnlockMutex();
+
+  // Right at the soft limit writes are held to what both compactions
+  // together get through, twice what either of them does. Nothing has been
+  // flushed, so there is no write amplification beyond the flush.
+  vstorage->TEST_set_estimated_compaction_needed_bytes(200);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(dbfull()->TEST_write_controler().NeedsDelay());
+  ASSERT_EQ(2 * kJobBytes / 10, GetDbDelayedWriteRate());
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(1100);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_EQ(2 * kJobBytes / 10 / 2, GetDbDelayedWriteRate());
+
+  Close();
+  db_options_.env = env_;
+}
+#endif  // ROCKSDB_LITE
+
 TEST_P(ColumnFamilyTest, CompactionSpeedupSingleColumnFamily) {
   db_options_.max_background_compactions = 6;
   Open({"default"});
@@ -3422,6 +3537,27 @@ TEST(ColumnFamilyTest, ValidateBlobGCForceThreshold) {
                   .IsInvalidArgument());
 }
 
+TEST(ColumnFamilyTest, ValidateBlobGCFileRatioThreshold) {
+  DBOptions db_options;
+
+  ColumnFamilyOptions cf_options;
+  cf_options.enable_blob_garbage_collection = true;
+
+  cf_options.blob_garbage_collection_file_ratio_threshold = 0.0;
+  ASSERT_TRUE(ColumnFamilyData::ValidateOptions(db_options, cf_options)
+                  .IsInvalidArgument());
+
+  cf_options.blob_garbage_collection_file_ratio_threshold = 0.5;
+  ASSERT_OK(ColumnFamilyData::ValidateOptions(db_options, cf_options));
+
+  cf_options.blob_garbage_collection_file_ratio_threshold = 1.0;
+  ASSERT_OK(ColumnFamilyData::ValidateOptions(db_options, cf_options));
+
+  cf_options.blob_garbage_collection_file_ratio_threshold = 1.5;
+  ASSERT_TRUE(ColumnFamilyData::ValidateOptions(db_options, cf_options)
+                  .IsInvalidArgument());
+}
+
 TEST(ColumnFamilyTest, ValidateMemtableKVChecksumOption) {
   DBOptions db_options;
 
@@ -5,6 +5,7 @@
 
 #include "db/compaction/compaction_iterator.h"
 
+#include <algorithm>
 #include <iterator>
 #include <limits>
 
@@ -13,6 +14,7 @@
 #include "db/blob/blob_index.h"
 #include "db/blob/prefetch_buffer_collection.h"
 #include "db/snapshot_checker.h"
+#include "db/wide/wide_column_serialization.h"
 #include "logging/logging.h"
 #include "port/likely.h"
 #include "rocksdb/listener.h"
@@ -101,6 +103,8 @@ CompactionIterator::CompactionIterator(
       merge_out_iter_(merge_helper_),
       blob_garbage_collection_cutoff_file_number_(
           ComputeBlobGarbageCollectionCutoffFileNumber(compaction_.get())),
+      blob_garbage_collection_files_by_ratio_(
+          ComputeBlobGarbageCollectionFilesByRatio(compaction_.get())),
       blob_fetcher_(CreateBlobFetcherIfNeeded(compaction_.get())),
       prefetch_buffers_(
           CreatePrefetchBufferCollectionIfNeeded(compaction_.get())),
@@ -1023,8 +1027,7 @@ void CompactionIterator::GarbageCollectBlobIfNeeded() {
       }
     }
 
-    if (blob_index.file_number() >=
-        blob_garbage_collection_cutoff_file_number_) {
+    if (!ShouldGarbageCollectBlobFile(blob_index.file_number())) {
       return;
     }
 
@@ -1096,6 +1099,143 @@ void CompactionIterator::GarbageCollectBlobIfNeeded() {
   }
 }
 
+bool CompactionIterator::ShouldGarbageCollectBlobFile(
+    uint64_t blob_file_number) const {
+  return blob_file_number < blob_garbage_collection_cutoff_file_number_ ||
+         std::binary_search(blob_garbage_collection_files_by_ratio_.begin(),
+                            blob_garbage_collection_files_by_ratio_.end(),
+                            blob_file_number);
+}
+
+void CompactionIterator::ExtractLargeColumnValuesIfNeeded() {
+  assert(ikey_.type == kTypeWideColumnEntity);
+
+  // Column values are only separated when explicitly enabled, as that
+  // changes the serialization format of the entity
+  const bool extract = blob_file_builder_ &&
+                       blob_file_builder_->separate_wide_column_values();
+  const bool garbage_collect = compaction_ &&
+                               compaction_->enable_blob_garbage_collection() &&
+                               WideColumnSerialization::HasBlobIndices(value_);
+
+  if (!extract && !garbage_collect) {
+    return;
+  }
+
+  Slice input = value_;
+  WideColumns columns;
+  std::vector<WideColumnSerialization::ColumnValueType> value_types;
+
+  {
+    const Status s = WideColumnSerialization::DeserializeWithBlobIndices(
+        input, columns, value_types);
+    if (!s.ok()) {
+      status_ = s;
+      validity_info_.Invalidate();
+
+      return;
+    }
+  }
+
+  // Relocated column values and the blob references of newly extracted ones
+  std::vector<PinnableSlice> blob_values(garbage_collect ? columns.size() : 0);
+  std::vector<std::string> blob_indices(columns.size());
+  bool changed = false;
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    Slice& value = columns[i].value();
+
+    if (value_types[i] == WideColumnSerialization::kColumnBlobIndex) {
+      if (!garbage_collect) {
+        continue;
+      }
+
+      BlobIndex blob_index;
+
+      {
+        const Status s = blob_index.DecodeFrom(value);
+        if (!s.ok()) {
+          status_ = s;
+          validity_info_.Invalidate();
+
+          return;
+        }
+      }
+
+      if (!ShouldGarbageCollectBlobFile(blob_index.file_number())) {
+        continue;
+      }
+
+      FilePrefetchBuffer* prefetch_buffer =
+          prefetch_buffers_ ? prefetch_buffers_->GetOrCreatePrefetchBuffer(
+                                  blob_index.file_number())
+                            : nullptr;
+
+      uint64_t bytes_read = 0;
+
+      {
+        assert(blob_fetcher_);
+
+        const Status s =
+            blob_fetcher_->FetchBlob(user_key(), blob_index, prefetch_buffer,
+                                     &blob_values[i], &bytes_read);
+        if (!s.ok()) {
+          status_ = s;
+          validity_info_.Invalidate();
+
+          return;
+        }
+      }
+
+      ++iter_stats_.num_blobs_read;
+      iter_stats_.total_blob_bytes_read += bytes_read;
+
+      ++iter_stats_.num_blobs_relocated;
+      iter_stats_.total_blob_bytes_relocated += blob_index.size();
+
+      value = blob_values[i];
+      value_types[i] = WideColumnSerialization::kColumnValue;
+      changed = true;
+    }
+
+    if (!extract) {
+      continue;
+    }
+
+    const Status s =
+        blob_file_builder_->Add(user_key(), value, &blob_indices[i]);
+    if (!s.ok()) {
+      status_ = s;
+      validity_info_.Invalidate();
+
+      return;
+    }
+
+    if (!blob_indices[i].empty()) {
+      value = blob_indices[i];
+      value_types[i] = WideColumnSerialization::kColumnBlobIndex;
+      changed = true;
+    }
+  }
+
+  if (!changed) {
+    return;
+  }
+
+  entity_value_.clear();
+
+  const Status s = WideColumnSerialization::SerializeWithBlobIndices(
+      columns, value_types, entity_value_);
+  if (!s.ok()) {
+    status_ = s;
+    validity_info_.Invalidate();
+
+    return;
+  }
+
+  value_ = entity_value_;
+}
+
 void CompactionIterator::DecideOutputLevel() {
   assert(compaction_->SupportsPerKeyPlacement());
 #ifndef NDEBUG
@@ -1149,6 +1289,8 @@ void CompactionIterator::PrepareOutput() {
       ExtractLargeValueIfNeeded();
     } else if (ikey_.type == kTypeBlobIndex) {
       GarbageCollectBlobIfNeeded();
+    } else if (ikey_.type == kTypeWideColumnEntity) {
+      ExtractLargeColumnValuesIfNeeded();
     }
 
     if (compaction_ != nullptr && compaction_->SupportsPerKeyPlacement()) {
@@ -1292,6 +1434,39 @@ uint64_t CompactionIterator::ComputeBlobGarbageCollectionCutoffFileNumber(
   return meta->GetBlobFileNumber();
 }
 
+std::vector<uint64_t>
+CompactionIterator::ComputeBlobGarbageCollectionFilesByRatio(
+    const CompactionProxy* compaction) {
+  std::vector<uint64_t> file_numbers;
+
+  if (!compaction || !compaction->enable_blob_garbage_collection()) {
+    return file_numbers;
+  }
+
+  const double threshold =
+      compaction->blob_garbage_collection_file_ratio_threshold();
+  if (threshold >= 1.0) {
+    return file_numbers;
+  }
+
+  const Version* const version = compaction->input_version();
+  assert(version);
+
+  const VersionStorageInfo* const storage_info = version->storage_info();
+  assert(storage_info);
+
+  for (const auto& meta : storage_info->GetBlobFiles()) {
+    assert(meta);
+
+    if (meta->GetGarbageBlobBytes() >=
+        threshold * static_cast<double>(meta->GetTotalBlobBytes())) {
+      file_numbers.push_back(meta->GetBlobFileNumber());
+    }
+  }
+
+  return file_numbers;
+}
+
 std::unique_ptr<BlobFetcher> CompactionIterator::CreateBlobFetcherIfNeeded(
     const CompactionProxy* compaction) {
   if (!compaction) {
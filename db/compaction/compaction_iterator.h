@@ -99,6 +99,8 @@ class CompactionIterator {
 
     virtual double blob_garbage_collection_age_cutoff() const = 0;
 
+    virtual double blob_garbage_collection_file_ratio_threshold() const = 0;
+
     virtual uint64_t blob_compaction_readahead_size() const = 0;
 
     virtual const Version* input_version() const = 0;
@@ -156,6 +158,11 @@ class CompactionIterator {
       return compaction_->blob_garbage_collection_age_cutoff();
     }
 
+    double blob_garbage_collection_file_ratio_threshold() const override {
+      return compaction_->mutable_cf_options()
+          ->blob_garbage_collection_file_ratio_threshold;
+    }
+
     uint64_t blob_compaction_readahead_size() const override {
       return compaction_->mutable_cf_options()->blob_compaction_readahead_size;
     }
@@ -284,6 +291,16 @@ class CompactionIterator {
   // algorithm is also called from here.
   void GarbageCollectBlobIfNeeded();
 
+  // Returns whether the valid blobs of the given blob file are relocated by
+  // the integrated BlobDB implementation's garbage collection.
+  bool ShouldGarbageCollectBlobFile(uint64_t blob_file_number) const;
+
+  // Extracts the large column values of a wide-column entity to blob files and
+  // relocates its column values residing in blob files that are garbage
+  // collected, like the above do for plain values and blob references.
+  // Should only be called for wide-column entities (kTypeWideColumnEntity).
+  void ExtractLargeColumnValuesIfNeeded();
+
   // Invoke compaction filter if needed.
   // Return true on success, false on failures (e.g.: kIOError).
   bool InvokeFilterIfNeeded(bool* need_skip, Slice* skip_until);
@@ -323,6 +340,10 @@ class CompactionIterator {
 
   static uint64_t ComputeBlobGarbageCollectionCutoffFileNumber(
       const CompactionProxy* compaction);
+  // Returns the blob files that are garbage collected because of their ratio
+  // of garbage, in increasing file number order
+  static std::vector<uint64_t> ComputeBlobGarbageCollectionFilesByRatio(
+      const CompactionProxy* compaction);
   static std::unique_ptr<BlobFetcher> CreateBlobFetcherIfNeeded(
       const CompactionProxy* compaction);
   static std::unique_ptr<PrefetchBufferCollection>
@@ -437,12 +458,14 @@ class CompactionIterator {
   PinnedIteratorsManager pinned_iters_mgr_;
 
   uint64_t blob_garbage_collection_cutoff_file_number_;
+  std::vector<uint64_t> blob_garbage_collection_files_by_ratio_;
 
   std::unique_ptr<BlobFetcher> blob_fetcher_;
   std::unique_ptr<PrefetchBufferCollection> prefetch_buffers_;
 
   std::string blob_index_;
   PinnableSlice blob_value_;
+  std::string entity_value_;
   std::string compaction_filter_value_;
   InternalKey compaction_filter_skip_until_;
   // "level_ptrs" holds indices that remember which file of an associated
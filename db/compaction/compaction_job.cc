@@ -99,6 +99,8 @@ const char* GetCompactionReasonString(CompactionReason compaction_reason) {
       return "ForcedBlobGC";
     case CompactionReason::kRoundRobinTtl:
       return "RoundRobinTtl";
+    case CompactionReason::kDroppableFiles:
+      return "DroppableFiles";
     case CompactionReason::kNumOfReasons:
       // fall through
     default:
@@ -9,18 +9,23 @@
 
 #include "db/compaction/compaction_picker_level.h"
 
+#include <cinttypes>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "db/version_edit.h"
 #include "logging/log_buffer.h"
+#include "logging/logging.h"
 #include "test_util/sync_point.h"
 
 namespace ROCKSDB_NAMESPACE {
 
 bool LevelCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
+  if (!vstorage->DroppableFiles().empty()) {
+    return true;
+  }
   if (!vstorage->ExpiredTtlFiles().empty()) {
     return true;
   }
@@ -829,10 +834,65 @@ bool LevelCompactionBuilder::PickIntraL0Compaction() {
 }
 }  // namespace
 
+Compaction* LevelCompactionPicker::PickDroppableFilesCompaction(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer) {
+  std::vector<CompactionInputFiles> inputs(1);
+  for (const auto& level_and_file : vstorage->DroppableFiles()) {
+    int level = level_and_file.first;
+    FileMetaData* f = level_and_file.second;
+    if (!inputs[0].files.empty() && level != inputs[0].level) {
+      break;
+    }
+    if (f->being_compacted ||
+        (level == 0 && !level0_compactions_in_progress_.empty())) {
+      continue;
+    }
+    // Readers of a snapshot must still find the entries. The verdict may
+    // also have changed since the version was created, e.g. when DBWithTTL's
+    // TTL was raised
+    if (vstorage->IsVisibleToSnapshot(*f) ||
+        !vstorage->IsDroppableFile(ioptions_, level, *f)) {
+      continue;
+    }
+    inputs[0].level = level;
+    inputs[0].files.push_back(f);
+  }
+  if (inputs[0].files.empty()) {
+    return nullptr;
+  }
+  int level = inputs[0].level;
+  for (const FileMetaData* f : inputs[0].files) {
+    ROCKS_LOG_BUFFER(log_buffer,
+                     "[%s] Level compaction: picking droppable file %" PRIu64
+                     " at level %d for deletion",
+                     cf_name.c_str(), f->fd.GetNumber(), level);
+  }
+
+  Compaction* c = new Compaction(
+      vstorage, ioptions_, mutable_cf_options, mutable_db_options,
+      std::move(inputs), level, 0, 0, 0, kNoCompression,
+      mutable_cf_options.compression_opts, Temperature::kUnknown,
+      /* max_subcompactions */ 0, {}, /* is manual */ false,
+      /* trim_ts */ "", vstorage->CompactionScore(0),
+      /* is deletion compaction */ true, /* l0_files_might_overlap */ true,
+      CompactionReason::kDroppableFiles);
+  RegisterCompaction(c);
+  vstorage->ComputeCompactionScore(ioptions_, mutable_cf_options);
+  return c;
+}
+
 Compaction* LevelCompactionPicker::PickCompaction(
     const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
     const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
     LogBuffer* log_buffer, const SequenceNumber earliest_mem_seqno) {
+  // Dropping files is cheap and saves compacting them, so it goes first
+  Compaction* c = PickDroppableFilesCompaction(
+      cf_name, mutable_cf_options, mutable_db_options, vstorage, log_buffer);
+  if (c != nullptr) {
+    return c;
+  }
   LevelCompactionBuilder builder(cf_name, vstorage, earliest_mem_seqno, this,
                                  log_buffer, mutable_cf_options, ioptions_,
                                  mutable_db_options);
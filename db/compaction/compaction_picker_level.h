@@ -27,6 +27,15 @@ class LevelCompactionPicker : public CompactionPicker {
 
   virtual bool NeedsCompaction(
       const VersionStorageInfo* vstorage) const override;
+
+ private:
+  // Picks a deletion-only compaction of the droppable files of one level,
+  // see CompactionFilterFactory::ShouldDropTableFile(). Returns nullptr if
+  // there are none.
+  Compaction* PickDroppableFilesCompaction(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
+      LogBuffer* log_buffer);
 };
 
 }  // namespace ROCKSDB_NAMESPACE
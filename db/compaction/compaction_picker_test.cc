@@ -1005,6 +1005,40 @@ TEST_F(CompactionPickerTest, NeedsCompactionFIFO) {
   }
 }
 
+TEST_F(CompactionPickerTest, FIFOTtlUsesOldestAncesterTime) {
+  NewVersionStorage(1, kCompactionStyleFIFO);
+  const uint64_t kFileSize = 100000;
+  const uint64_t kTtl = 2000;
+
+  fifo_options_.max_table_files_size = kFileSize * 100000;
+  mutable_cf_options_.compaction_options_fifo = fifo_options_;
+  mutable_cf_options_.ttl = kTtl;
+  FIFOCompactionPicker fifo_compaction_picker(ioptions_, &icmp_);
+
+  int64_t current_time = 0;
+  ASSERT_OK(Env::Default()->GetCurrentTime(&current_time));
+  const uint64_t expiry_time = static_cast<uint64_t>(current_time) - kTtl;
+  // No table reader is loaded for these files, so their age is only known
+  // from the oldest ancester time recorded in the manifest.
+  Add(0, 4U, "200", "300", kFileSize, 0, 2500, 2600, 0, false,
+      Temperature::kUnknown, expiry_time + 1000);
+  Add(0, 3U, "200", "300", kFileSize, 0, 2300, 2400, 0, false,
+      Temperature::kUnknown, expiry_time - 1000);
+  Add(0, 2U, "200", "300", kFileSize, 0, 2100, 2200, 0, false,
+      Temperature::kUnknown, expiry_time - 2000);
+  UpdateVersionStorageInfo();
+
+  ASSERT_TRUE(fifo_compaction_picker.NeedsCompaction(vstorage_.get()));
+  std::unique_ptr<Compaction> compaction(fifo_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_, kMaxSequenceNumber));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(CompactionReason::kFIFOTtl, compaction->compaction_reason());
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_EQ(2U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(3U, compaction->input(0, 1)->fd.GetNumber());
+}
+
 TEST_F(CompactionPickerTest, FIFOToWarm1) {
   NewVersionStorage(1, kCompactionStyleFIFO);
   const uint64_t kFileSize = 100000;
@@ -341,6 +341,59 @@ TEST_F(DBBasicTest, CompactedDB) {
             "Not implemented: Not supported operation in read only mode.");
 }
 
+TEST_F(DBBasicTest, CompactedDBPointIndex) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.target_file_size_base = 16 << 10;
+  options.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int i = 0; i < 200; i++) {
+    values.push_back(rnd.RandomString(500));
+    // Odd keys are never written
+    ASSERT_OK(Put(Key(2 * i), values.back()));
+  }
+  ASSERT_OK(Flush());
+  // Rewrite the flushed file into several L1 files
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  ASSERT_GT(NumTableFilesAtLevel(1), 1);
+  Close();
+
+  options.max_open_files = -1;
+  options.max_file_opening_threads = 2;
+  options.compacted_db_point_index = true;
+  options.statistics = CreateDBStatistics();
+  ASSERT_OK(ReadOnlyReopen(options));
+  ASSERT_EQ(Put("new", "value").ToString(),
+            "Not implemented: Not supported in compacted db mode.");
+  for (int i = 0; i < 200; i++) {
+    ASSERT_EQ(values[i], Get(Key(2 * i)));
+    ASSERT_EQ("NOT_FOUND", Get(Key(2 * i + 1)));
+  }
+  ASSERT_EQ("NOT_FOUND", Get("zzz"));
+  // Keys are found without their files' filters
+  ASSERT_EQ(0, TestGetTickerCount(options, BLOOM_FILTER_USEFUL));
+  ASSERT_EQ(0, TestGetTickerCount(options, BLOOM_FILTER_FULL_POSITIVE));
+
+  std::vector<std::string> multiget_values;
+  std::vector<Status> statuses = dbfull()->MultiGet(
+      ReadOptions(), std::vector<Slice>({Key(0), Key(1), Key(398), Key(399)}),
+      &multiget_values);
+  ASSERT_OK(statuses[0]);
+  ASSERT_EQ(values[0], multiget_values[0]);
+  ASSERT_TRUE(statuses[1].IsNotFound());
+  ASSERT_OK(statuses[2]);
+  ASSERT_EQ(values[199], multiget_values[2]);
+  ASSERT_TRUE(statuses[3].IsNotFound());
+  Close();
+}
+
 TEST_F(DBBasicTest, LevelLimitReopen) {
   Options options = CurrentOptions();
   CreateAndReopenWithCF({"pikachu"}, options);
@@ -1090,6 +1143,64 @@ TEST_P(DBBlockChecksumTest, BlockChecksumTest) {
   ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
 }
 
+TEST_F(DBBasicTest, MultiGetPinMemtableValues) {
+  Options options = CurrentOptions();
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  DestroyAndReopen(options);
+  ASSERT_OK(Put("k3", "v3"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put("k1", "v1"));
+  ASSERT_OK(Put("k2", "a"));
+  ASSERT_OK(Merge("k2", "b"));
+
+  std::vector<Slice> keys({"k1", "k2", "k3"});
+  std::vector<PinnableSlice> values(keys.size());
+  std::vector<Status> statuses(keys.size());
+  ReadOptions ro;
+  auto multi_get = [&]() {
+    db_->MultiGet(ro, db_->DefaultColumnFamily(), keys.size(), keys.data(),
+                  values.data(), statuses.data());
+    for (const auto& s : statuses) {
+      ASSERT_OK(s);
+    }
+    ASSERT_EQ("v1", values[0].ToString());
+    ASSERT_EQ("a,b", values[1].ToString());
+    ASSERT_EQ("v3", values[2].ToString());
+  };
+
+  multi_get();
+  ASSERT_FALSE(values[0].IsPinned());
+
+  ro.pin_memtable_values = true;
+  multi_get();
+  ASSERT_TRUE(values[0].IsPinned());
+  // Merge results are still owned by the value
+  ASSERT_FALSE(values[1].IsPinned());
+
+  // The pinned value outlives its memtable being flushed and compacted away
+  ASSERT_OK(Put("k1", "v1new"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ("v1", values[0].ToString());
+  ASSERT_EQ("v1new", Get("k1"));
+  for (auto& value : values) {
+    value.Reset();
+  }
+
+  // Not pinned when values may be updated in place
+  options.inplace_update_support = true;
+  options.allow_concurrent_memtable_write = false;
+  options.merge_operator.reset();
+  DestroyAndReopen(options);
+  ASSERT_OK(Put("k1", "v1"));
+  keys.resize(1);
+  db_->MultiGet(ro, db_->DefaultColumnFamily(), keys.size(), keys.data(),
+                values.data(), statuses.data());
+  ASSERT_OK(statuses[0]);
+  ASSERT_EQ("v1", values[0].ToString());
+  ASSERT_FALSE(values[0].IsPinned());
+}
+
 // On Windows you can have either memory mapped file or a file
 // with unbuffered access. So this asserts and does not make
 // sense to run
@@ -1027,6 +1027,91 @@ TEST_F(DBTestCompactionFilter, DropKeyWithSingleDelete) {
   }
 }
 
+// Drops the table files with the given numbers without reading them
+class DropFilesFactory : public CompactionFilterFactory {
+ public:
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& /*context*/) override {
+    return std::unique_ptr<CompactionFilter>(new KeepFilter());
+  }
+
+  bool SupportsDroppingTableFiles() const override { return true; }
+
+  bool ShouldDropTableFile(const TableProperties& props) const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_numbers_.count(props.orig_file_number) > 0;
+  }
+
+  void DropFile(uint64_t file_number) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_numbers_.insert(file_number);
+  }
+
+  const char* Name() const override { return "DropFilesFactory"; }
+
+ private:
+  mutable std::mutex mutex_;
+  std::set<uint64_t> file_numbers_;
+};
+
+TEST_F(DBTestCompactionFilter, DropFilesKeepsOlderVersionsHidden) {
+  auto factory = std::make_shared<DropFilesFactory>();
+  Options options = CurrentOptions();
+  options.compaction_filter_factory = factory;
+  Reopen(options);
+
+  auto l0_file_numbers = [&]() {
+    std::vector<LiveFileMetaData> files;
+    db_->GetLiveFilesMetaData(&files);
+    std::set<uint64_t> file_numbers;
+    for (const auto& file : files) {
+      if (file.level == 0) {
+        file_numbers.insert(file.file_number);
+      }
+    }
+    return file_numbers;
+  };
+
+  ASSERT_OK(Put("key", "old"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+
+  ASSERT_OK(Put("key", "new"));
+  ASSERT_OK(Flush());
+  std::set<uint64_t> files = l0_file_numbers();
+  ASSERT_EQ(files.size(), 1);
+  const uint64_t newer_file = *files.begin();
+  factory->DropFile(newer_file);
+  ASSERT_OK(Put("other", "value"));
+  ASSERT_OK(Flush());
+  files = l0_file_numbers();
+  ASSERT_EQ(files.size(), 2);
+  for (uint64_t file_number : files) {
+    if (file_number != newer_file) {
+      factory->DropFile(file_number);
+    }
+  }
+
+  // The next version lets the file of "other" be dropped, but not the one
+  // of "key", which would make the older version visible again
+  ASSERT_OK(Put("zzz", "value"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  files = l0_file_numbers();
+  ASSERT_EQ(files.size(), 2);
+  ASSERT_EQ(files.count(newer_file), 1);
+  ASSERT_EQ(Get("key"), "new");
+  ASSERT_EQ(Get("other"), "NOT_FOUND");
+
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  iter->Seek("key");
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(iter->key(), "key");
+  ASSERT_EQ(iter->value(), "new");
+  ASSERT_OK(iter->status());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -6,11 +6,17 @@
 #ifndef ROCKSDB_LITE
 #include "db/db_impl/compacted_db_impl.h"
 
+#include <atomic>
+
 #include "db/db_impl/db_impl.h"
 #include "db/version_set.h"
 #include "logging/logging.h"
+#include "port/port.h"
 #include "table/get_context.h"
+#include "table/internal_iterator.h"
 #include "util/cast_util.h"
+#include "util/fastrange.h"
+#include "util/hash.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -38,6 +44,45 @@ size_t CompactedDBImpl::FindFile(const Slice& key) {
       files_.files);
 }
 
+uint32_t CompactedDBImpl::LookupPointIndex(const Slice& key) const {
+  uint64_t hash = GetSliceNPHash64(key);
+  size_t num_slots = point_index_files_.size();
+  size_t slot = FastRange64(hash, num_slots);
+  while (point_index_files_[slot] != kNotIndexed) {
+    if (point_index_hashes_[slot] == hash) {
+      return point_index_files_[slot];
+    }
+    if (++slot == num_slots) {
+      slot = 0;
+    }
+  }
+  return kNotIndexed;
+}
+
+size_t CompactedDBImpl::FindFileForGet(const Slice& key, const LookupKey& lkey,
+                                       bool* indexed) {
+  *indexed = false;
+  if (!point_index_files_.empty()) {
+    uint32_t file_index = LookupPointIndex(lkey.user_key());
+    if (file_index == kNotIndexed) {
+      return files_.num_files;
+    } else if (file_index != kAmbiguousFile) {
+      *indexed = true;
+      return file_index;
+    }
+  }
+  size_t file_index = FindFile(lkey.user_key());
+  const FdWithKeyRange& f = files_.files[file_index];
+  if (user_comparator_->CompareWithoutTimestamp(
+          key, /*a_has_ts=*/false,
+          ExtractUserKeyAndStripTimestamp(f.smallest_key,
+                                          user_comparator_->timestamp_size()),
+          /*b_has_ts=*/false) < 0) {
+    return files_.num_files;
+  }
+  return file_index;
+}
+
 Status CompactedDBImpl::Get(const ReadOptions& options, ColumnFamilyHandle*,
                             const Slice& key, PinnableSlice* value) {
   return Get(options, /*column_family*/ nullptr, key, value,
@@ -76,16 +121,15 @@ Status CompactedDBImpl::Get(const ReadOptions& options, ColumnFamilyHandle*,
                          /*columns=*/nullptr, ts, nullptr, nullptr, true,
                          nullptr, nullptr, nullptr, nullptr, &read_cb);
 
-  const FdWithKeyRange& f = files_.files[FindFile(lkey.user_key())];
-  if (user_comparator_->CompareWithoutTimestamp(
-          key, /*a_has_ts=*/false,
-          ExtractUserKeyAndStripTimestamp(f.smallest_key,
-                                          user_comparator_->timestamp_size()),
-          /*b_has_ts=*/false) < 0) {
+  bool indexed;
+  size_t file_index = FindFileForGet(key, lkey, &indexed);
+  if (file_index == files_.num_files) {
     return Status::NotFound();
   }
+  const FdWithKeyRange& f = files_.files[file_index];
+  // The filter would only confirm what the point index says
   Status s = f.fd.table_reader->Get(options, lkey.internal_key(), &get_context,
-                                    nullptr);
+                                    nullptr, /*skip_filters=*/indexed);
   if (!s.ok() && !s.IsNotFound()) {
     return s;
   }
@@ -130,19 +174,19 @@ std::vector<Status> CompactedDBImpl::MultiGet(
   }
 
   GetWithTimestampReadCallback read_cb(kMaxSequenceNumber);
-  autovector<TableReader*, 16> reader_list;
+  // The reader of the file that may hold each key, and whether the point
+  // index found it
+  autovector<std::pair<TableReader*, bool>, 16> reader_list;
   for (const auto& key : keys) {
     LookupKey lkey(key, kMaxSequenceNumber, options.timestamp);
-    const FdWithKeyRange& f = files_.files[FindFile(lkey.user_key())];
-    if (user_comparator_->CompareWithoutTimestamp(
-            key, /*a_has_ts=*/false,
-            ExtractUserKeyAndStripTimestamp(f.smallest_key,
-                                            user_comparator_->timestamp_size()),
-            /*b_has_ts=*/false) < 0) {
-      reader_list.push_back(nullptr);
+    bool indexed;
+    size_t file_index = FindFileForGet(key, lkey, &indexed);
+    if (file_index == files_.num_files) {
+      reader_list.emplace_back(nullptr, false);
     } else {
+      const FdWithKeyRange& f = files_.files[file_index];
       f.fd.table_reader->Prepare(lkey.internal_key());
-      reader_list.push_back(f.fd.table_reader);
+      reader_list.emplace_back(f.fd.table_reader, indexed);
     }
   }
   std::vector<Status> statuses(num_keys, Status::NotFound());
@@ -151,7 +195,8 @@ std::vector<Status> CompactedDBImpl::MultiGet(
     timestamps->resize(num_keys);
   }
   int idx = 0;
-  for (auto* r : reader_list) {
+  for (const auto& reader_and_indexed : reader_list) {
+    TableReader* r = reader_and_indexed.first;
     if (r != nullptr) {
       PinnableSlice pinnable_val;
       std::string& value = (*values)[idx];
@@ -162,7 +207,8 @@ std::vector<Status> CompactedDBImpl::MultiGet(
           lkey.user_key(), &pinnable_val, /*columns=*/nullptr,
           user_comparator_->timestamp_size() > 0 ? timestamp : nullptr, nullptr,
           nullptr, true, nullptr, nullptr, nullptr, nullptr, &read_cb);
-      Status s = r->Get(options, lkey.internal_key(), &get_context, nullptr);
+      Status s = r->Get(options, lkey.internal_key(), &get_context, nullptr,
+                        /*skip_filters=*/reader_and_indexed.second);
       assert(static_cast<size_t>(idx) < statuses.size());
       if (!s.ok() && !s.IsNotFound()) {
         statuses[idx] = s;
@@ -228,6 +274,92 @@ Status CompactedDBImpl::Init(const Options& options) {
   return Status::NotSupported("no file exists");
 }
 
+Status CompactedDBImpl::BuildPointIndex() {
+  const size_t num_files = files_.num_files;
+  if (num_files >= kAmbiguousFile) {
+    return Status::NotSupported("Too many files for the point index");
+  }
+  // The hashes of the distinct user keys of each file, collected by up to
+  // max_file_opening_threads threads taking the files in turn
+  std::vector<std::vector<uint64_t>> file_hashes(num_files);
+  std::vector<Status> statuses(num_files);
+  std::atomic<size_t> next_file{0};
+  auto scan_file_func = [&]() {
+    ReadOptions read_options;
+    read_options.fill_cache = false;
+    read_options.total_order_seek = true;
+    while (true) {
+      size_t i = next_file.fetch_add(1);
+      if (i >= num_files) {
+        break;
+      }
+      std::unique_ptr<InternalIterator> iter(
+          files_.files[i].fd.table_reader->NewIterator(
+              read_options, /*prefix_extractor=*/nullptr, /*arena=*/nullptr,
+              /*skip_filters=*/true, TableReaderCaller::kUncategorized));
+      std::string prev_user_key;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+        Slice user_key = ExtractUserKey(iter->key());
+        // Versions of a key are next to each other
+        if (!file_hashes[i].empty() && user_key == prev_user_key) {
+          continue;
+        }
+        file_hashes[i].push_back(GetSliceNPHash64(user_key));
+        prev_user_key.assign(user_key.data(), user_key.size());
+      }
+      statuses[i] = iter->status();
+    }
+  };
+  const size_t max_threads = std::min(
+      num_files,
+      static_cast<size_t>(
+          std::max(immutable_db_options_.max_file_opening_threads, 1)));
+  std::vector<port::Thread> threads;
+  for (size_t i = 1; i < max_threads; i++) {
+    threads.emplace_back(scan_file_func);
+  }
+  scan_file_func();
+  for (auto& t : threads) {
+    t.join();
+  }
+  size_t num_keys = 0;
+  for (size_t i = 0; i < num_files; i++) {
+    if (!statuses[i].ok()) {
+      return statuses[i];
+    }
+    num_keys += file_hashes[i].size();
+  }
+
+  // At most 3/4 of the slots are used, for short probe sequences
+  size_t num_slots = num_keys / 3 * 4 + 4;
+  point_index_hashes_.assign(num_slots, 0);
+  point_index_files_.assign(num_slots, kNotIndexed);
+  for (size_t i = 0; i < num_files; i++) {
+    for (uint64_t hash : file_hashes[i]) {
+      size_t slot = FastRange64(hash, num_slots);
+      while (point_index_files_[slot] != kNotIndexed &&
+             point_index_hashes_[slot] != hash) {
+        if (++slot == num_slots) {
+          slot = 0;
+        }
+      }
+      if (point_index_files_[slot] == kNotIndexed) {
+        point_index_hashes_[slot] = hash;
+        point_index_files_[slot] = static_cast<uint32_t>(i);
+      } else if (point_index_files_[slot] != i) {
+        point_index_files_[slot] = kAmbiguousFile;
+      }
+    }
+    // Release the memory as the index grows
+    std::vector<uint64_t>().swap(file_hashes[i]);
+  }
+  ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                 "Built the point index of %" ROCKSDB_PRIszt
+                 " keys in %" ROCKSDB_PRIszt " files",
+                 num_keys, num_files);
+  return Status::OK();
+}
+
 Status CompactedDBImpl::Open(const Options& options, const std::string& dbname,
                              DB** dbptr) {
   *dbptr = nullptr;
@@ -241,6 +373,10 @@ Status CompactedDBImpl::Open(const Options& options, const std::string& dbname,
   DBOptions db_options(options);
   std::unique_ptr<CompactedDBImpl> db(new CompactedDBImpl(db_options, dbname));
   Status s = db->Init(options);
+  if (s.ok() && options.compacted_db_point_index &&
+      db->user_comparator_->timestamp_size() == 0) {
+    s = db->BuildPointIndex();
+  }
   if (s.ok()) {
     s = db->StartPeriodicTaskScheduler();
   }
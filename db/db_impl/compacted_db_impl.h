@@ -5,6 +5,7 @@
 
 #pragma once
 #ifndef ROCKSDB_LITE
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -145,10 +146,31 @@ class CompactedDBImpl : public DBImpl {
   inline size_t FindFile(const Slice& key);
   Status Init(const Options& options);
 
+  // Fills the point index from the keys of all the files, see
+  // DBOptions::compacted_db_point_index
+  Status BuildPointIndex();
+  // Returns the index in files_ of the file holding a user key with the hash
+  // of `key`, kNotIndexed if none does or kAmbiguousFile if several do
+  uint32_t LookupPointIndex(const Slice& key) const;
+  // Returns the index in files_ of the file that may hold `key`, or
+  // files_.num_files if none may. Sets *indexed if the point index found
+  // the file, which then holds a key with the same hash.
+  size_t FindFileForGet(const Slice& key, const LookupKey& lkey,
+                        bool* indexed);
+
+  // Marks empty slots of the point index
+  static constexpr uint32_t kNotIndexed = std::numeric_limits<uint32_t>::max();
+  // Marks hashes shared by keys of different files
+  static constexpr uint32_t kAmbiguousFile = kNotIndexed - 1;
+
   ColumnFamilyData* cfd_;
   Version* version_;
   const Comparator* user_comparator_;
   LevelFilesBrief files_;
+  // Open addressing hash table with linear probing, from the hash of every
+  // user key to the index of its file in files_. Empty if not enabled.
+  std::vector<uint64_t> point_index_hashes_;
+  std::vector<uint32_t> point_index_files_;
 };
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // ROCKSDB_LITE
@@ -66,6 +66,7 @@
 #include "monitoring/iostats_context_imp.h"
 #include "monitoring/perf_context_imp.h"
 #include "monitoring/persistent_stats_history.h"
+#include "monitoring/statistics.h"
 #include "monitoring/thread_status_updater.h"
 #include "monitoring/thread_status_util.h"
 #include "options/cf_options.h"
@@ -104,6 +105,7 @@
 #include "util/distributed_mutex.h"
 #include "util/hash_containers.h"
 #include "util/mutexlock.h"
+#include "util/random.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
 #include "utilities/trace/replayer_impl.h"
@@ -295,6 +297,10 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
   if (write_buffer_manager_) {
     wbm_stall_.reset(new WBMStallInterface());
   }
+  if (immutable_db_options_.enable_thread_tracking) {
+    user_operations_.reset(
+        new UserOperationRegistry(immutable_db_options_.clock));
+  }
 }
 
 Status DBImpl::Resume() {
@@ -787,6 +793,18 @@ void DBImpl::PrintStatistics() {
   if (dbstats) {
     ROCKS_LOG_INFO(immutable_db_options_.info_log, "STATISTICS:\n %s",
                    dbstats->ToString().c_str());
+    // Cumulative percentiles hardly move once a DB has run for a while, so
+    // also report those of just the samples since the previous dump.
+    auto stats_impl = dbstats->CheckedCast<StatisticsImpl>();
+    if (stats_impl != nullptr) {
+      if (stats_dump_histograms_ == nullptr) {
+        stats_dump_histograms_.reset(new StatisticsHistogramSnapshot());
+      }
+      ROCKS_LOG_INFO(
+          immutable_db_options_.info_log, "STATISTICS (interval):\n %s",
+          stats_impl->HistogramsToIntervalString(stats_dump_histograms_.get())
+              .c_str());
+    }
   }
 }
 
@@ -1460,6 +1478,9 @@ bool DBImpl::WALBufferIsEmpty(bool lock) {
 }
 
 Status DBImpl::SyncWAL() {
+  UserOperation user_op(user_operations_.get(), UserOperation::kSyncWal,
+                        /*cf_name=*/nullptr);
+  user_op.SetStage(UserOperation::kStageSyncWal);
   TEST_SYNC_POINT("DBImpl::SyncWAL:Begin");
   autovector<log::Writer*, 1> logs_to_sync;
   bool need_log_dir_sync;
@@ -1796,6 +1817,62 @@ static void CleanupGetMergeOperandsState(void* arg1, void* /*arg2*/) {
   delete state;
 }
 
+// Times one in `one_in` Get()s stage by stage, by raising the perf level of
+// the calling thread for as long as the object lives, and records the stage
+// timings into the SAMPLED_GET_* histograms on destruction. Unsampled calls
+// only pay for drawing a random number.
+class SampledGetBreakdown {
+ public:
+  SampledGetBreakdown(uint32_t one_in, Statistics* stats) {
+#ifndef NPERF_CONTEXT
+    if (one_in == 0 || stats == nullptr ||
+        GetPerfLevel() >= PerfLevel::kEnableTimeExceptForMutex ||
+        !Random::GetTLSInstance()->OneIn(static_cast<int>(one_in))) {
+      return;
+    }
+    stats_ = stats;
+    prev_perf_level_ = GetPerfLevel();
+    const PerfContext* perf_ctx = get_perf_context();
+    memtable_nanos_ = perf_ctx->get_from_memtable_time;
+    sst_nanos_ = perf_ctx->get_from_output_files_time;
+    block_read_nanos_ = perf_ctx->block_read_time;
+    decompress_nanos_ = perf_ctx->block_decompress_time;
+    SetPerfLevel(PerfLevel::kEnableTimeExceptForMutex);
+#else
+    (void)one_in;
+    (void)stats;
+#endif
+  }
+
+  ~SampledGetBreakdown() {
+    if (stats_ == nullptr) {
+      return;
+    }
+    const PerfContext* perf_ctx = get_perf_context();
+    RecordInHistogram(stats_, SAMPLED_GET_MEMTABLE_NANOS,
+                      perf_ctx->get_from_memtable_time - memtable_nanos_);
+    RecordInHistogram(stats_, SAMPLED_GET_SST_NANOS,
+                      perf_ctx->get_from_output_files_time - sst_nanos_);
+    RecordInHistogram(stats_, SAMPLED_GET_BLOCK_READ_NANOS,
+                      perf_ctx->block_read_time - block_read_nanos_);
+    RecordInHistogram(stats_, SAMPLED_GET_DECOMPRESS_NANOS,
+                      perf_ctx->block_decompress_time - decompress_nanos_);
+    SetPerfLevel(prev_perf_level_);
+  }
+
+  // No copying allowed
+  SampledGetBreakdown(const SampledGetBreakdown&) = delete;
+  void operator=(const SampledGetBreakdown&) = delete;
+
+ private:
+  Statistics* stats_ = nullptr;
+  PerfLevel prev_perf_level_ = PerfLevel::kUninitialized;
+  uint64_t memtable_nanos_ = 0;
+  uint64_t sst_nanos_ = 0;
+  uint64_t block_read_nanos_ = 0;
+  uint64_t decompress_nanos_ = 0;
+};
+
 }  // namespace
 
 InternalIterator* DBImpl::NewInternalIterator(
@@ -1965,6 +2042,9 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
 
   GetWithTimestampReadCallback read_cb(0);  // Will call Refresh
 
+  // Must be constructed before, and so destroyed after, the perf timers below
+  SampledGetBreakdown sampled_breakdown(
+      immutable_db_options_.stats_get_breakdown_one_in, stats_);
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, immutable_db_options_.clock);
   StopWatch sw(immutable_db_options_.clock, stats_, DB_GET);
   PERF_TIMER_GUARD(get_snapshot_time);
@@ -1972,6 +2052,9 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
   auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(
       get_impl_options.column_family);
   auto cfd = cfh->cfd();
+  UserOperation user_op(user_operations_.get(), UserOperation::kGet,
+                        &cfd->GetName());
+  ActiveUserOperationGuard active_user_op(&user_op);
 
   if (tracer_) {
     // TODO: This mutex should be removed later, to improve performance when
@@ -2064,6 +2147,7 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
   std::string* timestamp =
       ucmp->timestamp_size() > 0 ? get_impl_options.timestamp : nullptr;
   if (!skip_memtable) {
+    user_op.SetStage(UserOperation::kStageReadMemTables);
     // Get value associated with key
     if (get_impl_options.get_value) {
       if (sv->mem->Get(
@@ -2125,6 +2209,7 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
   TEST_SYNC_POINT("DBImpl::GetImpl:PostMemTableGet:1");
   PinnedIteratorsManager pinned_iters_mgr;
   if (!done) {
+    user_op.SetStage(UserOperation::kStageReadSstFiles);
     PERF_TIMER_GUARD(get_from_output_files_time);
     sv->current->Get(
         read_options, lkey, get_impl_options.value, get_impl_options.columns,
@@ -2284,6 +2369,13 @@ std::vector<Status> DBImpl::MultiGet(
     }
   }
 
+  UserOperation user_op;
+  if (num_keys > 0) {
+    user_op.Register(user_operations_.get(), UserOperation::kMultiGet,
+                     &column_family[0]->GetName());
+  }
+  ActiveUserOperationGuard active_user_op(&user_op);
+
   SequenceNumber consistent_seqnum;
 
   UnorderedMap<uint32_t, MultiGetColumnFamilyData> multiget_cf_data(
@@ -2358,6 +2450,7 @@ std::vector<Status> DBImpl::MultiGet(
          has_unpersisted_data_.load(std::memory_order_relaxed));
     bool done = false;
     if (!skip_memtable) {
+      user_op.SetStage(UserOperation::kStageReadMemTables);
       if (super_version->mem->Get(
               lkey, value, /*columns=*/nullptr, timestamp, &s, &merge_context,
               &max_covering_tombstone_seq, read_options,
@@ -2373,6 +2466,7 @@ std::vector<Status> DBImpl::MultiGet(
       }
     }
     if (!done) {
+      user_op.SetStage(UserOperation::kStageReadSstFiles);
       PinnableSlice pinnable_val;
       PERF_TIMER_GUARD(get_from_output_files_time);
       PinnedIteratorsManager pinned_iters_mgr;
@@ -2850,6 +2944,9 @@ Status DBImpl::MultiGetImpl(
     ReadCallback* callback) {
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, immutable_db_options_.clock);
   StopWatch sw(immutable_db_options_.clock, stats_, DB_MULTIGET);
+  UserOperation user_op(user_operations_.get(), UserOperation::kMultiGet,
+                        &super_version->cfd->GetName());
+  ActiveUserOperationGuard active_user_op(&user_op);
 
   assert(sorted_keys);
   // Clear the timestamps for returning results so that we can distinguish
@@ -2868,6 +2965,21 @@ Status DBImpl::MultiGetImpl(
   size_t keys_left = num_keys;
   Status s;
   uint64_t curr_value_size = 0;
+  // With pin_memtable_values, values pinned in the memtables share one
+  // reference to the super version, released along with the last of them.
+  SharedCleanablePtr memtable_value_pinner;
+  if (read_options.pin_memtable_values) {
+    super_version->Ref();
+    memtable_value_pinner.Allocate();
+    memtable_value_pinner->RegisterCleanup(
+        CleanupSuperVersionHandle,
+        new SuperVersionHandle(
+            this, &mutex_, super_version,
+            immutable_db_options_.avoid_unnecessary_blocking_io),
+        nullptr /* arg2 */);
+  }
+  SharedCleanablePtr* value_pinner =
+      read_options.pin_memtable_values ? &memtable_value_pinner : nullptr;
   while (keys_left) {
     if (read_options.deadline.count() &&
         immutable_db_options_.clock->NowMicros() >
@@ -2897,10 +3009,13 @@ Status DBImpl::MultiGetImpl(
         (read_options.read_tier == kPersistedTier &&
          has_unpersisted_data_.load(std::memory_order_relaxed));
     if (!skip_memtable) {
+      user_op.SetStage(UserOperation::kStageReadMemTables);
       super_version->mem->MultiGet(read_options, &range, callback,
-                                   false /* immutable_memtable */);
+                                   false /* immutable_memtable */,
+                                   value_pinner);
       if (!range.empty()) {
-        super_version->imm->MultiGet(read_options, &range, callback);
+        super_version->imm->MultiGet(read_options, &range, callback,
+                                     value_pinner);
       }
       if (!range.empty()) {
         lookup_current = true;
@@ -2909,6 +3024,7 @@ Status DBImpl::MultiGetImpl(
       }
     }
     if (lookup_current) {
+      user_op.SetStage(UserOperation::kStageReadSstFiles);
       PERF_TIMER_GUARD(get_from_output_files_time);
       super_version->current->MultiGet(read_options, &range, callback);
     }
@@ -3369,6 +3485,7 @@ ArenaWrappedDBIter* DBImpl::NewIteratorImpl(const ReadOptions& read_options,
       snapshot, sv->mutable_cf_options.max_sequential_skip_in_iterations,
       sv->version_number, read_callback, this, cfd, expose_blob_index,
       read_options.snapshot != nullptr ? false : allow_refresh);
+  db_iter->RegisterUserOperation(user_operations_.get(), cfd->GetName());
 
   InternalIterator* internal_iter = NewInternalIterator(
       db_iter->GetReadOptions(), cfd, sv, db_iter->GetArena(), snapshot,
@@ -3908,6 +4025,16 @@ bool DBImpl::GetPropertyHandleOptionsStatistics(std::string* value) {
   return true;
 }
 
+bool DBImpl::GetPropertyHandleLiveUserOperations(std::string* value) {
+  assert(value != nullptr);
+  if (!user_operations_) {
+    return false;
+  }
+  value->clear();
+  user_operations_->ToString(value);
+  return true;
+}
+
 #ifndef ROCKSDB_LITE
 Status DBImpl::ResetStats() {
   InstrumentedMutexLock l(&mutex_);
@@ -5152,6 +5279,12 @@ Status DBImpl::IngestExternalFiles(
     }
   }
 
+  UserOperation user_op(user_operations_.get(),
+                        UserOperation::kIngestExternalFile,
+                        &args[0].column_family->GetName());
+  ActiveUserOperationGuard active_user_op(&user_op);
+  user_op.SetStage(UserOperation::kStagePrepareFiles);
+
   // TODO (yanqin) maybe handle the case in which column_families have
   // duplicates
   std::unique_ptr<std::list<uint64_t>::iterator> pending_output_elem;
@@ -5222,6 +5355,7 @@ Status DBImpl::IngestExternalFiles(
   for (size_t i = 0; i != num_cfs; ++i) {
     sv_ctxs.emplace_back(true /* create_superversion */);
   }
+  user_op.SetStage(UserOperation::kStageIngestFiles);
   TEST_SYNC_POINT("DBImpl::IngestExternalFiles:BeforeJobsRun:0");
   TEST_SYNC_POINT("DBImpl::IngestExternalFiles:BeforeJobsRun:1");
   TEST_SYNC_POINT("DBImpl::AddFile:Start");
@@ -47,6 +47,7 @@
 #include "db/write_thread.h"
 #include "logging/event_logger.h"
 #include "monitoring/instrumented_mutex.h"
+#include "monitoring/user_operation_registry.h"
 #include "options/db_options.h"
 #include "port/port.h"
 #include "rocksdb/db.h"
@@ -85,6 +86,7 @@ class WriteCallback;
 struct JobContext;
 struct ExternalSstFileInfo;
 struct MemTableInfo;
+struct StatisticsHistogramSnapshot;
 
 // Class to maintain directories for all database paths other than main one.
 class Directories {
@@ -2158,6 +2160,7 @@ class DBImpl : public DB {
                               const DBPropertyInfo& property_info,
                               bool is_locked, uint64_t* value);
   bool GetPropertyHandleOptionsStatistics(std::string* value);
+  bool GetPropertyHandleLiveUserOperations(std::string* value);
 
   bool HasPendingManualCompaction();
   bool HasExclusiveManualCompaction();
@@ -2628,6 +2631,14 @@ class DBImpl : public DB {
   std::map<PeriodicTaskType, const PeriodicTaskFunc> periodic_task_functions_;
 #endif
 
+  // Histograms as of the previous PrintStatistics(), to report the
+  // percentiles of each stats dump period. Only accessed by DumpStats().
+  std::unique_ptr<StatisticsHistogramSnapshot> stats_dump_histograms_;
+
+  // User operations in flight, for the kLiveUserOperations property. Only set
+  // when `enable_thread_tracking` is true.
+  std::unique_ptr<UserOperationRegistry> user_operations_;
+
   // When set, we use a separate queue for writes that don't write to memtable.
   // In 2PC these are the writes at Prepare phase.
   const bool two_write_queues_;
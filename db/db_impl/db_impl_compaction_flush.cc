@@ -3225,6 +3225,9 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
       // compaction is not necessary. Need to make sure mutex is held
       // until we make a copy in the following code
       TEST_SYNC_POINT("DBImpl::BackgroundCompaction():BeforePickCompaction");
+      cfd->current()->storage_info()->SetNewestSnapshot(
+          snapshots_.empty() ? kMaxSequenceNumber
+                             : snapshots_.GetNewest());
       c.reset(cfd->PickCompaction(*mutable_cf_options, mutable_db_options_,
                                   log_buffer));
       TEST_SYNC_POINT("DBImpl::BackgroundCompaction():AfterPickCompaction");
@@ -3290,7 +3293,8 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
                              c->column_family_data());
     assert(c->num_input_files(1) == 0);
     assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+               kCompactionStyleFIFO ||
+           c->compaction_reason() == CompactionReason::kDroppableFiles);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
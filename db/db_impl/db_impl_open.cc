@@ -55,6 +55,13 @@ DBOptions SanitizeOptions(const std::string& dbname, const DBOptions& src,
                              &result.max_open_files);
   }
 
+  // Get() sampling draws from a 31-bit random number generator
+  const uint32_t max_get_breakdown_one_in =
+      static_cast<uint32_t>(std::numeric_limits<int32_t>::max());
+  if (result.stats_get_breakdown_one_in > max_get_breakdown_one_in) {
+    result.stats_get_breakdown_one_in = max_get_breakdown_one_in;
+  }
+
   if (result.info_log == nullptr && !read_only) {
     Status s = CreateLoggerFromOptions(dbname, result, &result.info_log);
     if (!s.ok()) {
@@ -12,8 +12,10 @@
 #include "logging/auto_roll_logger.h"
 #include "logging/logging.h"
 #include "monitoring/perf_context_imp.h"
+#include "monitoring/statistics.h"
 #include "rocksdb/configurable.h"
 #include "util/cast_util.h"
+#include "util/stop_watch.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -285,6 +287,8 @@ Status DBImplSecondary::RecoverLogFiles(
       // passing null flush_scheduler will disable memtable flushing which is
       // needed for secondary instances
       if (status.ok()) {
+        RecordTick(stats_, SECONDARY_WAL_RECORDS_APPLIED);
+        RecordTick(stats_, SECONDARY_WAL_BYTES_APPLIED, record.size());
         for (const auto id : column_family_ids) {
           ColumnFamilyData* cfd =
               versions_->GetColumnFamilySet()->GetColumnFamily(id);
@@ -600,6 +604,7 @@ Status DBImplSecondary::CheckConsistency() {
 Status DBImplSecondary::TryCatchUpWithPrimary() {
   assert(versions_.get() != nullptr);
   assert(manifest_reader_.get() != nullptr);
+  StopWatch sw(immutable_db_options_.clock, stats_, SECONDARY_CATCH_UP_MICROS);
   Status s;
   // read the manifest and apply new changes to the secondary instance
   std::unordered_set<ColumnFamilyData*> cfds_changed;
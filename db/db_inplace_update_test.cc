@@ -8,6 +8,7 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "db/db_test_util.h"
 #include "port/stack_trace.h"
+#include "utilities/merge_operators.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -253,6 +254,104 @@ TEST_F(DBTestInPlaceUpdate, InPlaceUpdateAndSnapshot) {
   } while (ChangeCompactOptions());
 }
 
+TEST_F(DBTestInPlaceUpdate, InPlaceMerge) {
+  do {
+    Options options = CurrentOptions();
+    options.create_if_missing = true;
+    options.inplace_update_support = true;
+    options.inplace_merge_support = true;
+    options.merge_operator = MergeOperators::CreateUInt64AddOperator();
+    options.env = env_;
+    options.write_buffer_size = 100000;
+    options.allow_concurrent_memtable_write = false;
+    Reopen(options);
+    CreateAndReopenWithCF({"pikachu"}, options);
+
+    auto encode = [](uint64_t v) {
+      std::string encoded;
+      PutFixed64(&encoded, v);
+      return encoded;
+    };
+
+    // Operands on a key without a base value are combined into one operand
+    for (uint64_t i = 1; i <= 10; i++) {
+      ASSERT_OK(Merge(1, "counter", encode(i)));
+      ASSERT_EQ(encode(i * (i + 1) / 2), Get(1, "counter"));
+    }
+    validateNumberOfEntries(1, 1);
+
+    // Operands on a key with a base value are merged into the value
+    DestroyAndReopen(options);
+    CreateAndReopenWithCF({"pikachu"}, options);
+    ASSERT_OK(Put(1, "counter", encode(100)));
+    for (uint64_t i = 1; i <= 10; i++) {
+      ASSERT_OK(Merge(1, "counter", encode(1)));
+    }
+    ASSERT_EQ(encode(110), Get(1, "counter"));
+    validateNumberOfEntries(1, 1);
+
+    ASSERT_OK(Flush(1));
+    ASSERT_EQ(encode(110), Get(1, "counter"));
+  } while (ChangeCompactOptions());
+}
+
+TEST_F(DBTestInPlaceUpdate, InPlaceMergeLargerResult) {
+  do {
+    Options options = CurrentOptions();
+    options.create_if_missing = true;
+    options.inplace_update_support = true;
+    options.inplace_merge_support = true;
+    options.merge_operator = MergeOperators::CreateStringAppendOperator();
+    options.env = env_;
+    options.write_buffer_size = 100000;
+    options.allow_concurrent_memtable_write = false;
+    Reopen(options);
+    CreateAndReopenWithCF({"pikachu"}, options);
+
+    // Merge results growing larger than the entry are added as usual
+    ASSERT_OK(Put(1, "key", "a"));
+    ASSERT_OK(Merge(1, "key", "b"));
+    ASSERT_OK(Merge(1, "key", "c"));
+    ASSERT_EQ("a,b,c", Get(1, "key"));
+    validateNumberOfEntries(3, 1);
+  } while (ChangeCompactOptions());
+}
+
+TEST_F(DBTestInPlaceUpdate, InPlaceMergeAfterRangeDeletion) {
+  do {
+    Options options = CurrentOptions();
+    options.create_if_missing = true;
+    options.inplace_update_support = true;
+    options.inplace_merge_support = true;
+    options.merge_operator = MergeOperators::CreateUInt64AddOperator();
+    options.env = env_;
+    options.write_buffer_size = 100000;
+    options.allow_concurrent_memtable_write = false;
+    Reopen(options);
+    CreateAndReopenWithCF({"pikachu"}, options);
+
+    auto encode = [](uint64_t v) {
+      std::string encoded;
+      PutFixed64(&encoded, v);
+      return encoded;
+    };
+
+    // An operand is not folded into a value deleted by a newer range
+    // tombstone, where it would be hidden along with the value
+    ASSERT_OK(Put(1, "counter", encode(100)));
+    ASSERT_OK(db_->DeleteRange(WriteOptions(), handles_[1], "a", "z"));
+    ASSERT_OK(Merge(1, "counter", encode(1)));
+    ASSERT_EQ(encode(1), Get(1, "counter"));
+
+    // Later operands are folded into the new one as usual
+    ASSERT_OK(Merge(1, "counter", encode(2)));
+    ASSERT_EQ(encode(3), Get(1, "counter"));
+
+    ASSERT_OK(Flush(1));
+    ASSERT_EQ(encode(3), Get(1, "counter"));
+  } while (ChangeCompactOptions());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
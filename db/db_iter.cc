@@ -13,6 +13,7 @@
 #include <limits>
 #include <string>
 
+#include "db/blob/blob_fetcher.h"
 #include "db/dbformat.h"
 #include "db/merge_context.h"
 #include "db/merge_helper.h"
@@ -193,17 +194,10 @@ bool DBIter::SetBlobValueIfNeeded(const Slice& user_key,
     return false;
   }
 
-  // TODO: consider moving ReadOptions from ArenaWrappedDBIter to DBIter to
-  // avoid having to copy options back and forth.
-  ReadOptions read_options;
-  read_options.read_tier = read_tier_;
-  read_options.fill_cache = fill_cache_;
-  read_options.verify_checksums = verify_checksums_;
-
   constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
   constexpr uint64_t* bytes_read = nullptr;
 
-  const Status s = version_->GetBlob(read_options, user_key, blob_index,
+  const Status s = version_->GetBlob(GetBlobReadOptions(), user_key, blob_index,
                                      prefetch_buffer, &blob_value_, bytes_read);
 
   if (!s.ok()) {
@@ -216,16 +210,56 @@ bool DBIter::SetBlobValueIfNeeded(const Slice& user_key,
   return true;
 }
 
-bool DBIter::SetValueAndColumnsFromEntity(Slice slice) {
+ReadOptions DBIter::GetBlobReadOptions() const {
+  // TODO: consider moving ReadOptions from ArenaWrappedDBIter to DBIter to
+  // avoid having to copy options back and forth.
+  ReadOptions read_options;
+  read_options.read_tier = read_tier_;
+  read_options.fill_cache = fill_cache_;
+  read_options.verify_checksums = verify_checksums_;
+
+  return read_options;
+}
+
+bool DBIter::SetValueAndColumnsFromEntity(const Slice& user_key,
+                                          Slice slice) {
   assert(value_.empty());
   assert(wide_columns_.empty());
 
-  const Status s = WideColumnSerialization::Deserialize(slice, wide_columns_);
+  if (!WideColumnSerialization::HasBlobIndices(slice)) {
+    const Status s = WideColumnSerialization::Deserialize(slice, wide_columns_);
 
-  if (!s.ok()) {
-    status_ = s;
-    valid_ = false;
-    return false;
+    if (!s.ok()) {
+      status_ = s;
+      valid_ = false;
+      return false;
+    }
+  } else {
+    if (!version_) {
+      status_ = Status::Corruption("Encountered unexpected blob index.");
+      valid_ = false;
+      return false;
+    }
+
+    const Status s = WideColumnSerialization::DeserializeWithBlobIndices(
+        slice, wide_columns_, column_value_types_);
+
+    if (!s.ok()) {
+      status_ = s;
+      valid_ = false;
+      return false;
+    }
+
+    // Like Get(), only fetch the value of the default column right away. The
+    // other column values are fetched by the first call to columns().
+    column_blob_values_.resize(wide_columns_.size());
+    entity_user_key_.assign(user_key.data(), user_key.size());
+    has_unfetched_column_blobs_ = true;
+    if (!wide_columns_.empty() &&
+        wide_columns_[0].name() == kDefaultWideColumnName &&
+        !FetchColumnBlob(0)) {
+      return false;
+    }
   }
 
   if (!wide_columns_.empty() &&
@@ -236,6 +270,42 @@ bool DBIter::SetValueAndColumnsFromEntity(Slice slice) {
   return true;
 }
 
+bool DBIter::FetchColumnBlob(size_t index) const {
+  assert(index < wide_columns_.size());
+
+  if (column_value_types_[index] != WideColumnSerialization::kColumnBlobIndex) {
+    return true;
+  }
+
+  const BlobFetcher blob_fetcher(version_, GetBlobReadOptions());
+  constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
+  constexpr uint64_t* bytes_read = nullptr;
+
+  const Status s = blob_fetcher.FetchBlob(
+      entity_user_key_, wide_columns_[index].value(), prefetch_buffer,
+      &column_blob_values_[index], bytes_read);
+  if (!s.ok()) {
+    status_ = s;
+    valid_ = false;
+    wide_columns_.clear();
+    has_unfetched_column_blobs_ = false;
+    return false;
+  }
+
+  wide_columns_[index].value() = column_blob_values_[index];
+  column_value_types_[index] = WideColumnSerialization::kColumnValue;
+  return true;
+}
+
+void DBIter::FetchColumnBlobs() const {
+  for (size_t i = 0; i < wide_columns_.size(); ++i) {
+    if (!FetchColumnBlob(i)) {
+      return;
+    }
+  }
+  has_unfetched_column_blobs_ = false;
+}
+
 // PRE: saved_key_ has the current user key if skipping_saved_key
 // POST: saved_key_ should have the next user key if valid_,
 //       if the current entry is a result of merge
@@ -385,7 +455,8 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
               SetValueAndColumnsFromPlain(expose_blob_index_ ? iter_.value()
                                                              : blob_value_);
             } else if (ikey_.type == kTypeWideColumnEntity) {
-              if (!SetValueAndColumnsFromEntity(iter_.value())) {
+              if (!SetValueAndColumnsFromEntity(ikey_.user_key,
+                                                iter_.value())) {
                 return false;
               }
             } else {
@@ -1021,7 +1092,8 @@ bool DBIter::FindValueForCurrentKey() {
 
       break;
     case kTypeWideColumnEntity:
-      if (!SetValueAndColumnsFromEntity(pinned_value_)) {
+      if (!SetValueAndColumnsFromEntity(saved_key_.GetUserKey(),
+                                        pinned_value_)) {
         return false;
       }
       break;
@@ -1130,7 +1202,7 @@ bool DBIter::FindValueForCurrentKeyUsingSeek() {
       SetValueAndColumnsFromPlain(expose_blob_index_ ? pinned_value_
                                                      : blob_value_);
     } else if (ikey.type == kTypeWideColumnEntity) {
-      if (!SetValueAndColumnsFromEntity(pinned_value_)) {
+      if (!SetValueAndColumnsFromEntity(ikey.user_key, pinned_value_)) {
         return false;
       }
     } else {
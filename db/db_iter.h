@@ -10,9 +10,11 @@
 #pragma once
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "db/db_impl/db_impl.h"
 #include "db/range_del_aggregator.h"
+#include "db/wide/wide_column_serialization.h"
 #include "memory/arena.h"
 #include "options/cf_options.h"
 #include "rocksdb/db.h"
@@ -167,6 +169,9 @@ class DBIter final : public Iterator {
   const WideColumns& columns() const override {
     assert(valid_);
 
+    if (has_unfetched_column_blobs_) {
+      FetchColumnBlobs();
+    }
     return wide_columns_;
   }
 
@@ -297,6 +302,8 @@ class DBIter final : public Iterator {
   // index when using the integrated BlobDB implementation.
   bool SetBlobValueIfNeeded(const Slice& user_key, const Slice& blob_index);
 
+  ReadOptions GetBlobReadOptions() const;
+
   void ResetBlobValue() {
     is_blob_ = false;
     blob_value_.Reset();
@@ -310,11 +317,25 @@ class DBIter final : public Iterator {
     wide_columns_.emplace_back(kDefaultWideColumnName, slice);
   }
 
-  bool SetValueAndColumnsFromEntity(Slice slice);
+  // Column values of the entity stored in blob files are fetched using the
+  // given user key when using the integrated BlobDB implementation: that of
+  // the default column right away, the others by FetchColumnBlobs().
+  bool SetValueAndColumnsFromEntity(const Slice& user_key, Slice slice);
+
+  // Replaces the blob index of column `index` of the current entity, if it
+  // has one, by the value fetched from the blob file. On error, sets status_
+  // and invalidates the iterator.
+  bool FetchColumnBlob(size_t index) const;
+  void FetchColumnBlobs() const;
 
   void ResetValueAndColumns() {
     value_.clear();
     wide_columns_.clear();
+    if (has_unfetched_column_blobs_ || !column_blob_values_.empty()) {
+      has_unfetched_column_blobs_ = false;
+      column_value_types_.clear();
+      column_blob_values_.clear();
+    }
   }
 
   // If user-defined timestamp is enabled, `user_key` includes timestamp.
@@ -344,8 +365,15 @@ class DBIter final : public Iterator {
   PinnableSlice blob_value_;
   // Value of the default column
   Slice value_;
-  // All columns (i.e. name-value pairs)
-  WideColumns wide_columns_;
+  // All columns (i.e. name-value pairs). The values of the current entity's
+  // columns stored in blob files are fetched lazily, see
+  // SetValueAndColumnsFromEntity().
+  mutable WideColumns wide_columns_;
+  mutable std::vector<WideColumnSerialization::ColumnValueType>
+      column_value_types_;
+  mutable std::vector<PinnableSlice> column_blob_values_;
+  std::string entity_user_key_;
+  mutable bool has_unfetched_column_blobs_ = false;
   Statistics* statistics_;
   uint64_t max_skip_;
   uint64_t max_skippable_internal_keys_;
@@ -360,9 +388,9 @@ class DBIter final : public Iterator {
   // SetUserKey() and use it using GetUserKey().
   IterKey prefix_;
 
-  Status status_;
+  mutable Status status_;
   Direction direction_;
-  bool valid_;
+  mutable bool valid_;
   bool current_entry_is_merged_;
   // True if we know that the current entry's seqnum is 0.
   // This information is used as that the next entry will be for another
@@ -2080,6 +2080,154 @@ TEST_F(DBPropertiesTest, GetMapPropertyDbStats) {
   Close();
 }
 
+TEST_F(DBPropertiesTest, LiveUserOperations) {
+  Options options = CurrentOptions();
+  std::string value;
+  Reopen(options);
+  // Not tracked by default
+  ASSERT_FALSE(db_->GetProperty(DB::Properties::kLiveUserOperations, &value));
+
+  options.enable_thread_tracking = true;
+  BlockBasedTableOptions table_options;
+  table_options.no_block_cache = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kLiveUserOperations, &value));
+  ASSERT_EQ("", value);
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    iter->SeekToFirst();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_TRUE(db_->GetProperty(DB::Properties::kLiveUserOperations, &value));
+    ASSERT_EQ(0, value.find("Iterator cf=default elapsed_micros="));
+    ASSERT_EQ(std::string::npos, value.find("blocks_read=0"));
+    ASSERT_EQ(1, std::count(value.begin(), value.end(), '\n'));
+
+    // Reported while in flight, along with the still live iterator
+    std::string get_ops;
+    SyncPoint::GetInstance()->SetCallBack(
+        "DBImpl::GetImpl:PostMemTableGet:0", [&](void*) {
+          ASSERT_TRUE(
+              db_->GetProperty(DB::Properties::kLiveUserOperations, &get_ops));
+        });
+    SyncPoint::GetInstance()->EnableProcessing();
+    ASSERT_EQ("v1", Get("foo"));
+    SyncPoint::GetInstance()->DisableProcessing();
+    SyncPoint::GetInstance()->ClearAllCallBacks();
+    ASSERT_EQ(0, get_ops.find("Iterator cf=default"));
+    ASSERT_NE(std::string::npos,
+              get_ops.find("\nGet cf=default elapsed_micros="));
+    ASSERT_NE(std::string::npos, get_ops.find("stage=ReadMemTables"));
+  }
+
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kLiveUserOperations, &value));
+  ASSERT_EQ("", value);
+}
+
+TEST_F(DBPropertiesTest, CompactionForecast) {
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleLevel;
+  options.disable_auto_compactions = true;
+  options.level0_file_num_compaction_trigger = 2;
+  options.write_buffer_size = 64 << 10;
+  options.max_bytes_for_level_base = 256 << 10;
+  options.soft_pending_compaction_bytes_limit = 1;
+  options.hard_pending_compaction_bytes_limit = 0;
+  Reopen(options);
+
+  std::map<std::string, std::string> values;
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kCompactionForecast, &values));
+  ASSERT_EQ("0", values["pending_compaction_bytes"]);
+  ASSERT_EQ(1.0, std::stod(values["estimated_write_amp"]));
+  ASSERT_EQ(-1.0, std::stod(values["pending_compaction_seconds"]));
+
+  Random rnd(301);
+  auto write_files = [&](int num_files) {
+    for (int i = 0; i < num_files; i++) {
+      for (int j = 0; j < 10; j++) {
+        ASSERT_OK(Put(Key(i * 10 + j), rnd.RandomString(1000)));
+      }
+      ASSERT_OK(Flush());
+    }
+  };
+  write_files(4);
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kCompactionForecast, &values));
+  ASSERT_GT(std::stoull(values["pending_compaction_bytes"]), 0);
+  ASSERT_GT(std::stod(values["ingest_bytes_per_sec"]), 0);
+  ASSERT_GE(std::stod(values["measured_write_amp"]), 1.0);
+  // No compaction has been timed yet, and the pending bytes are already past
+  // the soft limit while the hard limit is disabled
+  ASSERT_EQ(-1.0, std::stod(values["pending_compaction_seconds"]));
+  ASSERT_EQ(0.0, std::stod(values["seconds_to_slowdown"]));
+  ASSERT_EQ(-1.0, std::stod(values["seconds_to_stop"]));
+
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  ASSERT_EQ("0,1", FilesPerLevel());
+  write_files(4);
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kCompactionForecast, &values));
+  ASSERT_GT(std::stod(values["compaction_bytes_per_sec"]), 0);
+  // One compaction at a time, for part of the time
+  ASSERT_GT(std::stod(values["compaction_concurrency"]), 0);
+  ASSERT_LE(std::stod(values["compaction_concurrency"]), 1.0);
+  ASSERT_GT(std::stod(values["pending_compaction_seconds"]), 0);
+  // Moving L0 into L1 rewrites L1
+  ASSERT_GT(std::stod(values["estimated_write_amp"]), 2.0);
+
+  std::string value;
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kCompactionForecast, &value));
+  ASSERT_NE(std::string::npos, value.find("Compaction Forecast [default]"));
+}
+
+TEST_F(DBPropertiesTest, CompactionForecastWindowMovesWithoutQueries) {
+  auto mock_clock = std::make_shared<MockSystemClock>(env_->GetSystemClock());
+  CompositeEnvWrapper env(env_, mock_clock);
+
+  Options options = CurrentOptions();
+  options.env = &env;
+  options.disable_auto_compactions = true;
+  Reopen(options);
+
+  Random rnd(301);
+  auto write_file = [&]() {
+    for (int j = 0; j < 10; j++) {
+      ASSERT_OK(Put(Key(j), rnd.RandomString(1000)));
+    }
+    ASSERT_OK(Flush());
+  };
+  for (int i = 0; i < 4; i++) {
+    write_file();
+  }
+  // The flushes advance the window although the forecast is never queried,
+  // so the rates only cover the last two flushes
+  mock_clock->MockSleepForSeconds(600);
+  write_file();
+  mock_clock->MockSleepForSeconds(90);
+  write_file();
+
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(6, files.size());
+  std::sort(files.begin(), files.end(),
+            [](const LiveFileMetaData& a, const LiveFileMetaData& b) {
+              return a.file_number > b.file_number;
+            });
+  std::map<std::string, std::string> values;
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kCompactionForecast, &values));
+  ASSERT_NEAR(static_cast<double>(files[0].size + files[1].size) / 90,
+              std::stod(values["ingest_bytes_per_sec"]), 1.0);
+  Close();
+}
+
 TEST_F(DBPropertiesTest, GetMapPropertyBlockCacheEntryStats) {
   // Currently only verifies the expected properties are present
   std::map<std::string, std::string> values;
@@ -600,6 +600,45 @@ TEST_F(DBSecondaryTest, OpenAsSecondaryWALTailing) {
   verify_db_func("new_foo_value_1", "new_bar_value");
 }
 
+TEST_F(DBSecondaryTest, CatchUpStatistics) {
+  Options options;
+  options.env = env_;
+  Reopen(options);
+  ASSERT_OK(Put("foo", "foo_value"));
+
+  Options options1;
+  options1.env = env_;
+  options1.max_open_files = -1;
+  options1.statistics = CreateDBStatistics();
+  OpenSecondary(options1);
+  // Records replayed while opening count as well
+  ASSERT_EQ(1, options1.statistics->getTickerCount(
+                   SECONDARY_WAL_RECORDS_APPLIED));
+  ASSERT_OK(options1.statistics->Reset());
+
+  ASSERT_OK(db_secondary_->TryCatchUpWithPrimary());
+  ASSERT_EQ(0, options1.statistics->getTickerCount(
+                   SECONDARY_WAL_RECORDS_APPLIED));
+  ASSERT_EQ(0,
+            options1.statistics->getTickerCount(SECONDARY_WAL_BYTES_APPLIED));
+
+  ASSERT_OK(Put("foo", "new_foo_value"));
+  ASSERT_OK(Put("bar", "new_bar_value"));
+  ASSERT_OK(db_secondary_->TryCatchUpWithPrimary());
+  ASSERT_EQ(2, options1.statistics->getTickerCount(
+                   SECONDARY_WAL_RECORDS_APPLIED));
+  ASSERT_GT(options1.statistics->getTickerCount(SECONDARY_WAL_BYTES_APPLIED),
+            0);
+
+  HistogramData catch_up;
+  options1.statistics->histogramData(SECONDARY_CATCH_UP_MICROS, &catch_up);
+  ASSERT_EQ(2, catch_up.count);
+
+  std::string value;
+  ASSERT_OK(db_secondary_->Get(ReadOptions(), "bar", &value));
+  ASSERT_EQ("new_bar_value", value);
+}
+
 TEST_F(DBSecondaryTest, SecondaryTailingBug_ISSUE_8467) {
   Options options;
   options.env = env_;
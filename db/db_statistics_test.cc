@@ -3,6 +3,7 @@
 //  COPYING file in the root directory) and Apache 2.0 License
 //  (found in the LICENSE.Apache file in the root directory).
 
+#include <limits>
 #include <string>
 
 #include "db/db_test_util.h"
@@ -157,6 +158,68 @@ TEST_F(DBStatisticsTest, ExcludeTickers) {
   ASSERT_GT(options.statistics->getTickerCount(BYTES_READ), 0);
 }
 
+TEST_F(DBStatisticsTest, SampledGetBreakdown) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.statistics = CreateDBStatistics();
+  options.stats_get_breakdown_one_in = 1;
+  BlockBasedTableOptions table_options;
+  table_options.no_block_cache = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  SetPerfLevel(kDisable);
+  get_perf_context()->Reset();
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put("bar", "v2"));
+  ASSERT_EQ("v1", Get("foo"));
+  ASSERT_EQ("v2", Get("bar"));
+
+  HistogramData memtable;
+  options.statistics->histogramData(SAMPLED_GET_MEMTABLE_NANOS, &memtable);
+  ASSERT_EQ(2, memtable.count);
+  HistogramData sst;
+  options.statistics->histogramData(SAMPLED_GET_SST_NANOS, &sst);
+  ASSERT_EQ(2, sst.count);
+  HistogramData block_read;
+  options.statistics->histogramData(SAMPLED_GET_BLOCK_READ_NANOS,
+                                    &block_read);
+  ASSERT_EQ(2, block_read.count);
+  ASSERT_GT(block_read.max, 0);
+  HistogramData decompress;
+  options.statistics->histogramData(SAMPLED_GET_DECOMPRESS_NANOS,
+                                    &decompress);
+  ASSERT_EQ(2, decompress.count);
+
+  // The thread's perf level is restored after every sampled call
+  ASSERT_EQ(kDisable, GetPerfLevel());
+
+  // Calls that already run with timing enabled are not sampled
+  ASSERT_OK(options.statistics->Reset());
+  SetPerfLevel(kEnableTime);
+  ASSERT_EQ("v1", Get("foo"));
+  SetPerfLevel(kDisable);
+  options.statistics->histogramData(SAMPLED_GET_MEMTABLE_NANOS, &memtable);
+  ASSERT_EQ(0, memtable.count);
+
+  // Sampling is off by default
+  options.stats_get_breakdown_one_in = 0;
+  Reopen(options);
+  ASSERT_OK(options.statistics->Reset());
+  ASSERT_EQ("v1", Get("foo"));
+  options.statistics->histogramData(SAMPLED_GET_MEMTABLE_NANOS, &memtable);
+  ASSERT_EQ(0, memtable.count);
+
+  // Values beyond the range of the random number generator are clamped
+  options.stats_get_breakdown_one_in = std::numeric_limits<uint32_t>::max();
+  Reopen(options);
+  ASSERT_EQ(static_cast<uint32_t>(std::numeric_limits<int32_t>::max()),
+            db_->GetDBOptions().stats_get_breakdown_one_in);
+  ASSERT_EQ("v1", Get("foo"));
+}
+
 #ifndef ROCKSDB_LITE
 
 TEST_F(DBStatisticsTest, VerifyChecksumReadStat) {
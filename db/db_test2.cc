@@ -4575,6 +4575,69 @@ TEST_F(DBTest2, TraceAndReplay) {
   ASSERT_OK(DestroyDB(dbname2, options));
 }
 
+TEST_F(DBTest2, TraceAndReplayPreservesKeyOrder) {
+  Options options = CurrentOptions();
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  Reopen(options);
+
+  std::string trace_filename = dbname_ + "/rocksdb.trace";
+  std::unique_ptr<TraceWriter> trace_writer;
+  ASSERT_OK(
+      NewFileTraceWriter(env_, EnvOptions(), trace_filename, &trace_writer));
+  ASSERT_OK(db_->StartTrace(TraceOptions(), std::move(trace_writer)));
+  const int kNumKeys = 10;
+  const int kNumRounds = 50;
+  for (int round = 0; round < kNumRounds; ++round) {
+    for (int k = 0; k < kNumKeys; ++k) {
+      ASSERT_OK(Put("put" + std::to_string(k), std::to_string(round)));
+      ASSERT_OK(Merge("merge" + std::to_string(k), std::to_string(round)));
+    }
+    // Spans several keys, so has to wait for the earlier writes to them
+    WriteBatch batch;
+    for (int k = 0; k < kNumKeys; ++k) {
+      ASSERT_OK(batch.Put("batch" + std::to_string(k), std::to_string(round)));
+    }
+    ASSERT_OK(db_->Write(WriteOptions(), &batch));
+  }
+  ASSERT_OK(db_->EndTrace());
+
+  std::string dbname2 = test::PerThreadDBPath(env_, "/db_replay");
+  ASSERT_OK(DestroyDB(dbname2, options));
+  options.create_if_missing = true;
+  DB* db2 = nullptr;
+  ASSERT_OK(DB::Open(options, dbname2, &db2));
+  std::vector<ColumnFamilyHandle*> handles = {db2->DefaultColumnFamily()};
+  std::unique_ptr<TraceReader> trace_reader;
+  ASSERT_OK(
+      NewFileTraceReader(env_, EnvOptions(), trace_filename, &trace_reader));
+  std::unique_ptr<Replayer> replayer;
+  ASSERT_OK(
+      db2->NewDefaultReplayer(handles, std::move(trace_reader), &replayer));
+  ASSERT_OK(replayer->Prepare());
+  ASSERT_OK(replayer->Replay(ReplayOptions(4, 1000.0), nullptr));
+
+  std::string expected_merge;
+  for (int round = 0; round < kNumRounds; ++round) {
+    if (round > 0) {
+      expected_merge += ",";
+    }
+    expected_merge += std::to_string(round);
+  }
+  std::string value;
+  for (int k = 0; k < kNumKeys; ++k) {
+    ASSERT_OK(db2->Get(ReadOptions(), "put" + std::to_string(k), &value));
+    ASSERT_EQ(std::to_string(kNumRounds - 1), value);
+    ASSERT_OK(db2->Get(ReadOptions(), "merge" + std::to_string(k), &value));
+    ASSERT_EQ(expected_merge, value);
+    ASSERT_OK(db2->Get(ReadOptions(), "batch" + std::to_string(k), &value));
+    ASSERT_EQ(std::to_string(kNumRounds - 1), value);
+  }
+
+  replayer.reset();
+  delete db2;
+  ASSERT_OK(DestroyDB(dbname2, options));
+}
+
 TEST_F(DBTest2, TraceAndManualReplay) {
   Options options = CurrentOptions();
   options.merge_operator = MergeOperators::CreatePutOperator();
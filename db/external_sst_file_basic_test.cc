@@ -1651,6 +1651,46 @@ TEST_F(ExternalSSTFileBasicTest, OverlappingFiles) {
   ASSERT_EQ(2, NumTableFilesAtLevel(0));
 }
 
+TEST_F(ExternalSSTFileBasicTest, ManyFilesOpenedInParallel) {
+  Options options = CurrentOptions();
+  options.max_file_opening_threads = 4;
+  DestroyAndReopen(options);
+
+  const int kNumFiles = 16;
+  const int kKeysPerFile = 100;
+  std::vector<std::string> files;
+  for (int i = 0; i < kNumFiles; i++) {
+    SstFileWriter sst_file_writer(EnvOptions(), options);
+    std::string file = sst_files_dir_ + "file" + std::to_string(i) + ".sst";
+    ASSERT_OK(sst_file_writer.Open(file));
+    for (int k = i * kKeysPerFile; k < (i + 1) * kKeysPerFile; k++) {
+      ASSERT_OK(sst_file_writer.Put(Key(k), Key(k) + "_val"));
+    }
+    ASSERT_OK(sst_file_writer.Finish());
+    files.push_back(std::move(file));
+  }
+  // Ingest the files in reverse key order to check that the results of the
+  // concurrently read files are kept in argument order.
+  std::reverse(files.begin(), files.end());
+
+  IngestExternalFileOptions ifo;
+  ifo.verify_checksums_before_ingest = true;
+  ASSERT_OK(db_->IngestExternalFile(files, ifo));
+  for (int k = 0; k < kNumFiles * kKeysPerFile; k++) {
+    ASSERT_EQ(Get(Key(k)), Key(k) + "_val");
+  }
+
+  std::vector<LiveFileMetaData> metadata;
+  db_->GetLiveFilesMetaData(&metadata);
+  ASSERT_EQ(kNumFiles, metadata.size());
+
+  // A missing file fails the whole ingestion.
+  files = {sst_files_dir_ + "file0.sst", sst_files_dir_ + "missing.sst"};
+  ASSERT_NOK(db_->IngestExternalFile(files, ifo));
+
+  DestroyAndRecreateExternalSSTFilesDir();
+}
+
 TEST_F(ExternalSSTFileBasicTest, IngestFileAfterDBPut) {
   // Repro https://github.com/facebook/rocksdb/issues/6245.
   // Flush three files to L0. Ingest one more file to trigger L0->L1 compaction
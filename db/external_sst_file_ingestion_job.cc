@@ -8,7 +8,9 @@
 #include "db/external_sst_file_ingestion_job.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <functional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -36,11 +38,44 @@ Status ExternalSstFileIngestionJob::Prepare(
     SuperVersion* sv) {
   Status status;
 
-  // Read the information of files we are ingesting
-  for (const std::string& file_path : external_files_paths) {
-    IngestedFileInfo file_to_ingest;
-    status =
-        GetIngestedFileInfo(file_path, next_file_number++, &file_to_ingest, sv);
+  // Read the information of files we are ingesting. Opening each file and
+  // optionally verifying its block checksums is independent of the other
+  // files, so, like loading table handlers on DB::Open(), spread the files
+  // over up to max_file_opening_threads threads.
+  const size_t num_external_files = external_files_paths.size();
+  std::vector<IngestedFileInfo> files_info(num_external_files);
+  std::vector<Status> files_info_status(num_external_files);
+  std::atomic<size_t> next_file_idx(0);
+  std::function<void()> get_file_info_func([&]() {
+    while (true) {
+      size_t file_idx = next_file_idx.fetch_add(1);
+      if (file_idx >= num_external_files) {
+        break;
+      }
+      files_info_status[file_idx] = GetIngestedFileInfo(
+          external_files_paths[file_idx], next_file_number + file_idx,
+          &files_info[file_idx], sv);
+    }
+  });
+  const size_t max_threads = std::min(
+      num_external_files,
+      static_cast<size_t>(std::max(db_options_.max_file_opening_threads, 1)));
+  std::vector<port::Thread> threads;
+  for (size_t i = 1; i < max_threads; i++) {
+    threads.emplace_back(get_file_info_func);
+  }
+  get_file_info_func();
+  for (auto& t : threads) {
+    t.join();
+  }
+  // Files are checked in order below, stopping at the first failure.
+  for (auto& s : files_info_status) {
+    s.PermitUncheckedError();
+  }
+
+  for (size_t i = 0; i < num_external_files; i++) {
+    IngestedFileInfo& file_to_ingest = files_info[i];
+    status = files_info_status[i];
     if (!status.ok()) {
       return status;
     }
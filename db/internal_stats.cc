@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstddef>
+#include <cstring>
 #include <limits>
 #include <sstream>
 #include <string>
@@ -26,6 +27,7 @@
 #include "port/port.h"
 #include "rocksdb/system_clock.h"
 #include "rocksdb/table.h"
+#include "rocksdb/utilities/sim_cache.h"
 #include "table/block_based/cachable_entry.h"
 #include "util/hash_containers.h"
 #include "util/string_util.h"
@@ -244,11 +246,14 @@ static const std::string cfstats = "cfstats";
 static const std::string cfstats_no_file_histogram =
     "cfstats-no-file-histogram";
 static const std::string cf_file_histogram = "cf-file-histogram";
+static const std::string compaction_forecast = "compaction-forecast";
 static const std::string dbstats = "dbstats";
 static const std::string levelstats = "levelstats";
 static const std::string block_cache_entry_stats = "block-cache-entry-stats";
 static const std::string fast_block_cache_entry_stats =
     "fast-block-cache-entry-stats";
+static const std::string block_cache_miss_ratio_curve =
+    "block-cache-miss-ratio-curve";
 static const std::string num_immutable_mem_table = "num-immutable-mem-table";
 static const std::string num_immutable_mem_table_flushed =
     "num-immutable-mem-table-flushed";
@@ -312,6 +317,7 @@ static const std::string live_blob_file_garbage_size =
 static const std::string blob_cache_capacity = "blob-cache-capacity";
 static const std::string blob_cache_usage = "blob-cache-usage";
 static const std::string blob_cache_pinned_usage = "blob-cache-pinned-usage";
+static const std::string live_user_operations = "live-user-operations";
 
 const std::string DB::Properties::kNumFilesAtLevelPrefix =
     rocksdb_prefix + num_files_at_level_prefix;
@@ -324,12 +330,16 @@ const std::string DB::Properties::kCFStatsNoFileHistogram =
     rocksdb_prefix + cfstats_no_file_histogram;
 const std::string DB::Properties::kCFFileHistogram =
     rocksdb_prefix + cf_file_histogram;
+const std::string DB::Properties::kCompactionForecast =
+    rocksdb_prefix + compaction_forecast;
 const std::string DB::Properties::kDBStats = rocksdb_prefix + dbstats;
 const std::string DB::Properties::kLevelStats = rocksdb_prefix + levelstats;
 const std::string DB::Properties::kBlockCacheEntryStats =
     rocksdb_prefix + block_cache_entry_stats;
 const std::string DB::Properties::kFastBlockCacheEntryStats =
     rocksdb_prefix + fast_block_cache_entry_stats;
+const std::string DB::Properties::kBlockCacheMissRatioCurve =
+    rocksdb_prefix + block_cache_miss_ratio_curve;
 const std::string DB::Properties::kNumImmutableMemTable =
     rocksdb_prefix + num_immutable_mem_table;
 const std::string DB::Properties::kNumImmutableMemTableFlushed =
@@ -422,6 +432,8 @@ const std::string DB::Properties::kBlobCacheUsage =
     rocksdb_prefix + blob_cache_usage;
 const std::string DB::Properties::kBlobCachePinnedUsage =
     rocksdb_prefix + blob_cache_pinned_usage;
+const std::string DB::Properties::kLiveUserOperations =
+    rocksdb_prefix + live_user_operations;
 
 const std::string InternalStats::kPeriodicCFStats =
     DB::Properties::kCFStats + ".periodic";
@@ -451,6 +463,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kCFFileHistogram,
          {false, &InternalStats::HandleCFFileHistogram, nullptr, nullptr,
           nullptr}},
+        {DB::Properties::kCompactionForecast,
+         {false, &InternalStats::HandleCompactionForecast, nullptr,
+          &InternalStats::HandleCompactionForecastMap, nullptr}},
         {DB::Properties::kDBStats,
          {false, &InternalStats::HandleDBStats, nullptr,
           &InternalStats::HandleDBMapStats, nullptr}},
@@ -460,6 +475,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kFastBlockCacheEntryStats,
          {true, &InternalStats::HandleFastBlockCacheEntryStats, nullptr,
           &InternalStats::HandleFastBlockCacheEntryStatsMap, nullptr}},
+        {DB::Properties::kBlockCacheMissRatioCurve,
+         {false, &InternalStats::HandleBlockCacheMissRatioCurve, nullptr,
+          &InternalStats::HandleBlockCacheMissRatioCurveMap, nullptr}},
         {DB::Properties::kSSTables,
          {false, &InternalStats::HandleSsTables, nullptr, nullptr, nullptr}},
         {DB::Properties::kAggregatedTableProperties,
@@ -602,6 +620,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kBlobCachePinnedUsage,
          {false, nullptr, &InternalStats::HandleBlobCachePinnedUsage, nullptr,
           nullptr}},
+        {DB::Properties::kLiveUserOperations,
+         {true, nullptr, nullptr, nullptr,
+          &DBImpl::GetPropertyHandleLiveUserOperations}},
 };
 
 InternalStats::InternalStats(int num_levels, SystemClock* clock,
@@ -618,6 +639,8 @@ InternalStats::InternalStats(int num_levels, SystemClock* clock,
       clock_(clock),
       cfd_(cfd),
       started_at_(clock->NowMicros()) {
+  forecast_window_start_.micros = started_at_;
+  forecast_window_next_ = forecast_window_start_;
   Cache* block_cache = GetBlockCacheForStats();
   if (block_cache) {
     // Extract or create stats collector. Could fail in rare cases.
@@ -798,6 +821,50 @@ bool InternalStats::HandleFastBlockCacheEntryStatsMap(
   return HandleBlockCacheEntryStatsMapInternal(values, true /* fast */);
 }
 
+MissRatioCurveCache* InternalStats::GetMissRatioCurveCache() {
+  Cache* block_cache = GetBlockCacheForStats();
+  if (block_cache == nullptr ||
+      strcmp(block_cache->Name(), MissRatioCurveCache::kClassName()) != 0) {
+    return nullptr;
+  }
+  return static_cast<MissRatioCurveCache*>(block_cache);
+}
+
+bool InternalStats::HandleBlockCacheMissRatioCurve(std::string* value,
+                                                   Slice /*suffix*/) {
+  MissRatioCurveCache* mrc_cache = GetMissRatioCurveCache();
+  if (mrc_cache == nullptr) {
+    return false;
+  }
+  std::ostringstream str;
+  str << "Block cache miss ratio curve, sampling rate "
+      << mrc_cache->GetSamplingRate() << ", "
+      << mrc_cache->GetSampledLookups() << " sampled lookups\n";
+  for (const auto& point : mrc_cache->GetMissRatioCurve()) {
+    str << "  capacity " << BytesToHumanString(point.first) << ": miss ratio "
+        << point.second << "\n";
+  }
+  *value = str.str();
+  return true;
+}
+
+bool InternalStats::HandleBlockCacheMissRatioCurveMap(
+    std::map<std::string, std::string>* values, Slice /*suffix*/) {
+  MissRatioCurveCache* mrc_cache = GetMissRatioCurveCache();
+  if (mrc_cache == nullptr) {
+    return false;
+  }
+  values->clear();
+  auto& v = *values;
+  v["sampling_rate"] = std::to_string(mrc_cache->GetSamplingRate());
+  v["sampled_lookups"] = std::to_string(mrc_cache->GetSampledLookups());
+  for (const auto& point : mrc_cache->GetMissRatioCurve()) {
+    v["miss_ratio." + std::to_string(point.first)] =
+        std::to_string(point.second);
+  }
+  return true;
+}
+
 bool InternalStats::HandleLiveSstFilesSizeAtTemperature(std::string* value,
                                                         Slice suffix) {
   uint64_t temperature;
@@ -1093,6 +1160,172 @@ bool InternalStats::HandleCFFileHistogram(std::string* value,
   return true;
 }
 
+InternalStats::ForecastSample InternalStats::TakeForecastSample() const {
+  ForecastSample sample;
+  sample.micros = clock_->NowMicros();
+  sample.ingest_bytes =
+      cf_stats_value_[BYTES_FLUSHED] + cf_stats_value_[BYTES_INGESTED_ADD_FILE];
+  // Flushes run at high priority, ingestion and recovery at user priority,
+  // so the low and bottom priority stats are those of the compactions.
+  for (Env::Priority pri : {Env::Priority::LOW, Env::Priority::BOTTOM}) {
+    const CompactionStats& stats = comp_stats_by_pri_[pri];
+    sample.compaction_bytes_read += stats.bytes_read_non_output_levels +
+                                    stats.bytes_read_output_level +
+                                    stats.bytes_read_blob;
+    sample.compaction_micros += stats.micros;
+  }
+  return sample;
+}
+
+void InternalStats::AdvanceForecastWindow(const ForecastSample& now) {
+  // Both rates are measured over the same recent window of wall-clock time,
+  // so that the compaction throughput accounts for as many compactions as
+  // actually ran side by side, and neither is dominated by the distant past.
+  // A compaction is only accounted for once it finishes, so the window spans
+  // at least a minute to smooth that out.
+  const uint64_t kWindowMicros = 60 * 1000000;
+  if (now.micros >= forecast_window_next_.micros + kWindowMicros) {
+    forecast_window_start_ = forecast_window_next_;
+    forecast_window_next_ = now;
+  }
+}
+
+void InternalStats::GetCompactionForecast(CompactionForecast* forecast) {
+  const auto* vstorage = cfd_->current()->storage_info();
+  const MutableCFOptions* mutable_cf_options =
+      cfd_->GetLatestMutableCFOptions();
+  *forecast = CompactionForecast();
+
+  const ForecastSample now = TakeForecastSample();
+  AdvanceForecastWindow(now);
+  const ForecastSample& start = forecast_window_start_;
+  if (now.micros > start.micros) {
+    double window_micros = static_cast<double>(now.micros - start.micros);
+    forecast->ingest_bytes_per_sec =
+        (now.ingest_bytes - start.ingest_bytes) * kMicrosInSec / window_micros;
+    forecast->compaction_bytes_per_sec =
+        (now.compaction_bytes_read - start.compaction_bytes_read) *
+        kMicrosInSec / window_micros;
+    forecast->compaction_concurrency =
+        (now.compaction_micros - start.compaction_micros) / window_micros;
+  }
+  uint64_t curr_ingest = now.ingest_bytes;
+
+  uint64_t bytes_written = 0;
+  for (const auto& stats : comp_stats_) {
+    bytes_written += stats.bytes_written + stats.bytes_written_blob;
+  }
+  if (curr_ingest > 0) {
+    forecast->measured_write_amp =
+        static_cast<double>(bytes_written) / curr_ingest;
+  }
+
+  // Leveled compaction moves data down one level at a time. A compaction
+  // into a level is triggered once the level above outgrows its target size,
+  // and rewrites the overlapping part of the output level along with the
+  // input, so each byte moved into a level costs one write of itself plus
+  // one write per byte of that level per byte of the target size above it.
+  // Flushing costs one more write. Other compaction styles fall back to the
+  // measured write amplification, FIFO never rewriting anything.
+  switch (cfd_->ioptions()->compaction_style) {
+    case kCompactionStyleLevel: {
+      double write_amp = 1.0;
+      int last_level = vstorage->num_non_empty_levels() - 1;
+      double upper_target =
+          static_cast<double>(mutable_cf_options->write_buffer_size) *
+          std::max(1, mutable_cf_options->level0_file_num_compaction_trigger);
+      for (int level = vstorage->base_level(); level > 0 && level <= last_level;
+           ++level) {
+        write_amp += 1.0 + static_cast<double>(vstorage->NumLevelBytes(level)) /
+                               std::max(1.0, upper_target);
+        upper_target = static_cast<double>(vstorage->MaxBytesForLevel(level));
+      }
+      forecast->estimated_write_amp = write_amp;
+      break;
+    }
+    case kCompactionStyleFIFO:
+      forecast->estimated_write_amp = 1.0;
+      break;
+    default:
+      forecast->estimated_write_amp =
+          std::max(1.0, forecast->measured_write_amp);
+      break;
+  }
+
+  forecast->pending_compaction_bytes =
+      vstorage->estimated_compaction_needed_bytes();
+  if (forecast->compaction_bytes_per_sec > 0) {
+    forecast->pending_compaction_seconds =
+        forecast->pending_compaction_bytes / forecast->compaction_bytes_per_sec;
+  }
+
+  // Every ingested byte adds about as many bytes of future compaction input
+  // as it will cost compaction writes, while compactions keep draining them
+  // at the measured throughput.
+  double growth_bytes_per_sec =
+      forecast->ingest_bytes_per_sec * (forecast->estimated_write_amp - 1.0) -
+      forecast->compaction_bytes_per_sec;
+  auto seconds_to_limit = [&](uint64_t limit) -> double {
+    if (limit == 0) {
+      return -1;
+    }
+    if (forecast->pending_compaction_bytes >= limit) {
+      return 0;
+    }
+    if (growth_bytes_per_sec <= 0) {
+      return -1;
+    }
+    return (limit - forecast->pending_compaction_bytes) / growth_bytes_per_sec;
+  };
+  forecast->seconds_to_slowdown =
+      seconds_to_limit(mutable_cf_options->soft_pending_compaction_bytes_limit);
+  forecast->seconds_to_stop =
+      seconds_to_limit(mutable_cf_options->hard_pending_compaction_bytes_limit);
+}
+
+bool InternalStats::HandleCompactionForecast(std::string* value,
+                                             Slice /*suffix*/) {
+  CompactionForecast forecast;
+  GetCompactionForecast(&forecast);
+  char buf[1000];
+  snprintf(buf, sizeof(buf),
+           "\n** Compaction Forecast [%s] **\n"
+           "Ingest: %.2f MB/s, compaction: %.2f MB/s by %.1f jobs on average\n"
+           "Write amplification: %.2f measured, %.2f estimated\n"
+           "Pending compaction: %.2f GB, %.1f seconds of compaction\n"
+           "Seconds to slowdown: %.1f, to stop: %.1f\n",
+           cfd_->GetName().c_str(), forecast.ingest_bytes_per_sec / kMB,
+           forecast.compaction_bytes_per_sec / kMB,
+           forecast.compaction_concurrency, forecast.measured_write_amp,
+           forecast.estimated_write_amp,
+           forecast.pending_compaction_bytes / kGB,
+           forecast.pending_compaction_seconds, forecast.seconds_to_slowdown,
+           forecast.seconds_to_stop);
+  value->append(buf);
+  return true;
+}
+
+bool InternalStats::HandleCompactionForecastMap(
+    std::map<std::string, std::string>* values, Slice /*suffix*/) {
+  CompactionForecast forecast;
+  GetCompactionForecast(&forecast);
+  values->clear();
+  auto& v = *values;
+  v["ingest_bytes_per_sec"] = std::to_string(forecast.ingest_bytes_per_sec);
+  v["compaction_bytes_per_sec"] =
+      std::to_string(forecast.compaction_bytes_per_sec);
+  v["compaction_concurrency"] = std::to_string(forecast.compaction_concurrency);
+  v["measured_write_amp"] = std::to_string(forecast.measured_write_amp);
+  v["estimated_write_amp"] = std::to_string(forecast.estimated_write_amp);
+  v["pending_compaction_bytes"] =
+      std::to_string(forecast.pending_compaction_bytes);
+  v["pending_compaction_seconds"] =
+      std::to_string(forecast.pending_compaction_seconds);
+  v["seconds_to_slowdown"] = std::to_string(forecast.seconds_to_slowdown);
+  v["seconds_to_stop"] = std::to_string(forecast.seconds_to_stop);
+  return true;
+}
+
 bool InternalStats::HandleDBMapStats(
     std::map<std::string, std::string>* db_stats, Slice /*suffix*/) {
   DumpDBMapStats(db_stats);
@@ -26,6 +26,7 @@ template <class Stats>
 class CacheEntryStatsCollector;
 class DBImpl;
 class MemTableList;
+class MissRatioCurveCache;
 
 // Config for retrieving a property's value.
 struct DBPropertyInfo {
@@ -506,6 +507,9 @@ class InternalStats {
     db_stats_snapshot_.Clear();
     bg_error_count_ = 0;
     started_at_ = clock_->NowMicros();
+    forecast_window_start_ = ForecastSample();
+    forecast_window_start_.micros = started_at_;
+    forecast_window_next_ = forecast_window_start_;
     has_cf_change_since_dump_ = true;
   }
 
@@ -513,6 +517,7 @@ class InternalStats {
                           const CompactionStats& stats) {
     comp_stats_[level].Add(stats);
     comp_stats_by_pri_[thread_pri].Add(stats);
+    AdvanceForecastWindow(TakeForecastSample());
   }
 
   void AddCompactionStats(int level, Env::Priority thread_pri,
@@ -597,6 +602,37 @@ class InternalStats {
 
   static const std::string kPeriodicCFStats;
 
+  // An online estimate of the compaction work the column family is in for,
+  // see DB::Properties::kCompactionForecast. Rates are wall-clock rates over
+  // the last one to two minutes, measured from a flush, compaction or query
+  // of the forecast at least a minute old, so over a longer time when none
+  // happened in between, or since the stats were last reset if that is more
+  // recent. Durations are -1 when they cannot be estimated.
+  struct CompactionForecast {
+    // Bytes added by flushes and file ingestion per second
+    double ingest_bytes_per_sec = 0;
+    // Bytes read by compactions per second, all concurrent compactions
+    // together
+    double compaction_bytes_per_sec = 0;
+    // Average number of compactions running at the same time
+    double compaction_concurrency = 0;
+    // Write amplification observed so far, flushes included
+    double measured_write_amp = 0;
+    // Write amplification of newly ingested data predicted from the current
+    // shape of the LSM tree, flushes included
+    double estimated_write_amp = 0;
+    uint64_t pending_compaction_bytes = 0;
+    // Time needed to work off pending_compaction_bytes at the current
+    // compaction throughput
+    double pending_compaction_seconds = -1;
+    // Time until pending_compaction_bytes reaches the soft (hard) limit at
+    // the current ingest rate, or -1 if it is not growing or has no limit.
+    double seconds_to_slowdown = -1;
+    double seconds_to_stop = -1;
+  };
+
+  void GetCompactionForecast(CompactionForecast* forecast);
+
  private:
   void DumpDBMapStats(std::map<std::string, std::string>* db_stats);
   void DumpDBStats(std::string* value);
@@ -617,6 +653,7 @@ class InternalStats {
   void DumpCFFileHistogram(std::string* value);
 
   Cache* GetBlockCacheForStats();
+  MissRatioCurveCache* GetMissRatioCurveCache();
   Cache* GetBlobCacheForStats();
 
   // Per-DB stats
@@ -743,6 +780,9 @@ class InternalStats {
   bool HandleCFStats(std::string* value, Slice suffix);
   bool HandleCFStatsNoFileHistogram(std::string* value, Slice suffix);
   bool HandleCFFileHistogram(std::string* value, Slice suffix);
+  bool HandleCompactionForecast(std::string* value, Slice suffix);
+  bool HandleCompactionForecastMap(std::map<std::string, std::string>* values,
+                                   Slice suffix);
   bool HandleCFStatsPeriodic(std::string* value, Slice suffix);
   bool HandleDBMapStats(std::map<std::string, std::string>* compaction_stats,
                         Slice suffix);
@@ -815,6 +855,9 @@ class InternalStats {
   bool HandleBlockCacheEntryStatsMap(std::map<std::string, std::string>* values,
                                      Slice suffix);
   bool HandleFastBlockCacheEntryStats(std::string* value, Slice suffix);
+  bool HandleBlockCacheMissRatioCurve(std::string* value, Slice suffix);
+  bool HandleBlockCacheMissRatioCurveMap(
+      std::map<std::string, std::string>* values, Slice suffix);
   bool HandleFastBlockCacheEntryStatsMap(
       std::map<std::string, std::string>* values, Slice suffix);
   bool HandleLiveSstFilesSizeAtTemperature(std::string* value, Slice suffix);
@@ -840,6 +883,23 @@ class InternalStats {
   SystemClock* clock_;
   ColumnFamilyData* cfd_;
   uint64_t started_at_;
+
+  // Running totals the CompactionForecast rates are derived from
+  struct ForecastSample {
+    uint64_t micros = 0;
+    uint64_t ingest_bytes = 0;
+    uint64_t compaction_bytes_read = 0;
+    uint64_t compaction_micros = 0;
+  };
+  // Rates are measured since forecast_window_start_, which moves up to
+  // forecast_window_next_ once that is old enough
+  ForecastSample forecast_window_start_;
+  ForecastSample forecast_window_next_;
+
+  ForecastSample TakeForecastSample() const;
+  // Called whenever a flush or compaction finishes and whenever the forecast
+  // is queried, so that the window keeps moving without queries
+  void AdvanceForecastWindow(const ForecastSample& now);
 };
 
 #else
@@ -58,6 +58,7 @@ ImmutableMemTableOptions::ImmutableMemTableOptions(
       memtable_whole_key_filtering(
           mutable_cf_options.memtable_whole_key_filtering),
       inplace_update_support(ioptions.inplace_update_support),
+      inplace_merge_support(ioptions.inplace_merge_support),
       inplace_update_num_locks(mutable_cf_options.inplace_update_num_locks),
       inplace_callback(ioptions.inplace_callback),
       max_successive_merges(mutable_cf_options.max_successive_merges),
@@ -904,6 +905,9 @@ struct Saver {
 
   ReadCallback* callback_;
   bool* is_blob_index;
+  // If not nullptr, a plain value is returned here pointing into the
+  // memtable instead of being copied into `value`
+  Slice* pinned_value;
   bool allow_data_in_errors;
   size_t protection_bytes_per_key;
   bool CheckCallback(SequenceNumber _seq) {
@@ -1072,6 +1076,9 @@ static bool SaveValue(void* arg, const char* entry) {
                 s->statistics, s->clock, /* result_operand */ nullptr,
                 /* update_num_ops_stats */ true);
           }
+        } else if (s->pinned_value) {
+          assert(!s->inplace_update_support);
+          *(s->pinned_value) = v;
         } else if (s->value) {
           s->value->assign(v.data(), v.size());
         } else if (s->columns) {
@@ -1294,7 +1301,8 @@ void MemTable::GetFromTable(const LookupKey& key,
                             PinnableWideColumns* columns,
                             std::string* timestamp, Status* s,
                             MergeContext* merge_context, SequenceNumber* seq,
-                            bool* found_final_value, bool* merge_in_progress) {
+                            bool* found_final_value, bool* merge_in_progress,
+                            Slice* pinned_value) {
   Saver saver;
   saver.status = s;
   saver.found_final_value = found_final_value;
@@ -1314,6 +1322,7 @@ void MemTable::GetFromTable(const LookupKey& key,
   saver.clock = clock_;
   saver.callback_ = callback;
   saver.is_blob_index = is_blob_index;
+  saver.pinned_value = pinned_value;
   saver.do_merge = do_merge;
   saver.allow_data_in_errors = moptions_.allow_data_in_errors;
   saver.protection_bytes_per_key = moptions_.protection_bytes_per_key;
@@ -1322,7 +1331,8 @@ void MemTable::GetFromTable(const LookupKey& key,
 }
 
 void MemTable::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
-                        ReadCallback* callback, bool immutable_memtable) {
+                        ReadCallback* callback, bool immutable_memtable,
+                        SharedCleanablePtr* value_pinner) {
   // The sequence number is updated synchronously in version_set.h
   if (IsEmpty()) {
     // Avoiding recording stats for speed.
@@ -1384,18 +1394,27 @@ void MemTable::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
       }
     }
     SequenceNumber dummy_seq;
+    // Values are modified in place with inplace_update_support
+    bool pin_value =
+        value_pinner != nullptr && !moptions_.inplace_update_support;
+    Slice pinned_value(nullptr, 0);
     GetFromTable(*(iter->lkey), iter->max_covering_tombstone_seq, true,
                  callback, &iter->is_blob_index, iter->value->GetSelf(),
                  /*columns=*/nullptr, iter->timestamp, iter->s,
                  &(iter->merge_context), &dummy_seq, &found_final_value,
-                 &merge_in_progress);
+                 &merge_in_progress, pin_value ? &pinned_value : nullptr);
 
     if (!found_final_value && merge_in_progress) {
       *(iter->s) = Status::MergeInProgress();
     }
 
     if (found_final_value) {
-      iter->value->PinSelf();
+      if (pinned_value.data() != nullptr) {
+        iter->value->PinSlice(pinned_value, nullptr /* cleanable */);
+        value_pinner->RegisterCopyWith(iter->value);
+      } else {
+        iter->value->PinSelf();
+      }
       range->AddValueSize(iter->value->size());
       range->MarkKeyDone(iter);
       RecordTick(moptions_.statistics, MEMTABLE_HIT);
@@ -1569,6 +1588,90 @@ Status MemTable::UpdateCallback(SequenceNumber seq, const Slice& key,
   return Status::NotFound();
 }
 
+Status MemTable::MergeInPlace(SequenceNumber seq, const Slice& key,
+                              const Slice& operand,
+                              const ProtectionInfoKVOS64* kv_prot_info) {
+  assert(moptions_.merge_operator != nullptr);
+  LookupKey lkey(key, seq);
+  Slice mem_key = lkey.memtable_key();
+
+  std::unique_ptr<MemTableRep::Iterator> iter(
+      table_->GetDynamicPrefixIterator());
+  iter->Seek(lkey.internal_key(), mem_key.data());
+
+  if (iter->Valid()) {
+    // Refer to comments under MemTable::Add() for entry format.
+    const char* entry = iter->key();
+    uint32_t key_length = 0;
+    const char* key_ptr = GetVarint32Ptr(entry, entry + 5, &key_length);
+    if (comparator_.comparator.user_comparator()->Equal(
+            Slice(key_ptr, key_length - 8), lkey.user_key())) {
+      // Correct user key
+      const uint64_t tag = DecodeFixed64(key_ptr + key_length - 8);
+      ValueType type;
+      SequenceNumber existing_seq;
+      UnPackSequenceAndType(tag, &existing_seq, &type);
+      assert(existing_seq != seq);
+      if (type == kTypeMerge || type == kTypeValue) {
+        // A newer range tombstone hides the entry, so the operand must not be
+        // folded into it
+        if (!is_range_del_table_empty_.load(std::memory_order_relaxed)) {
+          std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
+              NewRangeTombstoneIterator(ReadOptions(), seq,
+                                        false /* immutable_memtable */));
+          if (range_del_iter != nullptr &&
+              range_del_iter->MaxCoveringTombstoneSeqnum(lkey.user_key()) >
+                  existing_seq) {
+            return Status::NotFound();
+          }
+        }
+        // Only this thread modifies the entry, so it can be read unlocked
+        Slice prev_value = GetLengthPrefixedSlice(key_ptr + key_length);
+        std::string new_value;
+        bool merged;
+        if (type == kTypeMerge) {
+          merged = moptions_.merge_operator->PartialMerge(
+              lkey.user_key(), prev_value, operand, &new_value,
+              moptions_.info_log);
+        } else {
+          merged = MergeHelper::TimedFullMerge(
+                       moptions_.merge_operator, lkey.user_key(), &prev_value,
+                       {operand}, &new_value, moptions_.info_log,
+                       moptions_.statistics, clock_,
+                       /* result_operand */ nullptr,
+                       /* update_num_ops_stats */ false)
+                       .ok();
+        }
+        if (merged && new_value.size() <= prev_value.size()) {
+          WriteLock wl(GetLock(lkey.user_key()));
+          char* p = EncodeVarint32(const_cast<char*>(key_ptr) + key_length,
+                                   static_cast<uint32_t>(new_value.size()));
+          memcpy(p, new_value.data(), new_value.size());
+          RecordTick(moptions_.statistics, NUMBER_KEYS_UPDATED);
+          if (kv_prot_info != nullptr) {
+            ProtectionInfoKVOS64 updated_kv_prot_info(*kv_prot_info);
+            // `seq` is swallowed and `existing_seq` prevails.
+            updated_kv_prot_info.UpdateS(seq, existing_seq);
+            updated_kv_prot_info.UpdateV(operand, new_value);
+            if (type != kTypeMerge) {
+              updated_kv_prot_info.UpdateO(kTypeMerge, type);
+            }
+            UpdateEntryChecksum(&updated_kv_prot_info, key, new_value, type,
+                                existing_seq, p + new_value.size());
+            Slice encoded(entry, p + new_value.size() - entry);
+            return VerifyEncodedEntry(encoded, updated_kv_prot_info);
+          } else {
+            UpdateEntryChecksum(nullptr, key, new_value, type, existing_seq,
+                                p + new_value.size());
+          }
+          return Status::OK();
+        }
+      }
+    }
+  }
+  return Status::NotFound();
+}
+
 size_t MemTable::CountSuccessiveMergeEntries(const LookupKey& key) {
   Slice memkey = key.memtable_key();
 
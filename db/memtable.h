@@ -48,6 +48,7 @@ struct ImmutableMemTableOptions {
   size_t memtable_huge_page_size;
   bool memtable_whole_key_filtering;
   bool inplace_update_support;
+  bool inplace_merge_support;
   size_t inplace_update_num_locks;
   UpdateStatus (*inplace_callback)(char* existing_value,
                                    uint32_t* existing_value_size,
@@ -283,8 +284,12 @@ class MemTable {
   // @param immutable_memtable Whether this memtable is immutable. Used
   // internally by NewRangeTombstoneIterator(). See comment above
   // NewRangeTombstoneIterator() for more detail.
+  //
+  // If `value_pinner` is not nullptr, values are pinned in place instead of
+  // copied where possible, each holding a reference to `value_pinner`.
   void MultiGet(const ReadOptions& read_options, MultiGetRange* range,
-                ReadCallback* callback, bool immutable_memtable);
+                ReadCallback* callback, bool immutable_memtable,
+                SharedCleanablePtr* value_pinner = nullptr);
 
   // If `key` exists in current memtable with type value_type and the existing
   // value is at least as large as the new value, updates it in-place. Otherwise
@@ -317,6 +322,22 @@ class MemTable {
                         const Slice& delta,
                         const ProtectionInfoKVOS64* kv_prot_info);
 
+  // If the latest version of `key` in current memtable is a merge operand,
+  // combines it with `operand` through `MergeOperator::PartialMerge()`, or if
+  // it has type `kTypeValue`, merges `operand` into it. Either way the result
+  // replaces the existing operand or value in-place if it is no larger.
+  //
+  // Returns `Status::NotFound` if `key` does not exist in current memtable,
+  // its latest version is neither a merge operand nor has type `kTypeValue`,
+  // is covered by a newer range tombstone, or the merge fails or its result is
+  // larger than the existing entry.
+  //
+  // REQUIRES: external synchronization to prevent simultaneous
+  // operations on the same MemTable.
+  Status MergeInPlace(SequenceNumber seq, const Slice& key,
+                      const Slice& operand,
+                      const ProtectionInfoKVOS64* kv_prot_info);
+
   // Returns the number of successive merge entries starting from the newest
   // entry for the key up to the last non-merge entry or last entry for the
   // key in the memtable.
@@ -632,7 +653,8 @@ class MemTable {
                     std::string* value, PinnableWideColumns* columns,
                     std::string* timestamp, Status* s,
                     MergeContext* merge_context, SequenceNumber* seq,
-                    bool* found_final_value, bool* merge_in_progress);
+                    bool* found_final_value, bool* merge_in_progress,
+                    Slice* pinned_value = nullptr);
 
   // Always returns non-null and assumes certain pre-checks (e.g.,
   // is_range_del_table_empty_) are done. This is only valid during the lifetime
@@ -118,10 +118,11 @@ bool MemTableListVersion::Get(const LookupKey& key, std::string* value,
 
 void MemTableListVersion::MultiGet(const ReadOptions& read_options,
                                    MultiGetRange* range,
-                                   ReadCallback* callback) {
+                                   ReadCallback* callback,
+                                   SharedCleanablePtr* value_pinner) {
   for (auto memtable : memlist_) {
     memtable->MultiGet(read_options, range, callback,
-                       true /* immutable_memtable */);
+                       true /* immutable_memtable */, value_pinner);
     if (range->empty()) {
       return;
     }
@@ -1249,6 +1249,72 @@ TEST_P(PlainTableDBTest, NonExistingKeyToNonEmptyBucket) {
   delete iter;
 }
 
+TEST_P(PlainTableDBTest, KeyFingerprintIndex) {
+  for (bool total_order : {false, true}) {
+    Options options = CurrentOptions();
+    options.create_if_missing = true;
+    options.memtable_factory.reset(new SkipListFactory);
+    PlainTableOptions plain_table_options;
+    plain_table_options.user_key_len = kPlainTableVariableLength;
+    plain_table_options.bloom_bits_per_key = 10;
+    plain_table_options.index_sparseness = 8;
+    plain_table_options.encoding_type = kPlain;
+    plain_table_options.key_fingerprint_index = true;
+    if (total_order) {
+      options.prefix_extractor.reset();
+      plain_table_options.hash_table_ratio = 0;
+    }
+    options.table_factory.reset(NewPlainTableFactory(plain_table_options));
+    DestroyAndReopen(&options);
+
+    auto key = [](int i) {
+      char buf[100];
+      snprintf(buf, sizeof(buf), "fp_key__%08d", i);
+      return std::string(buf);
+    };
+    // Even keys only, with a second version of every tenth key and a
+    // tombstone for every seventh key in the same file
+    for (int i = 0; i < 2000; i += 2) {
+      ASSERT_OK(Put(key(i), "v1_" + std::to_string(i)));
+    }
+    const Snapshot* snapshot = dbfull()->GetSnapshot();
+    for (int i = 0; i < 2000; i += 2) {
+      if (i % 10 == 0) {
+        ASSERT_OK(Put(key(i), "v2_" + std::to_string(i)));
+      } else if (i % 7 == 0) {
+        ASSERT_OK(Delete(key(i)));
+      }
+    }
+    ASSERT_OK(dbfull()->TEST_FlushMemTable());
+
+    for (int i = 0; i < 2000; ++i) {
+      std::string expected = "NOT_FOUND";
+      std::string expected_at_snapshot = "NOT_FOUND";
+      if (i % 2 == 0) {
+        expected_at_snapshot = "v1_" + std::to_string(i);
+        if (i % 10 == 0) {
+          expected = "v2_" + std::to_string(i);
+        } else if (i % 7 != 0) {
+          expected = expected_at_snapshot;
+        }
+      }
+      ASSERT_EQ(expected, Get(key(i)));
+      ASSERT_EQ(expected_at_snapshot, Get(key(i), snapshot));
+    }
+    ASSERT_EQ("NOT_FOUND", Get("fp_key__"));
+    ASSERT_EQ("NOT_FOUND", Get(key(1999) + "0"));
+
+    // Iterators still use the regular index
+    std::unique_ptr<Iterator> iter(dbfull()->NewIterator(ReadOptions()));
+    iter->Seek(key(11));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(key(12), iter->key().ToString());
+    ASSERT_OK(iter->status());
+    iter.reset();
+    dbfull()->ReleaseSnapshot(snapshot);
+  }
+}
+
 static std::string Key(int i) {
   char buf[100];
   snprintf(buf, sizeof(buf), "key_______%06d", i);
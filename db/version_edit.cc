@@ -11,6 +11,7 @@
 
 #include "db/blob/blob_index.h"
 #include "db/version_set.h"
+#include "db/wide/wide_column_serialization.h"
 #include "logging/event_logger.h"
 #include "rocksdb/slice.h"
 #include "table/unique_id_impl.h"
@@ -20,7 +21,29 @@
 
 namespace ROCKSDB_NAMESPACE {
 
-namespace {}  // anonymous namespace
+namespace {
+Status UpdateOldestBlobFileNumber(const Slice& blob_index_slice,
+                                  uint64_t* oldest_blob_file_number) {
+  BlobIndex blob_index;
+  const Status s = blob_index.DecodeFrom(blob_index_slice);
+  if (!s.ok()) {
+    return s;
+  }
+
+  if (!blob_index.IsInlined() && !blob_index.HasTTL()) {
+    if (blob_index.file_number() == kInvalidBlobFileNumber) {
+      return Status::Corruption("Invalid blob file number");
+    }
+
+    if (*oldest_blob_file_number == kInvalidBlobFileNumber ||
+        *oldest_blob_file_number > blob_index.file_number()) {
+      *oldest_blob_file_number = blob_index.file_number();
+    }
+  }
+
+  return Status::OK();
+}
+}  // anonymous namespace
 
 uint64_t PackFileNumberAndPathId(uint64_t number, uint64_t path_id) {
   assert(number <= kFileNumberMask);
@@ -31,20 +54,30 @@ Status FileMetaData::UpdateBoundaries(const Slice& key, const Slice& value,
                                       SequenceNumber seqno,
                                       ValueType value_type) {
   if (value_type == kTypeBlobIndex) {
-    BlobIndex blob_index;
-    const Status s = blob_index.DecodeFrom(value);
+    const Status s =
+        UpdateOldestBlobFileNumber(value, &oldest_blob_file_number);
+    if (!s.ok()) {
+      return s;
+    }
+  } else if (value_type == kTypeWideColumnEntity &&
+             WideColumnSerialization::HasBlobIndices(value)) {
+    Slice input = value;
+    WideColumns columns;
+    std::vector<WideColumnSerialization::ColumnValueType> value_types;
+
+    Status s = WideColumnSerialization::DeserializeWithBlobIndices(
+        input, columns, value_types);
     if (!s.ok()) {
       return s;
     }
 
-    if (!blob_index.IsInlined() && !blob_index.HasTTL()) {
-      if (blob_index.file_number() == kInvalidBlobFileNumber) {
-        return Status::Corruption("Invalid blob file number");
-      }
-
-      if (oldest_blob_file_number == kInvalidBlobFileNumber ||
-          oldest_blob_file_number > blob_index.file_number()) {
-        oldest_blob_file_number = blob_index.file_number();
+    for (size_t i = 0; i < columns.size(); ++i) {
+      if (value_types[i] == WideColumnSerialization::kColumnBlobIndex) {
+        s = UpdateOldestBlobFileNumber(columns[i].value(),
+                                       &oldest_blob_file_number);
+        if (!s.ok()) {
+          return s;
+        }
       }
     }
   }
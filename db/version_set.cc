@@ -52,6 +52,7 @@
 #include "monitoring/perf_context_imp.h"
 #include "monitoring/persistent_stats_history.h"
 #include "options/options_helper.h"
+#include "rocksdb/compaction_filter.h"
 #include "rocksdb/env.h"
 #include "rocksdb/merge_operator.h"
 #include "rocksdb/write_buffer_manager.h"
@@ -3349,6 +3350,9 @@ void VersionStorageInfo::ComputeCompactionScore(
   if (mutable_cf_options.ttl > 0) {
     ComputeExpiredTtlFiles(immutable_options, mutable_cf_options.ttl);
   }
+  if (compaction_style_ == kCompactionStyleLevel) {
+    ComputeDroppableFiles(immutable_options);
+  }
   if (mutable_cf_options.periodic_compaction_seconds > 0) {
     ComputeFilesMarkedForPeriodicCompaction(
         immutable_options, mutable_cf_options.periodic_compaction_seconds);
@@ -3362,6 +3366,13 @@ void VersionStorageInfo::ComputeCompactionScore(
         mutable_cf_options.blob_garbage_collection_force_threshold);
   }
 
+  if (mutable_cf_options.enable_blob_garbage_collection &&
+      mutable_cf_options.blob_garbage_collection_file_ratio_threshold < 1.0 &&
+      files_marked_for_forced_blob_gc_.empty()) {
+    ComputeFilesMarkedForBlobGCByFileRatio(
+        mutable_cf_options.blob_garbage_collection_file_ratio_threshold);
+  }
+
   EstimateCompactionBytesNeeded(mutable_cf_options);
 }
 
@@ -3414,6 +3425,80 @@ void VersionStorageInfo::ComputeExpiredTtlFiles(
   }
 }
 
+void VersionStorageInfo::ComputeDroppableFiles(
+    const ImmutableOptions& ioptions) {
+  droppable_files_.clear();
+  if (ioptions.compaction_filter_factory == nullptr ||
+      !ioptions.compaction_filter_factory->SupportsDroppingTableFiles() ||
+      !ioptions.compaction_filter_factory->ShouldFilterTableFileCreation(
+          TableFileCreationReason::kCompaction)) {
+    return;
+  }
+  for (int level = 0; level < num_levels(); level++) {
+    for (FileMetaData* f : files_[level]) {
+      if (!f->being_compacted && IsDroppableFile(ioptions, level, *f)) {
+        droppable_files_.emplace_back(level, f);
+      }
+    }
+  }
+}
+
+bool VersionStorageInfo::IsDroppableFile(const ImmutableOptions& ioptions,
+                                         int level,
+                                         const FileMetaData& f) const {
+  // Tombstones must stay to hide older versions of their keys, and blob
+  // files have to learn about their garbage through compactions
+  if (f.fd.table_reader == nullptr ||
+      f.oldest_blob_file_number != kInvalidBlobFileNumber) {
+    return false;
+  }
+  std::shared_ptr<const TableProperties> props =
+      f.fd.table_reader->GetTableProperties();
+  if (props == nullptr || props->num_deletions != 0 ||
+      props->num_range_deletions != 0 ||
+      !ioptions.compaction_filter_factory->ShouldDropTableFile(*props)) {
+    return false;
+  }
+  return !HasOlderOverlappingFile(level, f);
+}
+
+bool VersionStorageInfo::HasOlderOverlappingFile(
+    int level, const FileMetaData& f) const {
+  const Slice smallest = f.smallest.user_key();
+  const Slice largest = f.largest.user_key();
+  auto overlaps = [&](const FileMetaData* other) {
+    return user_comparator_->CompareWithoutTimestamp(
+               other->smallest.user_key(), largest) <= 0 &&
+           user_comparator_->CompareWithoutTimestamp(
+               smallest, other->largest.user_key()) <= 0;
+  };
+  if (level == 0) {
+    // L0 files are sorted newest first
+    bool older = false;
+    for (const FileMetaData* other : files_[0]) {
+      if (older && overlaps(other)) {
+        return true;
+      }
+      older = older || other == &f;
+    }
+  }
+  for (int lower = std::max(level + 1, 1); lower < num_levels(); lower++) {
+    // The files of the other levels are sorted and do not overlap, so only
+    // the first one that does not end before `f` can overlap it
+    const std::vector<FileMetaData*>& files = files_[lower];
+    auto it = std::lower_bound(
+        files.begin(), files.end(), smallest,
+        [this](const FileMetaData* other, const Slice& key) {
+          return user_comparator_->CompareWithoutTimestamp(
+                     other->largest.user_key(), key) < 0;
+        });
+    if (it != files.end() && overlaps(*it)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void VersionStorageInfo::ComputeFilesMarkedForPeriodicCompaction(
     const ImmutableOptions& ioptions,
     const uint64_t periodic_compaction_seconds) {
@@ -3557,6 +3642,65 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
     return;
   }
 
+  MarkLinkedSstsForForcedBlobGC(linked_ssts);
+}
+
+void VersionStorageInfo::ComputeFilesMarkedForBlobGCByFileRatio(
+    double blob_garbage_collection_file_ratio_threshold) {
+  files_marked_for_forced_blob_gc_.clear();
+
+  // Compacting the SSTs linked to a blob file, i.e. whose oldest referenced
+  // blob file it is, relocates their blobs in it, so their output no longer
+  // links to it. Hence each such compaction makes progress, unlike compacting
+  // SSTs that may not reference the blob file at all. Blob files with no
+  // linked SSTs get their blobs relocated whenever compactions come across
+  // them; see CompactionIterator::GarbageCollectBlobIfNeeded().
+  const BlobFileMetaData* target = nullptr;
+  double target_ratio = 0.0;
+
+  for (const auto& meta : blob_files_) {
+    assert(meta);
+
+    const uint64_t total_blob_bytes = meta->GetTotalBlobBytes();
+    if (meta->GetLinkedSsts().empty() || total_blob_bytes == 0) {
+      continue;
+    }
+
+    const double ratio = static_cast<double>(meta->GetGarbageBlobBytes()) /
+                         static_cast<double>(total_blob_bytes);
+    if (ratio < blob_garbage_collection_file_ratio_threshold ||
+        ratio <= target_ratio) {
+      continue;
+    }
+
+    bool any_sst_available = false;
+    for (uint64_t sst_file_number : meta->GetLinkedSsts()) {
+      const FileLocation location = GetFileLocation(sst_file_number);
+      assert(location.IsValid());
+
+      const FileMetaData* const sst_meta =
+          files_[location.GetLevel()][location.GetPosition()];
+      assert(sst_meta);
+
+      if (!sst_meta->being_compacted) {
+        any_sst_available = true;
+        break;
+      }
+    }
+
+    if (any_sst_available) {
+      target = meta.get();
+      target_ratio = ratio;
+    }
+  }
+
+  if (target != nullptr) {
+    MarkLinkedSstsForForcedBlobGC(target->GetLinkedSsts());
+  }
+}
+
+void VersionStorageInfo::MarkLinkedSstsForForcedBlobGC(
+    const BlobFileMetaData::LinkedSsts& linked_ssts) {
   for (uint64_t sst_file_number : linked_ssts) {
     const FileLocation location = GetFileLocation(sst_file_number);
     assert(location.IsValid());
@@ -204,6 +204,22 @@ class VersionStorageInfo {
   void ComputeExpiredTtlFiles(const ImmutableOptions& ioptions,
                               const uint64_t ttl);
 
+  // This computes droppable_files_ and is called by
+  // ComputeCompactionScore()
+  void ComputeDroppableFiles(const ImmutableOptions& ioptions);
+
+  // Returns whether `f`, a file of `level`, can be deleted because the
+  // compaction filter factory of the column family would remove every entry
+  // of it, see CompactionFilterFactory::ShouldDropTableFile(), and no older
+  // file overlaps it. Dropping a file with older versions of its keys below
+  // would make those visible again.
+  bool IsDroppableFile(const ImmutableOptions& ioptions, int level,
+                       const FileMetaData& f) const;
+
+  // Returns whether some file older than `f`, a file of `level`, i.e. an
+  // older L0 file or a file of a lower level, overlaps its user key range
+  bool HasOlderOverlappingFile(int level, const FileMetaData& f) const;
+
   // This computes files_marked_for_periodic_compaction_ and is called by
   // ComputeCompactionScore()
   void ComputeFilesMarkedForPeriodicCompaction(
@@ -230,6 +246,14 @@ class VersionStorageInfo {
       double blob_garbage_collection_age_cutoff,
       double blob_garbage_collection_force_threshold);
 
+  // This computes files_marked_for_forced_blob_gc_ based on the ratio of
+  // garbage in each blob file, and is called by ComputeCompactionScore() if
+  // ComputeFilesMarkedForForcedBlobGC() marked no files.
+  //
+  // REQUIRES: DB mutex held
+  void ComputeFilesMarkedForBlobGCByFileRatio(
+      double blob_garbage_collection_file_ratio_threshold);
+
   bool level0_non_overlapping() const { return level0_non_overlapping_; }
 
   // Updates the oldest snapshot and related internal state, like the bottommost
@@ -237,6 +261,20 @@ class VersionStorageInfo {
   // REQUIRES: DB mutex held
   void UpdateOldestSnapshot(SequenceNumber oldest_snapshot_seqnum);
 
+  // Sets the newest live snapshot, or kMaxSequenceNumber if there is none,
+  // before compactions are picked. Droppable files that it can see are kept.
+  // REQUIRES: DB mutex held
+  void SetNewestSnapshot(SequenceNumber newest_snapshot_seqnum) {
+    newest_snapshot_seqnum_ = newest_snapshot_seqnum;
+  }
+
+  // Returns whether the newest snapshot set by SetNewestSnapshot() can see
+  // some entry of `f`
+  bool IsVisibleToSnapshot(const FileMetaData& f) const {
+    return newest_snapshot_seqnum_ != kMaxSequenceNumber &&
+           f.fd.smallest_seqno <= newest_snapshot_seqnum_;
+  }
+
   int MaxInputLevel() const;
   int MaxOutputLevel(bool allow_ingest_behind) const;
 
@@ -447,6 +485,13 @@ class VersionStorageInfo {
     return expired_ttl_files_;
   }
 
+  // REQUIRES: ComputeCompactionScore has been called
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>& DroppableFiles() const {
+    assert(finalized_);
+    return droppable_files_;
+  }
+
   // REQUIRES: ComputeCompactionScore has been called
   // REQUIRES: DB mutex held during access
   const autovector<std::pair<int, FileMetaData*>>&
@@ -656,6 +701,10 @@ class VersionStorageInfo {
 
   autovector<std::pair<int, FileMetaData*>> expired_ttl_files_;
 
+  // Files not being compacted whose entries would all be removed by the
+  // compaction filter, in increasing order of level
+  autovector<std::pair<int, FileMetaData*>> droppable_files_;
+
   autovector<std::pair<int, FileMetaData*>>
       files_marked_for_periodic_compaction_;
 
@@ -671,6 +720,11 @@ class VersionStorageInfo {
 
   autovector<std::pair<int, FileMetaData*>> files_marked_for_forced_blob_gc_;
 
+  // Adds the SSTs in `linked_ssts` that are not being compacted to
+  // files_marked_for_forced_blob_gc_
+  void MarkLinkedSstsForForcedBlobGC(
+      const BlobFileMetaData::LinkedSsts& linked_ssts);
+
   // Threshold for needing to mark another bottommost file. Maintain it so we
   // can quickly check when releasing a snapshot whether more bottommost files
   // became eligible for compaction. It's defined as the min of the max nonzero
@@ -683,6 +737,9 @@ class VersionStorageInfo {
   // created that references it.
   SequenceNumber oldest_snapshot_seqnum_ = 0;
 
+  // See SetNewestSnapshot()
+  SequenceNumber newest_snapshot_seqnum_ = kMaxSequenceNumber;
+
   // Level that should be compacted next and its compaction score.
   // Score < 1 means compaction is not strictly needed.  These fields
   // are initialized by ComputeCompactionScore.
@@ -871,6 +871,54 @@ TEST_F(VersionStorageInfoTest, ForcedBlobGCMultipleBatches) {
   }
 }
 
+TEST_F(VersionStorageInfoTest, ForcedBlobGCByFileRatio) {
+  // Add three L0 SSTs (1, 2, and 3), each linked to its own blob file (10,
+  // 11, and 12), and an unlinked blob file 13. The ratios of garbage in the
+  // blob files are 0.1, 0.6, 0.8 and 0.95, respectively.
+
+  constexpr int level = 0;
+
+  Add(level, 1, "bar1", "foo1", 1000, 10);
+  Add(level, 2, "bar2", "foo2", 1000, 11);
+  Add(level, 3, "bar3", "foo3", 1000, 12);
+
+  AddBlob(10, 10, 100000, BlobFileMetaData::LinkedSsts{1}, 1, 10000);
+  AddBlob(11, 10, 100000, BlobFileMetaData::LinkedSsts{2}, 6, 60000);
+  AddBlob(12, 10, 100000, BlobFileMetaData::LinkedSsts{3}, 8, 80000);
+  AddBlob(13, 10, 100000, BlobFileMetaData::LinkedSsts{}, 9, 95000);
+
+  UpdateVersionStorageInfo();
+
+  const auto& level_files = vstorage_.LevelFiles(level);
+  ASSERT_EQ(level_files.size(), 3);
+
+  // No linked blob file has enough garbage
+  vstorage_.ComputeFilesMarkedForBlobGCByFileRatio(0.9);
+  ASSERT_TRUE(vstorage_.FilesMarkedForForcedBlobGC().empty());
+
+  // The SST linked to the blob file with the most garbage is picked
+  vstorage_.ComputeFilesMarkedForBlobGCByFileRatio(0.5);
+  {
+    const auto& marked = vstorage_.FilesMarkedForForcedBlobGC();
+    ASSERT_EQ(marked.size(), 1);
+    ASSERT_EQ(marked[0].first, level);
+    ASSERT_EQ(marked[0].second->fd.GetNumber(), 3);
+  }
+
+  // Then the next one, once that is being compacted
+  level_files[2]->being_compacted = true;
+  vstorage_.ComputeFilesMarkedForBlobGCByFileRatio(0.5);
+  {
+    const auto& marked = vstorage_.FilesMarkedForForcedBlobGC();
+    ASSERT_EQ(marked.size(), 1);
+    ASSERT_EQ(marked[0].second->fd.GetNumber(), 2);
+  }
+
+  vstorage_.ComputeFilesMarkedForBlobGCByFileRatio(0.7);
+  ASSERT_TRUE(vstorage_.FilesMarkedForForcedBlobGC().empty());
+  level_files[2]->being_compacted = false;
+}
+
 class VersionStorageInfoTimestampTest : public VersionStorageInfoTestBase {
  public:
   VersionStorageInfoTimestampTest()
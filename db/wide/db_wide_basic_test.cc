@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "db/db_test_util.h"
+#include "db/wide/wide_column_serialization.h"
 #include "port/stack_trace.h"
 #include "test_util/testutil.h"
 #include "utilities/merge_operators.h"
@@ -189,6 +190,300 @@ TEST_F(DBWideBasicTest, PutEntity) {
   verify();
 }
 
+TEST_F(DBWideBasicTest, PutEntityBlobColumns) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 16;
+  options.enable_wide_column_blob_files = true;
+  options.disable_auto_compactions = true;
+
+  Reopen(options);
+
+  // Column values of at least min_blob_size get stored in blob files, smaller
+  // ones stay inline
+  constexpr char first_key[] = "first";
+  const std::string first_value_of_default_column(100, 'a');
+  const std::string first_large_attr(200, 'b');
+  WideColumns first_columns{
+      {kDefaultWideColumnName, first_value_of_default_column},
+      {"attr_name1", "foo"},
+      {"attr_name2", first_large_attr}};
+
+  constexpr char second_key[] = "second";
+  const std::string second_large_attr(300, 'c');
+  WideColumns second_columns{{"attr_one", second_large_attr},
+                             {"attr_three", "four"}};
+
+  auto verify = [&]() {
+    {
+      PinnableSlice result;
+      ASSERT_OK(db_->Get(ReadOptions(), db_->DefaultColumnFamily(), first_key,
+                         &result));
+      ASSERT_EQ(result, first_value_of_default_column);
+    }
+
+    {
+      PinnableWideColumns result;
+      ASSERT_OK(db_->GetEntity(ReadOptions(), db_->DefaultColumnFamily(),
+                               first_key, &result));
+      ASSERT_EQ(result.columns(), first_columns);
+    }
+
+    {
+      PinnableSlice result;
+      ASSERT_OK(db_->Get(ReadOptions(), db_->DefaultColumnFamily(), second_key,
+                         &result));
+      ASSERT_TRUE(result.empty());
+    }
+
+    {
+      PinnableWideColumns result;
+      ASSERT_OK(db_->GetEntity(ReadOptions(), db_->DefaultColumnFamily(),
+                               second_key, &result));
+      ASSERT_EQ(result.columns(), second_columns);
+    }
+
+    {
+      constexpr size_t num_keys = 2;
+
+      std::array<Slice, num_keys> keys{{first_key, second_key}};
+      std::array<PinnableSlice, num_keys> values;
+      std::array<Status, num_keys> statuses;
+
+      db_->MultiGet(ReadOptions(), db_->DefaultColumnFamily(), num_keys,
+                    &keys[0], &values[0], &statuses[0]);
+
+      ASSERT_OK(statuses[0]);
+      ASSERT_EQ(values[0], first_value_of_default_column);
+
+      ASSERT_OK(statuses[1]);
+      ASSERT_TRUE(values[1].empty());
+    }
+
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+
+      iter->SeekToFirst();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(iter->key(), first_key);
+      ASSERT_EQ(iter->value(), first_value_of_default_column);
+      ASSERT_EQ(iter->columns(), first_columns);
+
+      iter->Next();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(iter->key(), second_key);
+      ASSERT_TRUE(iter->value().empty());
+      ASSERT_EQ(iter->columns(), second_columns);
+
+      iter->Next();
+      ASSERT_FALSE(iter->Valid());
+      ASSERT_OK(iter->status());
+
+      iter->SeekToLast();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(iter->key(), second_key);
+      ASSERT_EQ(iter->columns(), second_columns);
+
+      iter->Prev();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(iter->key(), first_key);
+      ASSERT_EQ(iter->value(), first_value_of_default_column);
+      ASSERT_EQ(iter->columns(), first_columns);
+
+      iter->Prev();
+      ASSERT_FALSE(iter->Valid());
+      ASSERT_OK(iter->status());
+    }
+  };
+
+  ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                           first_key, first_columns));
+  ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                           second_key, second_columns));
+
+  // Flushing extracts the three large column values to a blob file
+  ASSERT_OK(Flush());
+
+  const std::vector<uint64_t> original_blob_files = GetBlobFileNumbers();
+  ASSERT_EQ(original_blob_files.size(), 1);
+
+  {
+    const auto& blob_files = dbfull()
+                                 ->GetVersionSet()
+                                 ->GetColumnFamilySet()
+                                 ->GetDefault()
+                                 ->current()
+                                 ->storage_info()
+                                 ->GetBlobFiles();
+    ASSERT_EQ(blob_files.size(), 1);
+    ASSERT_EQ(blob_files.front()->GetTotalBlobCount(), 3);
+    ASSERT_EQ(blob_files.front()->GetLinkedSsts().size(), 1);
+  }
+
+  verify();
+
+  // Garbage collection relocates the column values to a new blob file, and
+  // the original one becomes obsolete
+  ASSERT_OK(db_->SetOptions({{"enable_blob_garbage_collection", "true"},
+                             {"blob_garbage_collection_age_cutoff", "1.0"}}));
+
+  // The single table file would otherwise just be moved down
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  constexpr Slice* begin = nullptr;
+  constexpr Slice* end = nullptr;
+  ASSERT_OK(db_->CompactRange(cro, begin, end));
+
+  const std::vector<uint64_t> new_blob_files = GetBlobFileNumbers();
+  ASSERT_EQ(new_blob_files.size(), 1);
+  ASSERT_NE(new_blob_files[0], original_blob_files[0]);
+
+  verify();
+
+  // Without blob files, relocated column values get inlined
+  ASSERT_OK(db_->SetOptions({{"enable_blob_files", "false"}}));
+  ASSERT_OK(db_->CompactRange(cro, begin, end));
+
+  ASSERT_TRUE(GetBlobFileNumbers().empty());
+
+  verify();
+}
+
+TEST_F(DBWideBasicTest, IteratorFetchesColumnBlobsLazily) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 16;
+  options.enable_wide_column_blob_files = true;
+  options.disable_auto_compactions = true;
+
+  Reopen(options);
+
+  const std::string value_of_default_column(100, 'a');
+  const std::string large_attr(200, 'b');
+  WideColumns columns{{kDefaultWideColumnName, value_of_default_column},
+                      {"attr_name1", large_attr},
+                      {"attr_name2", large_attr}};
+  ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(), "key",
+                           columns));
+  ASSERT_OK(Flush());
+
+  int num_blob_reads = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "BlobFileReader::GetBlob:ReadFromFile",
+      [&](void* /* arg */) { ++num_blob_reads; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  {
+    // Only the value of the default column is read for value()
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    iter->SeekToFirst();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(iter->value(), value_of_default_column);
+    ASSERT_EQ(num_blob_reads, 1);
+
+    // The other columns are read by the first columns() call
+    ASSERT_EQ(iter->columns(), columns);
+    ASSERT_EQ(num_blob_reads, 3);
+    ASSERT_EQ(iter->columns(), columns);
+    ASSERT_EQ(iter->value(), value_of_default_column);
+    ASSERT_EQ(num_blob_reads, 3);
+
+    iter->Next();
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST_F(DBWideBasicTest, PutEntityBlobColumnsOptIn) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 16;
+  options.disable_auto_compactions = true;
+
+  Reopen(options);
+
+  constexpr char entity_key[] = "entity";
+  const std::string large_attr(200, 'a');
+  WideColumns columns{{"attr_name1", "foo"}, {"attr_name2", large_attr}};
+
+  constexpr char plain_key[] = "plain";
+  const std::string plain_value(100, 'b');
+
+  ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                           entity_key, columns));
+  ASSERT_OK(Put(plain_key, plain_value));
+
+  auto get_entity_serialization = [&]() {
+    Arena arena;
+    ScopedArenaIterator iter(dbfull()->NewInternalIterator(
+        ReadOptions(), &arena, kMaxSequenceNumber));
+    iter->SeekToFirst();
+    EXPECT_TRUE(iter->Valid());
+    ParsedInternalKey ikey;
+    EXPECT_OK(ParseInternalKey(iter->key(), &ikey, true /* log_err_key */));
+    EXPECT_EQ(ikey.user_key, entity_key);
+    EXPECT_EQ(ikey.type, kTypeWideColumnEntity);
+    return iter->value().ToString();
+  };
+
+  auto verify = [&]() {
+    PinnableWideColumns result;
+    ASSERT_OK(db_->GetEntity(ReadOptions(), db_->DefaultColumnFamily(),
+                             entity_key, &result));
+    ASSERT_EQ(result.columns(), columns);
+    ASSERT_EQ(Get(plain_key), plain_value);
+  };
+
+  // By default only plain values are stored in blob files, and entities keep
+  // the serialization format older releases can read
+  ASSERT_OK(Flush());
+
+  {
+    const auto& blob_files = dbfull()
+                                 ->GetVersionSet()
+                                 ->GetColumnFamilySet()
+                                 ->GetDefault()
+                                 ->current()
+                                 ->storage_info()
+                                 ->GetBlobFiles();
+    ASSERT_EQ(blob_files.size(), 1);
+    ASSERT_EQ(blob_files.front()->GetTotalBlobCount(), 1);
+  }
+
+  {
+    const std::string entity = get_entity_serialization();
+    ASSERT_FALSE(WideColumnSerialization::HasBlobIndices(entity));
+    Slice input(entity);
+    uint32_t version = 0;
+    ASSERT_TRUE(GetVarint32(&input, &version));
+    ASSERT_EQ(version, WideColumnSerialization::kCurrentVersion);
+  }
+
+  verify();
+
+  // Once enabled, compactions separate the large column value too
+  ASSERT_OK(db_->SetOptions({{"enable_wide_column_blob_files", "true"}}));
+
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  constexpr Slice* begin = nullptr;
+  constexpr Slice* end = nullptr;
+  ASSERT_OK(db_->CompactRange(cro, begin, end));
+
+  ASSERT_TRUE(
+      WideColumnSerialization::HasBlobIndices(get_entity_serialization()));
+
+  verify();
+}
+
 TEST_F(DBWideBasicTest, PutEntityColumnFamily) {
   Options options = GetDefaultOptions();
   CreateAndReopenWithCF({"corinthian"}, options);
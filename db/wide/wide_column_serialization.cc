@@ -15,9 +15,9 @@
 
 namespace ROCKSDB_NAMESPACE {
 
-Status WideColumnSerialization::SerializeImpl(const Slice* value_of_default,
-                                              const WideColumns& columns,
-                                              std::string& output) {
+Status WideColumnSerialization::SerializeImpl(
+    const Slice* value_of_default, const WideColumns& columns,
+    const std::vector<ColumnValueType>* value_types, std::string& output) {
   const size_t num_columns =
       value_of_default ? columns.size() + 1 : columns.size();
 
@@ -25,7 +25,21 @@ Status WideColumnSerialization::SerializeImpl(const Slice* value_of_default,
     return Status::InvalidArgument("Too many wide columns");
   }
 
-  PutVarint32(&output, kCurrentVersion);
+  assert(!value_of_default || !value_types);
+
+  if (value_types) {
+    if (value_types->size() != columns.size()) {
+      return Status::InvalidArgument(
+          "Mismatched number of wide column value types");
+    }
+
+    if (std::find(value_types->begin(), value_types->end(),
+                  kColumnBlobIndex) == value_types->end()) {
+      value_types = nullptr;
+    }
+  }
+
+  PutVarint32(&output, value_types ? kVersionWithBlobIndices : kCurrentVersion);
 
   PutVarint32(&output, static_cast<uint32_t>(num_columns));
 
@@ -62,6 +76,9 @@ Status WideColumnSerialization::SerializeImpl(const Slice* value_of_default,
     }
 
     PutLengthPrefixedSlice(&output, name);
+    if (value_types) {
+      output.push_back(static_cast<char>((*value_types)[i]));
+    }
     PutVarint32(&output, static_cast<uint32_t>(value.size()));
 
     prev_name = &name;
@@ -80,19 +97,35 @@ Status WideColumnSerialization::SerializeImpl(const Slice* value_of_default,
   return Status::OK();
 }
 
-Status WideColumnSerialization::Deserialize(Slice& input,
-                                            WideColumns& columns) {
+Status WideColumnSerialization::SerializeWithBlobIndices(
+    const WideColumns& columns, const std::vector<ColumnValueType>& value_types,
+    std::string& output) {
+  constexpr Slice* value_of_default = nullptr;
+
+  return SerializeImpl(value_of_default, columns, &value_types, output);
+}
+
+Status WideColumnSerialization::DeserializeImpl(
+    Slice& input, WideColumns& columns,
+    std::vector<ColumnValueType>* value_types) {
   assert(columns.empty());
+  assert(!value_types || value_types->empty());
 
   uint32_t version = 0;
   if (!GetVarint32(&input, &version)) {
     return Status::Corruption("Error decoding wide column version");
   }
 
-  if (version > kCurrentVersion) {
+  if (version > kVersionWithBlobIndices) {
     return Status::NotSupported("Unsupported wide column version");
   }
 
+  const bool has_value_types = version == kVersionWithBlobIndices;
+  if (has_value_types && !value_types) {
+    return Status::NotSupported(
+        "Wide column values stored in blob files not supported");
+  }
+
   uint32_t num_columns = 0;
   if (!GetVarint32(&input, &num_columns)) {
     return Status::Corruption("Error decoding number of wide columns");
@@ -103,6 +136,9 @@ Status WideColumnSerialization::Deserialize(Slice& input,
   }
 
   columns.reserve(num_columns);
+  if (value_types) {
+    value_types->reserve(num_columns);
+  }
 
   autovector<uint32_t, 16> column_value_sizes;
   column_value_sizes.reserve(num_columns);
@@ -119,6 +155,25 @@ Status WideColumnSerialization::Deserialize(Slice& input,
 
     columns.emplace_back(name, Slice());
 
+    if (value_types) {
+      ColumnValueType value_type = kColumnValue;
+
+      if (has_value_types) {
+        if (input.empty()) {
+          return Status::Corruption("Error decoding wide column value type");
+        }
+
+        value_type = static_cast<ColumnValueType>(input[0]);
+        if (value_type != kColumnValue && value_type != kColumnBlobIndex) {
+          return Status::Corruption("Unknown wide column value type");
+        }
+
+        input.remove_prefix(1);
+      }
+
+      value_types->emplace_back(value_type);
+    }
+
     uint32_t value_size = 0;
     if (!GetVarint32(&input, &value_size)) {
       return Status::Corruption("Error decoding wide column value size");
@@ -145,6 +200,15 @@ Status WideColumnSerialization::Deserialize(Slice& input,
   return Status::OK();
 }
 
+bool WideColumnSerialization::HasBlobIndices(const Slice& input) {
+  Slice input_copy = input;
+
+  uint32_t version = 0;
+
+  return GetVarint32(&input_copy, &version) &&
+         version == kVersionWithBlobIndices;
+}
+
 WideColumns::const_iterator WideColumnSerialization::Find(
     const WideColumns& columns, const Slice& column_name) {
   const auto it =
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/status.h"
@@ -40,38 +41,84 @@ class Slice;
 //          ...---+----------+-------+----------+-------+---...---+-------+
 //                | varint32 | bytes | varint32 | bytes |         | bytes |
 //          ...---+----------+-------+----------+-------+---...---+-------+
+//
+// Entities written by flushes and compactions that store some of their column
+// values in blob files use version 2 of the layout (see
+// SerializeWithBlobIndices()), which has a one byte column value type between
+// the name and the value size of each column in the index. The value of a
+// column of type kColumnBlobIndex is an encoded BlobIndex. Such entities only
+// ever appear in SST files, and readers fetch the values of the columns they
+// need from the blob files. As older releases cannot read version 2, it is
+// only written with the column family option enable_wide_column_blob_files.
 
 class WideColumnSerialization {
  public:
+  enum ColumnValueType : unsigned char {
+    kColumnValue = 0x0,
+    kColumnBlobIndex = 0x1,
+  };
+
   static Status Serialize(const WideColumns& columns, std::string& output);
   static Status Serialize(const Slice& value_of_default,
                           const WideColumns& other_columns,
                           std::string& output);
+  // Serializes `columns`, the values of which are encoded BlobIndexes where
+  // the corresponding entry of `value_types` is kColumnBlobIndex. Uses
+  // version 1 of the layout if none of them are.
+  static Status SerializeWithBlobIndices(
+      const WideColumns& columns,
+      const std::vector<ColumnValueType>& value_types, std::string& output);
 
+  // Returns NotSupported for entities referencing values in blob files
   static Status Deserialize(Slice& input, WideColumns& columns);
+  static Status DeserializeWithBlobIndices(
+      Slice& input, WideColumns& columns,
+      std::vector<ColumnValueType>& value_types);
+  static bool HasBlobIndices(const Slice& input);
 
   static WideColumns::const_iterator Find(const WideColumns& columns,
                                           const Slice& column_name);
   static Status GetValueOfDefaultColumn(Slice& input, Slice& value);
 
   static constexpr uint32_t kCurrentVersion = 1;
+  static constexpr uint32_t kVersionWithBlobIndices = 2;
 
  private:
   static Status SerializeImpl(const Slice* value_of_default,
-                              const WideColumns& columns, std::string& output);
+                              const WideColumns& columns,
+                              const std::vector<ColumnValueType>* value_types,
+                              std::string& output);
+  static Status DeserializeImpl(Slice& input, WideColumns& columns,
+                                std::vector<ColumnValueType>* value_types);
 };
 
 inline Status WideColumnSerialization::Serialize(const WideColumns& columns,
                                                  std::string& output) {
   constexpr Slice* value_of_default = nullptr;
+  constexpr std::vector<ColumnValueType>* value_types = nullptr;
 
-  return SerializeImpl(value_of_default, columns, output);
+  return SerializeImpl(value_of_default, columns, value_types, output);
 }
 
 inline Status WideColumnSerialization::Serialize(
     const Slice& value_of_default, const WideColumns& other_columns,
     std::string& output) {
-  return SerializeImpl(&value_of_default, other_columns, output);
+  constexpr std::vector<ColumnValueType>* value_types = nullptr;
+
+  return SerializeImpl(&value_of_default, other_columns, value_types, output);
+}
+
+inline Status WideColumnSerialization::Deserialize(Slice& input,
+                                                   WideColumns& columns) {
+  constexpr std::vector<ColumnValueType>* value_types = nullptr;
+
+  return DeserializeImpl(input, columns, value_types);
+}
+
+inline Status WideColumnSerialization::DeserializeWithBlobIndices(
+    Slice& input, WideColumns& columns,
+    std::vector<ColumnValueType>& value_types) {
+  return DeserializeImpl(input, columns, &value_types);
 }
 
 }  // namespace ROCKSDB_NAMESPACE
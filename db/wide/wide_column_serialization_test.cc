@@ -143,6 +143,118 @@ TEST(WideColumnSerializationTest, SerializeWithPrepend) {
   ASSERT_EQ(deserialized_columns, expected_columns);
 }
 
+TEST(WideColumnSerializationTest, SerializeDeserializeWithBlobIndices) {
+  WideColumns columns{{"foo", "bar"}, {"hello", "blob_index"}};
+
+  {
+    // No blob indices, same as Serialize()
+    const std::vector<WideColumnSerialization::ColumnValueType> value_types{
+        WideColumnSerialization::kColumnValue,
+        WideColumnSerialization::kColumnValue};
+
+    std::string output;
+    ASSERT_OK(WideColumnSerialization::SerializeWithBlobIndices(
+        columns, value_types, output));
+    ASSERT_FALSE(WideColumnSerialization::HasBlobIndices(output));
+
+    std::string expected_output;
+    ASSERT_OK(WideColumnSerialization::Serialize(columns, expected_output));
+    ASSERT_EQ(output, expected_output);
+
+    Slice input(output);
+    WideColumns deserialized_columns;
+    std::vector<WideColumnSerialization::ColumnValueType>
+        deserialized_value_types;
+
+    ASSERT_OK(WideColumnSerialization::DeserializeWithBlobIndices(
+        input, deserialized_columns, deserialized_value_types));
+    ASSERT_EQ(columns, deserialized_columns);
+    ASSERT_EQ(value_types, deserialized_value_types);
+  }
+
+  {
+    const std::vector<WideColumnSerialization::ColumnValueType> value_types{
+        WideColumnSerialization::kColumnValue,
+        WideColumnSerialization::kColumnBlobIndex};
+
+    std::string output;
+    ASSERT_OK(WideColumnSerialization::SerializeWithBlobIndices(
+        columns, value_types, output));
+    ASSERT_TRUE(WideColumnSerialization::HasBlobIndices(output));
+
+    {
+      Slice input(output);
+      WideColumns deserialized_columns;
+      std::vector<WideColumnSerialization::ColumnValueType>
+          deserialized_value_types;
+
+      ASSERT_OK(WideColumnSerialization::DeserializeWithBlobIndices(
+          input, deserialized_columns, deserialized_value_types));
+      ASSERT_EQ(columns, deserialized_columns);
+      ASSERT_EQ(value_types, deserialized_value_types);
+    }
+
+    // Readers not prepared to fetch values from blob files get an error
+    {
+      Slice input(output);
+      WideColumns deserialized_columns;
+
+      const Status s =
+          WideColumnSerialization::Deserialize(input, deserialized_columns);
+      ASSERT_TRUE(s.IsNotSupported());
+      ASSERT_TRUE(std::strstr(s.getState(), "blob"));
+    }
+  }
+
+  {
+    const std::vector<WideColumnSerialization::ColumnValueType> value_types{
+        WideColumnSerialization::kColumnValue};
+
+    std::string output;
+    ASSERT_TRUE(WideColumnSerialization::SerializeWithBlobIndices(
+                    columns, value_types, output)
+                    .IsInvalidArgument());
+  }
+}
+
+TEST(WideColumnSerializationTest, DeserializeUnknownValueType) {
+  std::string buf;
+
+  PutVarint32(&buf, WideColumnSerialization::kVersionWithBlobIndices);
+
+  constexpr uint32_t num_columns = 1;
+  PutVarint32(&buf, num_columns);
+
+  constexpr char column_name[] = "foo";
+  PutLengthPrefixedSlice(&buf, column_name);
+
+  // Can't decode the value type
+  {
+    Slice input(buf);
+    WideColumns columns;
+    std::vector<WideColumnSerialization::ColumnValueType> value_types;
+
+    const Status s = WideColumnSerialization::DeserializeWithBlobIndices(
+        input, columns, value_types);
+    ASSERT_TRUE(s.IsCorruption());
+    ASSERT_TRUE(std::strstr(s.getState(), "value type"));
+  }
+
+  constexpr char unknown_value_type = 0x7f;
+  buf.push_back(unknown_value_type);
+
+  {
+    Slice input(buf);
+    WideColumns columns;
+    std::vector<WideColumnSerialization::ColumnValueType> value_types;
+
+    const Status s = WideColumnSerialization::DeserializeWithBlobIndices(
+        input, columns, value_types);
+    ASSERT_TRUE(s.IsCorruption());
+    ASSERT_TRUE(std::strstr(s.getState(), "value type"));
+  }
+}
+
 TEST(WideColumnSerializationTest, SerializeDuplicateError) {
   WideColumns columns{{"foo", "bar"}, {"foo", "baz"}};
   std::string output;
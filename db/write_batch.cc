@@ -2451,15 +2451,35 @@ class MemTableInserter : public WriteBatch::Handler {
           "Merge requires `ColumnFamilyOptions::merge_operator != nullptr`");
     }
     bool perform_merge = false;
+    bool merged_in_place = false;
     assert(!concurrent_memtable_writes_ ||
            moptions->max_successive_merges == 0);
 
+    if (moptions->inplace_update_support && moptions->inplace_merge_support) {
+      assert(!concurrent_memtable_writes_);
+      if (kv_prot_info != nullptr) {
+        auto mem_kv_prot_info =
+            kv_prot_info->StripC(column_family_id).ProtectS(sequence_);
+        ret_status =
+            mem->MergeInPlace(sequence_, key, value, &mem_kv_prot_info);
+      } else {
+        ret_status = mem->MergeInPlace(sequence_, key, value,
+                                       nullptr /* kv_prot_info */);
+      }
+      if (ret_status.IsNotFound()) {
+        // Nothing to fold the operand into, so add it as usual
+        ret_status = Status::OK();
+      } else {
+        merged_in_place = true;
+      }
+    }
+
     // If we pass DB through and options.max_successive_merges is hit
     // during recovery, Get() will be issued which will try to acquire
     // DB mutex and cause deadlock, as DB mutex is already held.
     // So we disable merge in recovery
-    if (moptions->max_successive_merges > 0 && db_ != nullptr &&
-        recovering_log_number_ == 0) {
+    if (!merged_in_place && moptions->max_successive_merges > 0 &&
+        db_ != nullptr && recovering_log_number_ == 0) {
       assert(!concurrent_memtable_writes_);
       LookupKey lkey(key, sequence_);
 
@@ -2527,7 +2547,7 @@ class MemTableInserter : public WriteBatch::Handler {
       }
     }
 
-    if (!perform_merge) {
+    if (!perform_merge && !merged_in_place) {
       assert(ret_status.ok());
       // Add merge operand to memtable
       if (kv_prot_info != nullptr) {
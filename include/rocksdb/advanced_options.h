@@ -347,6 +347,19 @@ struct AdvancedColumnFamilyOptions {
   // Default: false.
   bool inplace_update_support = false;
 
+  // If true together with inplace_update_support, Merge(key, operand) folds
+  // the operand into the newest entry of the key in the current memtable in
+  // place, instead of adding another entry, when that entry is
+  //   * a merge operand, and MergeOperator::PartialMerge() combines the two
+  //     into an operand no larger than the existing one, or
+  //   * a put, and merging the operand into it gives a value no larger than
+  //     the existing one.
+  // This keeps the memtable from accumulating long chains of operands, e.g.
+  // for counters with an associative merge operator such as "uint64add",
+  // which reads would otherwise have to merge every time.
+  // Default: false.
+  bool inplace_merge_support = false;
+
   // Number of locks used for inplace update
   // Default: 10000, if inplace_update_support = true, else 0.
   //
@@ -1029,6 +1042,26 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API
   double blob_garbage_collection_force_threshold = 1.0;
 
+  // Garbage collects blob files by their own ratio of garbage rather than by
+  // age. Blobs in any blob file whose ratio of garbage is at least this
+  // threshold are relocated when encountered during compaction, regardless
+  // of blob_garbage_collection_age_cutoff. Also, unless the oldest blob
+  // files are already being forced through
+  // blob_garbage_collection_force_threshold, targeted compactions are
+  // scheduled for the SSTs whose oldest referenced blob file has the highest
+  // ratio of garbage, if it is at least this threshold. This keeps the space
+  // amplification of the blob files at roughly 1 / (1 - threshold) without
+  // rewriting old blob files that have little garbage. Scheduling the
+  // targeted compactions is currently only supported with leveled
+  // compactions.
+  // Note that enable_blob_garbage_collection has to be set in order for this
+  // option to have any effect. 1.0 disables it.
+  //
+  // Default: 1.0
+  //
+  // Dynamically changeable through the SetOptions() API
+  double blob_garbage_collection_file_ratio_threshold = 1.0;
+
   // Compaction readahead for blob files.
   //
   // Default: 0
@@ -1051,6 +1084,22 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API
   int blob_file_starting_level = 0;
 
+  // If true, flushes and compactions that write blob files also separate the
+  // column values of wide-column entities (see PutEntity()) that are at least
+  // min_blob_size, one blob per column. An entity with any column value in a
+  // blob file is written in a newer serialization format, which releases
+  // older than the one that introduced this option cannot read. Downgrading
+  // a DB that has been written with this option is therefore not supported.
+  // Entities whose column values were separated are still read and garbage
+  // collected after the option is turned off.
+  // Note that enable_blob_files has to be set in order for this option to
+  // have any effect.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through the SetOptions() API
+  bool enable_wide_column_blob_files = false;
+
   // The Cache object to use for blobs. Using a dedicated object for blobs and
   // using the same object for the block and blob caches are both supported. In
   // the latter case, note that blobs are less valuable from a caching
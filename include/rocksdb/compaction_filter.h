@@ -21,6 +21,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Slice;
 class SliceTransform;
+struct TableProperties;
 
 // CompactionFilter allows an application to modify/delete a key-value during
 // table file creation.
@@ -249,6 +250,28 @@ class CompactionFilterFactory : public Customizable {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Returns whether `ShouldDropTableFile()` should be asked about the table
+  // files of the column family. Every file is checked, with the DB mutex
+  // held, whenever a new version of the LSM tree is installed, so factories
+  // that cannot tell anything from the table properties should leave this
+  // false.
+  virtual bool SupportsDroppingTableFiles() const { return false; }
+
+  // Returns whether the filters created by this factory would remove every
+  // entry of the table file with properties `props`, for example because the
+  // entries have all expired. With leveled compaction, such files are
+  // deleted without being read, in deletion-only compactions picked ahead of
+  // any other compaction, unless a live snapshot can see their entries or an
+  // older file, in L0 or a lower level, overlaps their key range, as
+  // dropping them would make older versions of their keys visible again.
+  // Only called if `SupportsDroppingTableFiles()` returns true and
+  // `ShouldFilterTableFileCreation()` returns true for compactions, for files
+  // without point or range deletions and without blob references whose
+  // table reader is open.
+  virtual bool ShouldDropTableFile(const TableProperties& /*props*/) const {
+    return false;
+  }
+
   // Returns a name that identifies this `CompactionFilter` factory.
   virtual const char* Name() const override = 0;
 };
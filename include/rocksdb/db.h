@@ -891,6 +891,16 @@ class DB {
     //      level, as well as the histogram of latency of single requests.
     static const std::string kCFFileHistogram;
 
+    //  "rocksdb.compaction-forecast" - returns a multi-line string or map
+    //      with an online estimate of the column family's compaction load:
+    //      ingest and compaction throughput over the last minute or two
+    //      (since the newest flush, compaction or query of the property at
+    //      least a minute old, so longer when none happened in between),
+    //      measured and predicted write amplification, the time needed to
+    //      clear pending compaction bytes, and the time until the pending
+    //      compaction bytes limits are reached at the current ingest rate.
+    static const std::string kCompactionForecast;
+
     //  "rocksdb.dbstats" - As a string property, returns a multi-line string
     //      with general database stats, both cumulative (over the db's
     //      lifetime) and interval (since the last retrieval of kDBStats).
@@ -912,6 +922,13 @@ class DB {
     //      stale values more frequently to reduce overhead and latency.
     static const std::string kFastBlockCacheEntryStats;
 
+    //  "rocksdb.block-cache-miss-ratio-curve" - returns a multi-line string
+    //      or map with the miss ratio curve estimated by the block cache, if
+    //      it was created by NewMissRatioCurveCache(). The map form has keys
+    //      "sampling_rate", "sampled_lookups" and "miss_ratio.<capacity>" for
+    //      each configured capacity in bytes.
+    static const std::string kBlockCacheMissRatioCurve;
+
     //  "rocksdb.num-immutable-mem-table" - returns number of immutable
     //      memtables that have not yet been flushed.
     static const std::string kNumImmutableMemTable;
@@ -1114,6 +1131,15 @@ class DB {
     // "rocksdb.blob-cache-pinned-usage" - returns the memory size for the
     //      entries being pinned in blob cache.
     static const std::string kBlobCachePinnedUsage;
+
+    // "rocksdb.live-user-operations" - returns a multi-line string with one
+    //      line per user operation in flight, oldest first: Get(),
+    //      MultiGet() (per column family), live iterators,
+    //      IngestExternalFile() and WAL syncs. Each line shows the column
+    //      family, the elapsed time, the current stage, and the blocks and
+    //      bytes read from SST files so far. Only available with
+    //      `enable_thread_tracking`.
+    static const std::string kLiveUserOperations;
   };
 #endif /* ROCKSDB_LITE */
 
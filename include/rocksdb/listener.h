@@ -151,6 +151,10 @@ enum class CompactionReason : int {
   // A special TTL compaction for RoundRobin policy, which basically the same as
   // kLevelMaxLevelSize, but the goal is to compact TTLed files.
   kRoundRobinTtl,
+  // [Level] Deletion-only compaction of files whose entries would all be
+  // removed by the compaction filter, see
+  // CompactionFilterFactory::ShouldDropTableFile()
+  kDroppableFiles,
   // total number of compaction reasons, new reasons must be added above this.
   kNumOfReasons,
 };
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include "rocksdb/customizable.h"
@@ -78,4 +79,73 @@ extern Status NewJemallocNodumpAllocator(
     JemallocAllocatorOptions& options,
     std::shared_ptr<MemoryAllocator>* memory_allocator);
 
+struct HugePageSlabAllocatorOptions {
+  static const char* kName() { return "HugePageSlabAllocatorOptions"; }
+  // Total bytes of memory the allocator reserves up front and serves size
+  // class allocations from. Allocations that do not fit any more fall back
+  // to the default allocator. It is rounded up to a multiple of slab_size,
+  // and is recommended to be a bit more than the block cache capacity.
+  size_t capacity = 256 << 20;
+
+  // The reserved memory is handed out to size classes in slabs of this many
+  // bytes. It should be a multiple of the huge page size, e.g. 2 MB, or 1 GB
+  // when the system default huge page size is 1 GB.
+  size_t slab_size = 2 << 20;
+
+  // Whether to back the reserved memory with huge pages (MAP_HUGETLB). If
+  // that fails, e.g. because no huge pages are reserved in the system, normal
+  // pages are used instead, advising the kernel to back them with transparent
+  // huge pages where supported.
+  bool use_huge_pages = true;
+
+  // Allocation sizes up to max_size_class are rounded up to a size class and
+  // served from the reserved memory. The size classes start at
+  // min_size_class and are spaced size_classes_per_doubling per power of
+  // two, so with the defaults a 4 KB block that is a little over its target
+  // size is rounded up by at most 1/8.
+  size_t min_size_class = 512;
+  size_t max_size_class = 256 << 10;
+  int size_classes_per_doubling = 8;
+
+  // If non-negative and RocksDB is built with NUMA support, binds the
+  // reserved memory to this NUMA node.
+  int numa_node = -1;
+};
+
+// Statistics of a HugePageSlabAllocator, for judging how well the size
+// classes fit the allocations
+struct HugePageSlabAllocatorStats {
+  // Bytes of memory reserved by the allocator
+  uint64_t reserved_bytes = 0;
+  // Whether the reserved memory is backed by huge pages (MAP_HUGETLB)
+  bool huge_pages = false;
+  // Bytes of the reserved memory in slabs handed out to size classes
+  uint64_t slab_bytes = 0;
+  // Bytes of size class allocations currently live
+  uint64_t allocated_bytes = 0;
+  // Bytes of slabs not currently allocated: 1 - allocated_bytes / slab_bytes
+  // is the fragmentation of the memory handed out to size classes
+  uint64_t free_bytes = 0;
+  // Number of size class allocations currently live
+  uint64_t num_allocations = 0;
+  // Number of allocations served by the default allocator so far, either
+  // because they were too large or the reserved memory was exhausted
+  uint64_t num_fallback_allocations = 0;
+};
+
+// Generate a memory allocator that serves block cache sized allocations
+// from slabs of memory reserved up front, backed by huge pages where
+// possible, to reduce TLB misses when accessing a large block cache.
+// Allocations are rounded up to size classes, each with its own slabs and
+// free list; memory once handed out to a size class is not returned to the
+// other size classes or the system until the allocator is destroyed.
+extern Status NewHugePageSlabAllocator(
+    const HugePageSlabAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator);
+
+// Fills in `stats` if `allocator` was created by NewHugePageSlabAllocator(),
+// or returns Status::InvalidArgument() otherwise.
+extern Status GetHugePageSlabAllocatorStats(
+    const MemoryAllocator* allocator, HugePageSlabAllocatorStats* stats);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -606,6 +606,8 @@ struct DBOptions {
 
   // If max_open_files is -1, DB will open all files on DB::Open(). You can
   // use this option to increase the number of threads used to open the files.
+  // It also bounds the number of threads used to open and verify the files
+  // passed to a single IngestExternalFile() call.
   // Default: 16
   int max_file_opening_threads = 16;
 
@@ -1029,7 +1031,9 @@ struct DBOptions {
   std::vector<std::shared_ptr<EventListener>> listeners;
 
   // If true, then the status of the threads involved in this DB will
-  // be tracked and available via GetThreadList() API.
+  // be tracked and available via GetThreadList() API. The user operations in
+  // flight are tracked as well and available via the
+  // DB::Properties::kLiveUserOperations property.
   //
   // Default: false
   bool enable_thread_tracking = false;
@@ -1394,6 +1398,44 @@ struct DBOptions {
   // of the contract leads to undefined behaviors with high possibility of data
   // inconsistency, e.g. deleted old data become visible again, etc.
   bool enforce_single_del_contracts = true;
+
+  // If non-zero and `statistics` is set, one in this many Get() calls
+  // (including GetEntity() and GetMergeOperands()) is timed stage by stage, as
+  // if PerfLevel::kEnableTimeExceptForMutex were set for that call, and the
+  // stage timings are recorded in the SAMPLED_GET_* histograms. This gives a
+  // latency breakdown of the read path at a small fraction of the cost of
+  // timing every call through PerfContext. Calls made while the thread already
+  // has timing enabled are not sampled. The PerfContext of the calling thread
+  // also accumulates the counters and timings of sampled calls. Values above
+  // INT32_MAX are treated as INT32_MAX.
+  //
+  // Default: 0 (disabled)
+  uint32_t stats_get_breakdown_one_in = 0;
+
+  // If true, writes delayed because of too many L0 files or too many pending
+  // compaction bytes are slowed down to a rate derived from how far the
+  // column family is past its slowdown threshold towards its stop threshold,
+  // scaled from the ingest rate that the measured compaction throughput can
+  // sustain. The rate then tracks the compaction debt smoothly instead of being
+  // cut by a fixed ratio whenever the debt fails to shrink between two
+  // flushes or compactions, which makes throughput oscillate and often runs
+  // into the stop threshold anyway. Delays because of too many memtables are
+  // not affected. Requires `delayed_write_rate` to be at least 16KB/s.
+  //
+  // Default: false
+  bool smooth_write_delay = false;
+
+  // If true, opening a fully compacted DB with DB::OpenForReadOnly() and
+  // max_open_files = -1 builds an in-memory hash index from every user key to
+  // the table file holding it, by reading all the files with up to
+  // max_file_opening_threads threads. Get() and MultiGet() then find the file
+  // of a key with one hash probe instead of a binary search over the files,
+  // return NotFound for keys not in the index without reading any table file,
+  // and skip the filter of the file holding a key. The index takes about 16
+  // bytes of memory per key. Not used with user-defined timestamps.
+  //
+  // Default: false
+  bool compacted_db_point_index = false;
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
@@ -1700,6 +1742,17 @@ struct ReadOptions {
   // Default: true
   bool optimize_multiget_for_io;
 
+  // If true, the batched MultiGet() APIs taking PinnableSlice values return
+  // values found in memtables pinned in place instead of copying them, like
+  // they do for values in block cache or blob cache. Such values then keep
+  // the memtables (and the rest of the read view they were read from) alive
+  // until they are Reset() or destroyed, so they should not be held for
+  // long. Has no effect with `inplace_update_support`, and on values
+  // produced by merges.
+  //
+  // Default: false
+  bool pin_memtable_values;
+
   ReadOptions();
   ReadOptions(bool cksum, bool cache);
 };
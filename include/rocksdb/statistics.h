@@ -448,6 +448,12 @@ enum Tickers : uint32_t {
   // # of bytes written into blob cache.
   BLOB_DB_CACHE_BYTES_WRITE,
 
+  // # of WAL records a secondary instance applied to its memtables.
+  SECONDARY_WAL_RECORDS_APPLIED,
+
+  // # of bytes of WAL records a secondary instance applied to its memtables.
+  SECONDARY_WAL_BYTES_APPLIED,
+
   TICKER_ENUM_MAX
 };
 
@@ -568,6 +574,22 @@ enum Histograms : uint32_t {
   // Wait time for aborting async read in FilePrefetchBuffer destructor
   ASYNC_PREFETCH_ABORT_MICROS,
 
+  // Time spent by a secondary instance in TryCatchUpWithPrimary()
+  SECONDARY_CATCH_UP_MICROS,
+
+  // Time spent querying memtables in a sampled Get(), see
+  // DBOptions::stats_get_breakdown_one_in
+  SAMPLED_GET_MEMTABLE_NANOS,
+
+  // Time spent reading SST files in a sampled Get()
+  SAMPLED_GET_SST_NANOS,
+
+  // Time spent reading blocks from files in a sampled Get()
+  SAMPLED_GET_BLOCK_READ_NANOS,
+
+  // Time spent decompressing blocks in a sampled Get()
+  SAMPLED_GET_DECOMPRESS_NANOS,
+
   HISTOGRAM_ENUM_MAX,
 };
 
@@ -756,6 +756,20 @@ struct PlainTableOptions {
   //                       file building and store it in file. When reading
   //                       file, index will be mapped instead of recomputation.
   bool store_index_in_file = false;
+
+  // @key_fingerprint_index: when opening a file, also build an in-memory hash
+  //                         index from every distinct user key to the offset
+  //                         of its first entry, with buckets of one cache
+  //                         line holding 16-bit key fingerprints and offsets.
+  //                         Get() then usually reads one cache line of the
+  //                         index and decodes only the key it looks for,
+  //                         instead of probing the prefix index and decoding
+  //                         keys during a binary search and a linear scan,
+  //                         and rules out most absent keys without decoding
+  //                         any key. It costs about 8 bytes of memory per
+  //                         distinct key. Iterators are unaffected. Only
+  //                         used for files with encoding type kPlain.
+  bool key_fingerprint_index = false;
 };
 
 // -- Plain Table with prefix-only seek
@@ -828,6 +842,12 @@ struct CuckooTableOptions {
   // power of two, and bit and is used to calculate hash, which is faster in
   // general.
   bool use_module_hash = true;
+  // Number of threads computing the hash values of the keys when the builder
+  // lays out the hash table. With more than one, the hash values are
+  // computed up front, using 8 bytes of memory per key and hash function
+  // during the build, and the placement of the keys prefetches their
+  // buckets. The file written is the same for any number of threads.
+  uint32_t build_threads = 1;
 };
 
 // Cuckoo Table Factory for SST table format using Cache Friendly Cuckoo Hashing
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -129,6 +130,43 @@ bool ExtractAggFuncAndValue(const Slice& op, Slice& func, Slice& value);
 // the returned function name is kErrorFuncName.
 bool ExtractList(const Slice& encoded_list, std::vector<Slice>& decoded_list);
 
+// Packed numeric payloads hold a fixed-width array of int64_t or double
+// values, such as one time-series sample per column, and are aggregated
+// element-wise by the aggregators from NewPackedNumericAggregator(). All
+// operands of a key must have the same number of elements and the same
+// element type, otherwise the aggregation fails.
+//
+//    AddAggregator("sum", NewPackedNumericAggregator(
+//                             PackedNumericAggregation::kSum));
+//    std::string payload;
+//    EncodePackedNumeric(std::vector<int64_t>{1, 2, 3}, payload);
+//    s = EncodeAggFuncAndPayload("sum", payload, encoded_value);
+//    db->Merge(WriteOptions(), "foo", encoded_value);
+enum class PackedNumericAggregation : unsigned char {
+  kSum,
+  kMin,
+  kMax,
+  // The result holds, per element, the number of values aggregated. It can
+  // be decoded as int64_t values.
+  kCount,
+};
+
+// Returns an aggregator reducing all the packed numeric payloads of a merge
+// in one pass per operand, with loops the compiler can vectorize. Summing
+// int64_t values wraps around on overflow.
+std::unique_ptr<Aggregator> NewPackedNumericAggregator(
+    PackedNumericAggregation aggregation);
+
+// Encode a packed numeric payload.
+void EncodePackedNumeric(const std::vector<int64_t>& values,
+                         std::string& output);
+void EncodePackedNumeric(const std::vector<double>& values,
+                         std::string& output);
+// Decode a packed numeric payload. Return false if it is not a packed
+// numeric payload of the given element type.
+bool DecodePackedNumeric(const Slice& payload, std::vector<int64_t>& values);
+bool DecodePackedNumeric(const Slice& payload, std::vector<double>& values);
+
 // Special function name that allows it to be merged to subsequent type.
 extern const std::string kUnnamedFuncName;
 
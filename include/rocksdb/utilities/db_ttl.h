@@ -28,6 +28,8 @@ namespace ROCKSDB_NAMESPACE {
 // (int32_t)Timestamp(creation) is suffixed to values in Put internally
 // Expired TTL values deleted in compaction only:(Timestamp+ttl<time_now)
 // Get/Iterator may return expired entries(compaction not run on them yet)
+// Table files holding only expired values are skipped by iterators and,
+//  with leveled compaction, deleted without being rewritten
 // Different TTL may be used during different Opens
 // Example: Open1 at t=0 with ttl=4 and insert k1,k2, close at t=2
 //          Open2 at t=3 with ttl=5. Now k1,k2 should be deleted at t>=5
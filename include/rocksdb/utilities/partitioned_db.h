@@ -0,0 +1,105 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+#ifndef ROCKSDB_LITE
+
+#include <memory>
+#include <string>
+
+#include "rocksdb/db.h"
+#include "rocksdb/utilities/stackable_db.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Decides which partition of a PartitionedDB each key is stored in.
+class KeyPartitioner {
+ public:
+  virtual ~KeyPartitioner() {}
+
+  virtual const char* Name() const = 0;
+
+  // Returns the partition of `key`, in [0, num_partitions). Has to return the
+  // same partition for the same key and number of partitions every time the
+  // DB is opened.
+  virtual size_t GetPartition(const Slice& key,
+                              size_t num_partitions) const = 0;
+};
+
+// Spreads keys evenly over the partitions by a hash of the whole key
+std::shared_ptr<KeyPartitioner> NewHashKeyPartitioner();
+
+struct PartitionedDBOptions {
+  // The number of DB instances the keys are spread over. Each has its own
+  // WAL, write group and memtables, so writes to different partitions do not
+  // wait for each other. Cannot be changed once the DB is created.
+  size_t num_partitions = 4;
+
+  // Routes keys to partitions. Defaults to NewHashKeyPartitioner(). Has to be
+  // the same every time the DB is opened.
+  std::shared_ptr<KeyPartitioner> partitioner;
+
+  // Number of threads that, together with the calling thread, run
+  // MultiGet(), CompactRange(), Flush() and Open() on the partitions in
+  // parallel. With 0 the partitions are visited one after the other.
+  int fanout_threads = 4;
+};
+
+// A DB whose keys are spread over several independent DB instances, the
+// partitions, stored in sub-directories of the DB directory.
+//
+// The partitions are opened with the same Options, so they share the Env
+// and its background thread pools, the table factory and its block cache,
+// the statistics, rate limiter and SstFileManager. Unless the Options name
+// one, a WriteBufferManager limiting all partitions together to
+// db_write_buffer_size is created for them.
+//
+// Reads and writes of the default column family are routed by key.
+// A WriteBatch touching several partitions is written to each of them
+// separately: a snapshot from GetSnapshot() sees it either completely or not
+// at all, but it is not atomic across a crash. If writing it fails in one
+// partition, the partitions written before keep their part, and the error
+// message lists them. A WriteBatch without updates, e.g. with only LogData()
+// records, is written to the first partition. Reads without a snapshot may
+// see each partition at a different point in time; use GetSnapshot() for a
+// consistent view of all partitions. Reads with any other snapshot, e.g. one
+// of a single partition, return InvalidArgument. Iterators merge the
+// partitions in comparator order. CompactRange(), SuggestCompactRange(),
+// Flush(), SetOptions() and SetDBOptions() apply to every partition.
+//
+// Other column families and user-defined timestamps are not supported, nor
+// are methods taking table files or sequence numbers, which belong to a
+// single partition: IngestExternalFile(), CompactFiles(), DeleteFile(),
+// PromoteL0() and GetUpdatesSince() return NotSupported. DB methods not
+// listed above, like GetProperty(), apply to the first partition only, as do
+// functions working on the DB underneath, like DeleteFilesInRange() and
+// Checkpoint; use GetPartition() to reach a specific one.
+class PartitionedDB : public StackableDB {
+ public:
+  static Status Open(const Options& options,
+                     const PartitionedDBOptions& partitioned_options,
+                     const std::string& dbname, PartitionedDB** dbptr);
+
+  virtual size_t NumPartitions() const = 0;
+
+  // Returns the index of the partition `key` is stored in
+  virtual size_t GetPartitionIndex(const Slice& key) const = 0;
+
+  // Returns the DB instance of partition `index`. It is owned by this DB and
+  // must not be used after this DB is deleted.
+  virtual DB* GetPartition(size_t index) const = 0;
+
+ protected:
+  explicit PartitionedDB(DB* db) : StackableDB(db) {}
+};
+
+// Destroys the contents of every partition of a PartitionedDB, and the DB
+// directory if nothing else is left in it.
+Status DestroyPartitionedDB(const std::string& dbname, const Options& options,
+                           const PartitionedDBOptions& partitioned_options);
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
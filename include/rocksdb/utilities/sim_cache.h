@@ -9,6 +9,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "rocksdb/cache.h"
 #include "rocksdb/env.h"
@@ -93,4 +95,58 @@ class SimCache : public Cache {
   SimCache& operator=(const SimCache&);
 };
 
+struct MissRatioCurveCacheOptions {
+  // Block cache capacities, in bytes, at which to estimate the miss ratio.
+  // Must not be empty.
+  std::vector<size_t> capacities;
+
+  // Fraction of the cache keys whose accesses are simulated, chosen by key
+  // hash so that either all or none of the accesses to a key are simulated
+  // (SHARDS spatial sampling). Each capacity is simulated by a key-only LRU
+  // cache scaled down by the same fraction, so both the memory and the CPU
+  // overhead shrink with it. Must be in (0, 1].
+  double sampling_rate = 0.01;
+};
+
+class MissRatioCurveCache;
+
+// For instrumentation purpose, a wrapper around a block cache that estimates
+// the miss ratio the block cache would have at each of several capacities
+// (its miss ratio curve) from the live workload, like SimCache does for a
+// single capacity but at a small fraction of its overhead. The estimate is
+// also reported by the "rocksdb.block-cache-miss-ratio-curve" DB property of
+// every column family using the returned cache as its block cache.
+//
+// Returns nullptr if `options` is invalid.
+extern std::shared_ptr<MissRatioCurveCache> NewMissRatioCurveCache(
+    std::shared_ptr<Cache> cache, const MissRatioCurveCacheOptions& options);
+
+class MissRatioCurveCache : public Cache {
+ public:
+  MissRatioCurveCache() {}
+  ~MissRatioCurveCache() override {}
+
+  static const char* kClassName() { return "MissRatioCurveCache"; }
+  const char* Name() const override { return kClassName(); }
+
+  // The fraction of the cache keys actually sampled
+  virtual double GetSamplingRate() const = 0;
+
+  // Number of sampled lookups since creation or the last reset
+  virtual uint64_t GetSampledLookups() const = 0;
+
+  // Returns the estimated miss ratio, in [0, 1], at each configured capacity
+  // in increasing order of capacity, as of the sampled lookups since
+  // creation or the last reset.
+  virtual std::vector<std::pair<size_t, double>> GetMissRatioCurve()
+      const = 0;
+
+  // Resets the lookup counters, keeping the simulated cache contents warm
+  virtual void ResetMissRatioCurve() = 0;
+
+ private:
+  MissRatioCurveCache(const MissRatioCurveCache&);
+  MissRatioCurveCache& operator=(const MissRatioCurveCache&);
+};
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -5151,6 +5151,10 @@ class TickerTypeJni {
         return -0x33;
       case ROCKSDB_NAMESPACE::Tickers::BLOB_DB_CACHE_BYTES_WRITE:
         return -0x34;
+      case ROCKSDB_NAMESPACE::Tickers::SECONDARY_WAL_RECORDS_APPLIED:
+        return -0x35;
+      case ROCKSDB_NAMESPACE::Tickers::SECONDARY_WAL_BYTES_APPLIED:
+        return -0x36;
       case ROCKSDB_NAMESPACE::Tickers::TICKER_ENUM_MAX:
         // 0x5F was the max value in the initial copy of tickers to Java.
         // Since these values are exposed directly to Java clients, we keep
@@ -5534,6 +5538,10 @@ class TickerTypeJni {
         return ROCKSDB_NAMESPACE::Tickers::BLOB_DB_CACHE_BYTES_READ;
       case -0x34:
         return ROCKSDB_NAMESPACE::Tickers::BLOB_DB_CACHE_BYTES_WRITE;
+      case -0x35:
+        return ROCKSDB_NAMESPACE::Tickers::SECONDARY_WAL_RECORDS_APPLIED;
+      case -0x36:
+        return ROCKSDB_NAMESPACE::Tickers::SECONDARY_WAL_BYTES_APPLIED;
       case 0x5F:
         // 0x5F was the max value in the initial copy of tickers to Java.
         // Since these values are exposed directly to Java clients, we keep
@@ -5675,6 +5683,16 @@ class HistogramTypeJni {
         return 0x37;
       case ASYNC_PREFETCH_ABORT_MICROS:
         return 0x38;
+      case ROCKSDB_NAMESPACE::Histograms::SECONDARY_CATCH_UP_MICROS:
+        return 0x39;
+      case ROCKSDB_NAMESPACE::Histograms::SAMPLED_GET_MEMTABLE_NANOS:
+        return 0x3A;
+      case ROCKSDB_NAMESPACE::Histograms::SAMPLED_GET_SST_NANOS:
+        return 0x3B;
+      case ROCKSDB_NAMESPACE::Histograms::SAMPLED_GET_BLOCK_READ_NANOS:
+        return 0x3C;
+      case ROCKSDB_NAMESPACE::Histograms::SAMPLED_GET_DECOMPRESS_NANOS:
+        return 0x3D;
       case ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX:
         // 0x1F for backwards compatibility on current minor version.
         return 0x1F;
@@ -5805,6 +5823,16 @@ class HistogramTypeJni {
         return ROCKSDB_NAMESPACE::Histograms::NUM_LEVEL_READ_PER_MULTIGET;
       case 0x38:
         return ROCKSDB_NAMESPACE::Histograms::ASYNC_PREFETCH_ABORT_MICROS;
+      case 0x39:
+        return ROCKSDB_NAMESPACE::Histograms::SECONDARY_CATCH_UP_MICROS;
+      case 0x3A:
+        return ROCKSDB_NAMESPACE::Histograms::SAMPLED_GET_MEMTABLE_NANOS;
+      case 0x3B:
+        return ROCKSDB_NAMESPACE::Histograms::SAMPLED_GET_SST_NANOS;
+      case 0x3C:
+        return ROCKSDB_NAMESPACE::Histograms::SAMPLED_GET_BLOCK_READ_NANOS;
+      case 0x3D:
+        return ROCKSDB_NAMESPACE::Histograms::SAMPLED_GET_DECOMPRESS_NANOS;
       case 0x1F:
         // 0x1F for backwards compatibility on current minor version.
         return ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX;
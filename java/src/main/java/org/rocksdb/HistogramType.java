@@ -182,6 +182,32 @@ public enum HistogramType {
 
   ASYNC_READ_BYTES((byte) 0x33),
 
+  /**
+   * Time spent by a secondary instance in TryCatchUpWithPrimary()
+   */
+  SECONDARY_CATCH_UP_MICROS((byte) 0x39),
+
+  /**
+   * Time spent querying memtables in a sampled Get(), see
+   * DBOptions::stats_get_breakdown_one_in
+   */
+  SAMPLED_GET_MEMTABLE_NANOS((byte) 0x3A),
+
+  /**
+   * Time spent reading SST files in a sampled Get()
+   */
+  SAMPLED_GET_SST_NANOS((byte) 0x3B),
+
+  /**
+   * Time spent reading blocks from files in a sampled Get()
+   */
+  SAMPLED_GET_BLOCK_READ_NANOS((byte) 0x3C),
+
+  /**
+   * Time spent decompressing blocks in a sampled Get()
+   */
+  SAMPLED_GET_DECOMPRESS_NANOS((byte) 0x3D),
+
   // 0x1F for backwards compatibility on current minor version.
   HISTOGRAM_ENUM_MAX((byte) 0x1F);
 
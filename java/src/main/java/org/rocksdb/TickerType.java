@@ -836,6 +836,16 @@ public enum TickerType {
      */
     BLOB_DB_CACHE_BYTES_WRITE((byte) -0x34),
 
+    /**
+     * # of WAL records a secondary instance applied to its memtables.
+     */
+    SECONDARY_WAL_RECORDS_APPLIED((byte) -0x35),
+
+    /**
+     * # of bytes of WAL records a secondary instance applied to its memtables.
+     */
+    SECONDARY_WAL_BYTES_APPLIED((byte) -0x36),
+
     TICKER_ENUM_MAX((byte) 0x5F);
 
     private final byte value;
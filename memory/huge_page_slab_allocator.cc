@@ -0,0 +1,264 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "memory/huge_page_slab_allocator.h"
+
+#include <algorithm>
+
+#ifdef NUMA
+#include <numa.h>
+#endif  // NUMA
+
+#include "rocksdb/convenience.h"
+#include "rocksdb/utilities/options_type.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Every size class is a multiple of this, so that all allocations are
+// aligned like those of malloc()
+constexpr size_t kSizeClassAlignment = 16;
+
+size_t AlignSizeClass(size_t size) {
+  return (size + kSizeClassAlignment - 1) & ~(kSizeClassAlignment - 1);
+}
+}  // namespace
+
+static std::unordered_map<std::string, OptionTypeInfo>
+    huge_page_slab_type_info = {
+#ifndef ROCKSDB_LITE
+        {"capacity",
+         {offsetof(struct HugePageSlabAllocatorOptions, capacity),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"slab_size",
+         {offsetof(struct HugePageSlabAllocatorOptions, slab_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"use_huge_pages",
+         {offsetof(struct HugePageSlabAllocatorOptions, use_huge_pages),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"min_size_class",
+         {offsetof(struct HugePageSlabAllocatorOptions, min_size_class),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"max_size_class",
+         {offsetof(struct HugePageSlabAllocatorOptions, max_size_class),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"size_classes_per_doubling",
+         {offsetof(struct HugePageSlabAllocatorOptions,
+                   size_classes_per_doubling),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"numa_node",
+         {offsetof(struct HugePageSlabAllocatorOptions, numa_node),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+#endif  // ROCKSDB_LITE
+};
+
+HugePageSlabAllocator::HugePageSlabAllocator(
+    const HugePageSlabAllocatorOptions& options)
+    : options_(options) {
+  RegisterOptions(&options_, &huge_page_slab_type_info);
+}
+
+HugePageSlabAllocator::~HugePageSlabAllocator() {}
+
+Status HugePageSlabAllocator::PrepareOptions(
+    const ConfigOptions& config_options) {
+  if (prepared_) {
+    return Status::OK();
+  }
+  const HugePageSlabAllocatorOptions& o = options_;
+  if (o.capacity == 0 || o.slab_size == 0) {
+    return Status::InvalidArgument("capacity and slab_size must be positive.");
+  } else if (o.min_size_class == 0 || o.min_size_class > o.max_size_class) {
+    return Status::InvalidArgument(
+        "min_size_class must be positive and at most max_size_class.");
+  } else if (AlignSizeClass(o.max_size_class) > o.slab_size) {
+    return Status::InvalidArgument("max_size_class larger than slab_size.");
+  } else if (o.size_classes_per_doubling < 1 ||
+             o.size_classes_per_doubling > 64) {
+    return Status::InvalidArgument(
+        "size_classes_per_doubling must be between 1 and 64.");
+  }
+  Status s = MemoryAllocator::PrepareOptions(config_options);
+  if (!s.ok()) {
+    return s;
+  }
+
+  // Size classes are spaced evenly between consecutive powers of two times
+  // min_size_class
+  for (size_t lower = o.min_size_class; lower <= o.max_size_class;
+       lower *= 2) {
+    for (int i = 0; i < o.size_classes_per_doubling; ++i) {
+      size_t size = AlignSizeClass(
+          lower + lower * static_cast<size_t>(i) /
+                      static_cast<size_t>(o.size_classes_per_doubling));
+      if (size > o.max_size_class) {
+        break;
+      }
+      if (class_sizes_.empty() || size > class_sizes_.back()) {
+        class_sizes_.push_back(size);
+      }
+    }
+  }
+  // Also covers min_size_class rounding up past an unaligned max_size_class
+  if (class_sizes_.empty() || class_sizes_.back() < o.max_size_class) {
+    class_sizes_.push_back(AlignSizeClass(o.max_size_class));
+  }
+  size_classes_.reset(new SizeClass[class_sizes_.size()]);
+
+  size_t num_slabs = (o.capacity + o.slab_size - 1) / o.slab_size;
+  size_t length = num_slabs * o.slab_size;
+  if (o.use_huge_pages && MemMapping::kHugePageSupported) {
+    mapping_.reset(new MemMapping(MemMapping::AllocateHuge(length)));
+    huge_pages_ = mapping_->Get() != nullptr;
+  }
+  if (!huge_pages_) {
+    // Fall back on normal pages, which are only backed by memory once used
+    mapping_.reset(new MemMapping(MemMapping::AllocateLazyZeroed(length)));
+#if !defined(OS_WIN) && defined(MADV_HUGEPAGE)
+    if (o.use_huge_pages && mapping_->Get() != nullptr) {
+      // Best effort, ignoring the result
+      (void)madvise(mapping_->Get(), length, MADV_HUGEPAGE);
+    }
+#endif  // !OS_WIN && MADV_HUGEPAGE
+  }
+  if (mapping_->Get() != nullptr) {
+    base_ = static_cast<char*>(mapping_->Get());
+    reserved_bytes_ = length;
+    slab_classes_.resize(num_slabs);
+#ifdef NUMA
+    if (o.numa_node >= 0 && numa_available() != -1) {
+      numa_tonode_memory(base_, length, o.numa_node);
+    }
+#endif  // NUMA
+  }
+  // Otherwise all allocations fall back to new[]
+  prepared_ = true;
+  return Status::OK();
+}
+
+size_t HugePageSlabAllocator::FindSizeClass(size_t size) const {
+  return static_cast<size_t>(
+      std::lower_bound(class_sizes_.begin(), class_sizes_.end(), size) -
+      class_sizes_.begin());
+}
+
+char* HugePageSlabAllocator::NewSlab(size_t index) {
+  size_t slab = next_slab_.fetch_add(1, std::memory_order_relaxed);
+  if (slab >= slab_classes_.size()) {
+    return nullptr;
+  }
+  slab_classes_[slab] = static_cast<uint32_t>(index);
+  return base_ + slab * options_.slab_size;
+}
+
+void* HugePageSlabAllocator::Allocate(size_t size) {
+  size_t index = FindSizeClass(size);
+  if (index < class_sizes_.size()) {
+    size_t class_size = class_sizes_[index];
+    SizeClass& sc = size_classes_[index];
+    std::lock_guard<std::mutex> lock(sc.mutex);
+    void* p = sc.free_list;
+    if (p != nullptr) {
+      sc.free_list = *static_cast<void**>(p);
+    } else {
+      if (static_cast<size_t>(sc.slab_end - sc.slab_next) < class_size) {
+        char* slab = NewSlab(index);
+        if (slab != nullptr) {
+          sc.slab_next = slab;
+          sc.slab_end = slab + options_.slab_size;
+          ++sc.num_slabs;
+        }
+      }
+      if (static_cast<size_t>(sc.slab_end - sc.slab_next) >= class_size) {
+        p = sc.slab_next;
+        sc.slab_next += class_size;
+      }
+    }
+    if (p != nullptr) {
+      ++sc.num_allocations;
+      return p;
+    }
+  }
+  num_fallback_allocations_.fetch_add(1, std::memory_order_relaxed);
+  return new char[size];
+}
+
+void HugePageSlabAllocator::Deallocate(void* p) {
+  if (!IsReserved(p)) {
+    delete[] static_cast<char*>(p);
+    return;
+  }
+  size_t slab =
+      static_cast<size_t>(static_cast<char*>(p) - base_) / options_.slab_size;
+  SizeClass& sc = size_classes_[slab_classes_[slab]];
+  std::lock_guard<std::mutex> lock(sc.mutex);
+  *static_cast<void**>(p) = sc.free_list;
+  sc.free_list = p;
+  assert(sc.num_allocations > 0);
+  --sc.num_allocations;
+}
+
+size_t HugePageSlabAllocator::UsableSize(void* p,
+                                         size_t allocation_size) const {
+  if (!IsReserved(p)) {
+    return allocation_size;
+  }
+  size_t slab =
+      static_cast<size_t>(static_cast<char*>(p) - base_) / options_.slab_size;
+  return class_sizes_[slab_classes_[slab]];
+}
+
+void HugePageSlabAllocator::GetStats(HugePageSlabAllocatorStats* stats) const {
+  *stats = HugePageSlabAllocatorStats();
+  stats->reserved_bytes = reserved_bytes_;
+  stats->huge_pages = huge_pages_;
+  for (size_t i = 0; i < class_sizes_.size(); ++i) {
+    SizeClass& sc = size_classes_[i];
+    std::lock_guard<std::mutex> lock(sc.mutex);
+    stats->slab_bytes += sc.num_slabs * options_.slab_size;
+    stats->allocated_bytes += sc.num_allocations * class_sizes_[i];
+    stats->num_allocations += sc.num_allocations;
+  }
+  stats->free_bytes = stats->slab_bytes - stats->allocated_bytes;
+  stats->num_fallback_allocations =
+      num_fallback_allocations_.load(std::memory_order_relaxed);
+}
+
+Status NewHugePageSlabAllocator(
+    const HugePageSlabAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator) {
+  if (memory_allocator == nullptr) {
+    return Status::InvalidArgument("memory_allocator must be non-null.");
+  }
+  std::unique_ptr<MemoryAllocator> allocator(
+      new HugePageSlabAllocator(options));
+  Status s = allocator->PrepareOptions(ConfigOptions());
+  if (s.ok()) {
+    memory_allocator->reset(allocator.release());
+  }
+  return s;
+}
+
+Status GetHugePageSlabAllocatorStats(const MemoryAllocator* allocator,
+                                     HugePageSlabAllocatorStats* stats) {
+  const HugePageSlabAllocator* slab_allocator =
+      allocator == nullptr ? nullptr
+                           : allocator->CheckedCast<HugePageSlabAllocator>();
+  if (slab_allocator == nullptr) {
+    return Status::InvalidArgument("Not a HugePageSlabAllocator.");
+  }
+  slab_allocator->GetStats(stats);
+  return Status::OK();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
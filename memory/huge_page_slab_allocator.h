@@ -0,0 +1,88 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "port/mmap.h"
+#include "rocksdb/memory_allocator.h"
+#include "utilities/memory_allocators.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A MemoryAllocator serving allocations from size class slabs carved out of
+// one region reserved up front, see NewHugePageSlabAllocator(). Allocations
+// that are too large for the size classes, or made when the region is used
+// up, fall back to new[].
+class HugePageSlabAllocator : public BaseMemoryAllocator {
+ public:
+  explicit HugePageSlabAllocator(const HugePageSlabAllocatorOptions& options);
+  ~HugePageSlabAllocator() override;
+
+  static const char* kClassName() { return "HugePageSlabAllocator"; }
+  const char* Name() const override { return kClassName(); }
+
+  // Validates the options, computes the size classes and reserves the
+  // memory. The options cannot be changed afterwards.
+  Status PrepareOptions(const ConfigOptions& config_options) override;
+
+  void* Allocate(size_t size) override;
+  void Deallocate(void* p) override;
+  size_t UsableSize(void* p, size_t allocation_size) const override;
+
+  void GetStats(HugePageSlabAllocatorStats* stats) const;
+
+  // The allocation size of each size class, in increasing order. Empty until
+  // PrepareOptions() is called.
+  const std::vector<size_t>& GetSizeClasses() const { return class_sizes_; }
+
+ private:
+  struct SizeClass {
+    std::mutex mutex;
+    // Freed allocations, linked through their first bytes
+    void* free_list = nullptr;
+    // The part of the size class's latest slab that was never allocated
+    char* slab_next = nullptr;
+    char* slab_end = nullptr;
+    uint64_t num_slabs = 0;
+    uint64_t num_allocations = 0;
+  };
+
+  // Returns the size class index of an allocation of `size` bytes, or
+  // class_sizes_.size() if it is too large for any of them.
+  size_t FindSizeClass(size_t size) const;
+  bool IsReserved(const void* p) const {
+    auto addr = reinterpret_cast<uintptr_t>(p);
+    auto base = reinterpret_cast<uintptr_t>(base_);
+    return addr >= base && addr - base < reserved_bytes_;
+  }
+  // Returns a new slab for size class `index`, or nullptr if the reserved
+  // memory is used up
+  char* NewSlab(size_t index);
+
+  HugePageSlabAllocatorOptions options_;
+  bool prepared_ = false;
+
+  std::vector<size_t> class_sizes_;
+  std::unique_ptr<SizeClass[]> size_classes_;
+
+  std::unique_ptr<MemMapping> mapping_;
+  char* base_ = nullptr;
+  size_t reserved_bytes_ = 0;
+  bool huge_pages_ = false;
+  // The size class index each slab is handed out to, written before any
+  // allocation from the slab is returned
+  std::vector<uint32_t> slab_classes_;
+  std::atomic<size_t> next_slab_{0};
+
+  std::atomic<uint64_t> num_fallback_allocations_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
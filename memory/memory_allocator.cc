@@ -5,6 +5,7 @@
 
 #include "rocksdb/memory_allocator.h"
 
+#include "memory/huge_page_slab_allocator.h"
 #include "memory/jemalloc_nodump_allocator.h"
 #include "memory/memkind_kmem_allocator.h"
 #include "rocksdb/utilities/customizable_util.h"
@@ -58,6 +59,13 @@ static int RegisterBuiltinAllocators(ObjectLibrary& library,
         }
         return guard->get();
       });
+  library.AddFactory<MemoryAllocator>(
+      HugePageSlabAllocator::kClassName(),
+      [](const std::string& /*uri*/, std::unique_ptr<MemoryAllocator>* guard,
+         std::string* /*errmsg*/) {
+        guard->reset(new HugePageSlabAllocator(HugePageSlabAllocatorOptions()));
+        return guard->get();
+      });
   size_t num_types;
   return static_cast<int>(library.GetFactoryCount(&num_types));
 }
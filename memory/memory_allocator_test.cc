@@ -6,6 +6,7 @@
 
 #include <cstdio>
 
+#include "memory/huge_page_slab_allocator.h"
 #include "memory/jemalloc_nodump_allocator.h"
 #include "memory/memkind_kmem_allocator.h"
 #include "rocksdb/cache.h"
@@ -212,9 +213,124 @@ TEST_F(CreateMemoryAllocatorTest, NewJemallocNodumpAllocator) {
   ASSERT_EQ(opts->limit_tcache_size, jopts.limit_tcache_size);
 }
 
+TEST_F(CreateMemoryAllocatorTest, HugePageSlabAllocatorOptionsTest) {
+  std::shared_ptr<MemoryAllocator> allocator;
+  std::string id = std::string("id=") + HugePageSlabAllocator::kClassName();
+  ASSERT_OK(MemoryAllocator::CreateFromString(
+      config_options_,
+      id + "; capacity=1048576; slab_size=65536; use_huge_pages=false; "
+           "min_size_class=1024; max_size_class=8192; "
+           "size_classes_per_doubling=2",
+      &allocator));
+  auto opts = allocator->GetOptions<HugePageSlabAllocatorOptions>();
+  ASSERT_NE(opts, nullptr);
+  ASSERT_EQ(opts->capacity, 1048576U);
+  ASSERT_EQ(opts->slab_size, 65536U);
+  ASSERT_FALSE(opts->use_huge_pages);
+  auto slab_allocator = allocator->CheckedCast<HugePageSlabAllocator>();
+  ASSERT_NE(slab_allocator, nullptr);
+  ASSERT_EQ(slab_allocator->GetSizeClasses(),
+            std::vector<size_t>({1024, 1536, 2048, 3072, 4096, 6144, 8192}));
+
+  // A single size class that is not aligned is rounded up
+  ASSERT_OK(MemoryAllocator::CreateFromString(
+      config_options_,
+      id + "; capacity=1048576; slab_size=65536; use_huge_pages=false; "
+           "min_size_class=500; max_size_class=500",
+      &allocator));
+  slab_allocator = allocator->CheckedCast<HugePageSlabAllocator>();
+  ASSERT_NE(slab_allocator, nullptr);
+  ASSERT_EQ(slab_allocator->GetSizeClasses(), std::vector<size_t>({512}));
+  void* p = allocator->Allocate(500);
+  ASSERT_NE(p, nullptr);
+  ASSERT_EQ(allocator->UsableSize(p, 500), 512U);
+  allocator->Deallocate(p);
+
+  // Invalid options
+  ASSERT_NOK(MemoryAllocator::CreateFromString(
+      config_options_, id + "; min_size_class=8192; max_size_class=4096",
+      &allocator));
+  ASSERT_NOK(MemoryAllocator::CreateFromString(
+      config_options_, id + "; slab_size=65536; max_size_class=131072",
+      &allocator));
+  ASSERT_NOK(MemoryAllocator::CreateFromString(
+      config_options_, id + "; size_classes_per_doubling=0", &allocator));
+}
+
+TEST_F(CreateMemoryAllocatorTest, NewHugePageSlabAllocator) {
+  HugePageSlabAllocatorOptions hopts;
+  hopts.capacity = 4 << 20;
+  hopts.slab_size = 2 << 20;
+  hopts.min_size_class = 4096;
+  hopts.max_size_class = 64 << 10;
+  hopts.size_classes_per_doubling = 4;
+  std::shared_ptr<MemoryAllocator> allocator;
+  ASSERT_NOK(NewHugePageSlabAllocator(hopts, nullptr));
+  ASSERT_OK(NewHugePageSlabAllocator(hopts, &allocator));
+  ASSERT_NE(allocator, nullptr);
+
+  HugePageSlabAllocatorStats stats;
+  ASSERT_NOK(GetHugePageSlabAllocatorStats(nullptr, &stats));
+  DefaultMemoryAllocator default_allocator;
+  ASSERT_NOK(GetHugePageSlabAllocatorStats(&default_allocator, &stats));
+  ASSERT_OK(GetHugePageSlabAllocatorStats(allocator.get(), &stats));
+  ASSERT_EQ(stats.reserved_bytes, hopts.capacity);
+  ASSERT_EQ(stats.slab_bytes, 0U);
+  ASSERT_EQ(stats.num_allocations, 0U);
+
+  // A block a little over 4 KB is rounded up to the next size class
+  void* p1 = allocator->Allocate(4200);
+  ASSERT_NE(p1, nullptr);
+  ASSERT_EQ(allocator->UsableSize(p1, 4200), 5120U);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(p1) % 16, 0U);
+  memset(p1, 'a', 5120);
+  void* p2 = allocator->Allocate(5000);
+  ASSERT_NE(p2, nullptr);
+  ASSERT_NE(p1, p2);
+  // Too large for the size classes
+  void* p3 = allocator->Allocate(100 << 10);
+  ASSERT_NE(p3, nullptr);
+  ASSERT_EQ(allocator->UsableSize(p3, 100 << 10), size_t{100} << 10);
+
+  ASSERT_OK(GetHugePageSlabAllocatorStats(allocator.get(), &stats));
+  ASSERT_EQ(stats.slab_bytes, hopts.slab_size);
+  ASSERT_EQ(stats.allocated_bytes, 2 * 5120U);
+  ASSERT_EQ(stats.free_bytes, hopts.slab_size - 2 * 5120U);
+  ASSERT_EQ(stats.num_allocations, 2U);
+  ASSERT_EQ(stats.num_fallback_allocations, 1U);
+
+  // Freed allocations are reused by their size class
+  allocator->Deallocate(p1);
+  allocator->Deallocate(p3);
+  void* p4 = allocator->Allocate(5120);
+  ASSERT_EQ(p4, p1);
+
+  // Another size class gets its own slab, and allocations fall back once
+  // the reserved memory is used up
+  std::vector<void*> ps;
+  for (int i = 0; i < 64; ++i) {
+    ps.push_back(allocator->Allocate(64 << 10));
+  }
+  ASSERT_OK(GetHugePageSlabAllocatorStats(allocator.get(), &stats));
+  ASSERT_EQ(stats.slab_bytes, 2 * hopts.slab_size);
+  ASSERT_EQ(stats.num_allocations, 2U + 32U);
+  ASSERT_EQ(stats.num_fallback_allocations, 1U + 32U);
+  for (void* p : ps) {
+    allocator->Deallocate(p);
+  }
+  allocator->Deallocate(p2);
+  allocator->Deallocate(p4);
+  ASSERT_OK(GetHugePageSlabAllocatorStats(allocator.get(), &stats));
+  ASSERT_EQ(stats.num_allocations, 0U);
+  ASSERT_EQ(stats.free_bytes, stats.slab_bytes);
+}
+
 INSTANTIATE_TEST_CASE_P(DefaultMemoryAllocator, MemoryAllocatorTest,
                         ::testing::Values(std::make_tuple(
                             DefaultMemoryAllocator::kClassName(), true)));
+INSTANTIATE_TEST_CASE_P(HugePageSlabAllocator, MemoryAllocatorTest,
+                        ::testing::Values(std::make_tuple(
+                            HugePageSlabAllocator::kClassName(), true)));
 #ifdef MEMKIND
 INSTANTIATE_TEST_CASE_P(
     MemkindkMemAllocator, MemoryAllocatorTest,
@@ -0,0 +1,132 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmark of the aggregation merge operator full merging many
+// operands of a numeric time-series column, comparing varint encoded values
+// aggregated one operand at a time with the packed numeric aggregators.
+#include "benchmark/benchmark.h"
+#include "rocksdb/utilities/agg_merge.h"
+#include "util/coding.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Sums payloads of varsigned int64 values element-wise, decoding them one
+// at a time, as a typical hand-written aggregator does
+class VarintSumAggregator : public Aggregator {
+ public:
+  bool Aggregate(const std::vector<Slice>& values,
+                 std::string& result) const override {
+    std::vector<int64_t> sum;
+    for (const Slice& value : values) {
+      Slice input = value;
+      for (size_t i = 0; !input.empty(); ++i) {
+        int64_t v;
+        if (!GetVarsignedint64(&input, &v)) {
+          return false;
+        }
+        if (i == sum.size()) {
+          sum.push_back(0);
+        }
+        sum[i] += v;
+      }
+    }
+    result.clear();
+    for (int64_t v : sum) {
+      PutVarsignedint64(&result, v);
+    }
+    return true;
+  }
+};
+
+enum AggImpl : int64_t {
+  kVarintSum = 0,
+  kPackedSum = 1,
+  kPackedMin = 2,
+  kPackedCount = 3,
+};
+
+static const char* kFuncNames[] = {"bench_varint_sum", "bench_packed_sum",
+                                   "bench_packed_min", "bench_packed_count"};
+
+static void RegisterAggregators() {
+  static bool registered = [] {
+    AddAggregator(kFuncNames[kVarintSum],
+                  std::unique_ptr<Aggregator>(new VarintSumAggregator()))
+        .PermitUncheckedError();
+    AddAggregator(kFuncNames[kPackedSum],
+                  NewPackedNumericAggregator(PackedNumericAggregation::kSum))
+        .PermitUncheckedError();
+    AddAggregator(kFuncNames[kPackedMin],
+                  NewPackedNumericAggregator(PackedNumericAggregation::kMin))
+        .PermitUncheckedError();
+    AddAggregator(kFuncNames[kPackedCount],
+                  NewPackedNumericAggregator(PackedNumericAggregation::kCount))
+        .PermitUncheckedError();
+    return true;
+  }();
+  (void)registered;
+}
+
+static void AggMergeFullMerge(benchmark::State& state) {
+  RegisterAggregators();
+  auto impl = static_cast<AggImpl>(state.range(0));
+  auto num_operands = static_cast<size_t>(state.range(1));
+  auto width = static_cast<size_t>(state.range(2));
+
+  Random64 rnd(301);
+  std::vector<std::string> operands(num_operands);
+  std::vector<int64_t> samples(width);
+  for (auto& op : operands) {
+    std::string payload;
+    for (auto& v : samples) {
+      v = static_cast<int64_t>(rnd.Uniform(1 << 20));
+      if (impl == kVarintSum) {
+        PutVarsignedint64(&payload, v);
+      }
+    }
+    if (impl != kVarintSum) {
+      EncodePackedNumeric(samples, payload);
+    }
+    Status s = EncodeAggFuncAndPayload(kFuncNames[impl], payload, op);
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+      return;
+    }
+  }
+  std::vector<Slice> operand_list(operands.begin(), operands.end());
+
+  std::shared_ptr<MergeOperator> merge_operator = GetAggMergeOperator();
+  Slice key("key");
+  std::string new_value;
+  Slice existing_operand;
+  for (auto _ : state) {
+    MergeOperator::MergeOperationInput merge_in(key, nullptr, operand_list,
+                                                nullptr);
+    MergeOperator::MergeOperationOutput merge_out(new_value, existing_operand);
+    merge_operator->FullMergeV2(merge_in, &merge_out);
+    benchmark::DoNotOptimize(new_value);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(num_operands * width));
+}
+
+static void AggMergeArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t impl : {kVarintSum, kPackedSum, kPackedMin, kPackedCount}) {
+    for (int64_t num_operands : {16, 256, 4096}) {
+      for (int64_t width : {1, 16, 128}) {
+        b->Args({impl, num_operands, width});
+      }
+    }
+  }
+  b->ArgNames({"impl", "num_operands", "width"});
+}
+
+BENCHMARK(AggMergeFullMerge)->Apply(AggMergeArguments);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
@@ -125,6 +125,44 @@ void HistogramStat::Merge(const HistogramStat& other) {
   }
 }
 
+void HistogramStat::Subtract(const HistogramStat& older) {
+  // Like Merge(), expected to be called with the outer lock held, typically on
+  // an aggregate that is not being added to.
+  if (older.num() > num()) {
+    return;
+  }
+  for (unsigned int b = 0; b < num_buckets_; b++) {
+    if (older.bucket_at(b) > bucket_at(b)) {
+      return;
+    }
+  }
+
+  num_.fetch_sub(older.num(), std::memory_order_relaxed);
+  sum_.fetch_sub(older.sum(), std::memory_order_relaxed);
+  sum_squares_.fetch_sub(older.sum_squares(), std::memory_order_relaxed);
+  size_t lowest = num_buckets_;
+  size_t highest = 0;
+  for (unsigned int b = 0; b < num_buckets_; b++) {
+    buckets_[b].fetch_sub(older.bucket_at(b), std::memory_order_relaxed);
+    if (bucket_at(b) > 0) {
+      lowest = std::min(lowest, static_cast<size_t>(b));
+      highest = b;
+    }
+  }
+  if (lowest == num_buckets_) {
+    Clear();
+    return;
+  }
+  uint64_t lowest_limit =
+      (lowest == 0) ? 0 : bucketMapper.BucketLimit(lowest - 1);
+  min_.store(std::max(min(), lowest_limit), std::memory_order_relaxed);
+  if (highest + 1 < num_buckets_) {
+    // The last bucket also holds the values beyond its limit
+    max_.store(std::min(max(), bucketMapper.BucketLimit(highest)),
+               std::memory_order_relaxed);
+  }
+}
+
 double HistogramStat::Median() const { return Percentile(50.0); }
 
 double HistogramStat::Percentile(double p) const {
@@ -251,6 +289,11 @@ void HistogramImpl::Merge(const HistogramImpl& other) {
   stats_.Merge(other.stats_);
 }
 
+void HistogramImpl::Subtract(const HistogramImpl& older) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.Subtract(older.stats_);
+}
+
 double HistogramImpl::Median() const { return stats_.Median(); }
 
 double HistogramImpl::Percentile(double p) const {
@@ -54,6 +54,12 @@ struct HistogramStat {
   bool Empty() const;
   void Add(uint64_t value);
   void Merge(const HistogramStat& other);
+  // Removes the samples of `older`, an earlier copy of this histogram, so
+  // that only the samples added since are left. The exact min() and max() of
+  // those cannot be recovered and are narrowed to the bounds of the lowest
+  // and highest non-empty buckets instead. Leaves the histogram unchanged if
+  // it was cleared after `older` was taken.
+  void Subtract(const HistogramStat& older);
 
   inline uint64_t min() const { return min_.load(std::memory_order_relaxed); }
   inline uint64_t max() const { return max_.load(std::memory_order_relaxed); }
@@ -119,6 +125,7 @@ class HistogramImpl : public Histogram {
   virtual void Add(uint64_t value) override;
   virtual void Merge(const Histogram& other) override;
   void Merge(const HistogramImpl& other);
+  void Subtract(const HistogramImpl& older);
 
   virtual std::string ToString() const override;
   virtual const char* Name() const override { return "HistogramImpl"; }
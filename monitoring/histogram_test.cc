@@ -118,6 +118,39 @@ TEST_F(HistogramTest, MergeHistogram) {
   MergeHistogram(histogramWindowing, otherWindowing);
 }
 
+TEST_F(HistogramTest, SubtractHistogram) {
+  HistogramImpl older;
+  HistogramImpl histogram;
+  for (uint64_t i = 1; i <= 1000; i++) {
+    older.Add(i);
+    histogram.Add(i);
+  }
+  for (uint64_t i = 0; i < 1000; i++) {
+    histogram.Add(5000);
+  }
+
+  histogram.Subtract(older);
+  ASSERT_EQ(histogram.num(), 1000);
+  ASSERT_LE(fabs(histogram.Average() - 5000.0), kIota);
+  ASSERT_LE(fabs(histogram.StandardDeviation()), kIota);
+  // Narrowed from the cumulative [1, 5000] to the only non-empty bucket
+  ASSERT_GT(histogram.min(), 1000);
+  ASSERT_EQ(histogram.max(), 5000);
+  ASSERT_GT(histogram.Median(), 1000.0);
+  ASSERT_LE(histogram.Median(), 5000.0);
+
+  // Nothing left
+  histogram.Clear();
+  histogram.Merge(older);
+  histogram.Subtract(older);
+  EmptyHistogram(histogram);
+
+  // `older` is not an earlier copy, e.g. the histogram was cleared since
+  histogram.Add(1);
+  histogram.Subtract(older);
+  ASSERT_EQ(histogram.num(), 1);
+}
+
 TEST_F(HistogramTest, EmptyHistogram) {
   HistogramImpl histogram;
   EmptyHistogram(histogram);
@@ -233,7 +233,9 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {BLOB_DB_CACHE_ADD, "rocksdb.blobdb.cache.add"},
     {BLOB_DB_CACHE_ADD_FAILURES, "rocksdb.blobdb.cache.add.failures"},
     {BLOB_DB_CACHE_BYTES_READ, "rocksdb.blobdb.cache.bytes.read"},
-    {BLOB_DB_CACHE_BYTES_WRITE, "rocksdb.blobdb.cache.bytes.write"}};
+    {BLOB_DB_CACHE_BYTES_WRITE, "rocksdb.blobdb.cache.bytes.write"},
+    {SECONDARY_WAL_RECORDS_APPLIED, "rocksdb.secondary.wal.records.applied"},
+    {SECONDARY_WAL_BYTES_APPLIED, "rocksdb.secondary.wal.bytes.applied"}};
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
     {DB_GET, "rocksdb.db.get.micros"},
@@ -296,6 +298,11 @@ const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
     {MULTIGET_IO_BATCH_SIZE, "rocksdb.multiget.io.batch.size"},
     {NUM_LEVEL_READ_PER_MULTIGET, "rocksdb.num.level.read.per.multiget"},
     {ASYNC_PREFETCH_ABORT_MICROS, "rocksdb.async.prefetch.abort.micros"},
+    {SECONDARY_CATCH_UP_MICROS, "rocksdb.secondary.catch.up.micros"},
+    {SAMPLED_GET_MEMTABLE_NANOS, "rocksdb.sampled.get.memtable.nanos"},
+    {SAMPLED_GET_SST_NANOS, "rocksdb.sampled.get.sst.nanos"},
+    {SAMPLED_GET_BLOCK_READ_NANOS, "rocksdb.sampled.get.block.read.nanos"},
+    {SAMPLED_GET_DECOMPRESS_NANOS, "rocksdb.sampled.get.decompress.nanos"},
 };
 
 std::shared_ptr<Statistics> CreateDBStatistics() {
@@ -469,6 +476,26 @@ namespace {
 // a buffer size used for temp string buffers
 const int kTmpStrBufferSize = 200;
 
+void AppendHistogramLine(const std::string& name, const HistogramImpl& hist,
+                         std::string* res) {
+  char buffer[kTmpStrBufferSize];
+  HistogramData hData;
+  hist.Data(&hData);
+  // don't handle failures - buffer should always be big enough and arguments
+  // should be provided correctly
+  int ret =
+      snprintf(buffer, kTmpStrBufferSize,
+               "%s P50 : %f P95 : %f P99 : %f P100 : %f COUNT : %" PRIu64
+               " SUM : %" PRIu64 "\n",
+               name.c_str(), hData.median, hData.percentile95,
+               hData.percentile99, hData.max, hData.count, hData.sum);
+  if (ret < 0 || ret >= kTmpStrBufferSize) {
+    assert(false);
+    return;
+  }
+  res->append(buffer);
+}
+
 }  // namespace
 
 std::string StatisticsImpl::ToString() const {
@@ -484,24 +511,33 @@ std::string StatisticsImpl::ToString() const {
   }
   for (const auto& h : HistogramsNameMap) {
     assert(h.first < HISTOGRAM_ENUM_MAX);
-    char buffer[kTmpStrBufferSize];
-    HistogramData hData;
-    getHistogramImplLocked(h.first)->Data(&hData);
-    // don't handle failures - buffer should always be big enough and arguments
-    // should be provided correctly
-    int ret =
-        snprintf(buffer, kTmpStrBufferSize,
-                 "%s P50 : %f P95 : %f P99 : %f P100 : %f COUNT : %" PRIu64
-                 " SUM : %" PRIu64 "\n",
-                 h.second.c_str(), hData.median, hData.percentile95,
-                 hData.percentile99, hData.max, hData.count, hData.sum);
-    if (ret < 0 || ret >= kTmpStrBufferSize) {
-      assert(false);
+    AppendHistogramLine(h.second, *getHistogramImplLocked(h.first), &res);
+  }
+  res.shrink_to_fit();
+  return res;
+}
+
+std::string StatisticsImpl::HistogramsToIntervalString(
+    StatisticsHistogramSnapshot* snapshot) const {
+  assert(snapshot);
+  MutexLock lock(&aggregate_lock_);
+  std::string res;
+  for (const auto& h : HistogramsNameMap) {
+    assert(h.first < HISTOGRAM_ENUM_MAX);
+    HistogramImpl& older = snapshot->histograms_[h.first];
+    std::unique_ptr<HistogramImpl> current = getHistogramImplLocked(h.first);
+    if (current->num() == older.num()) {
       continue;
     }
-    res.append(buffer);
+    HistogramImpl interval;
+    interval.Merge(*current);
+    interval.Subtract(older);
+    older.Clear();
+    older.Merge(*current);
+    if (!interval.Empty()) {
+      AppendHistogramLine(h.second, interval, &res);
+    }
   }
-  res.shrink_to_fit();
   return res;
 }
 
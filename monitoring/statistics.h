@@ -39,6 +39,12 @@ enum HistogramsInternal : uint32_t {
   INTERNAL_HISTOGRAM_ENUM_MAX
 };
 
+// A copy of the histograms of a StatisticsImpl at some point in time, used to
+// report the percentiles of the samples recorded since.
+struct StatisticsHistogramSnapshot {
+  HistogramImpl histograms_[HISTOGRAM_ENUM_MAX];
+};
+
 class StatisticsImpl : public Statistics {
  public:
   StatisticsImpl(std::shared_ptr<Statistics> stats);
@@ -69,6 +75,13 @@ class StatisticsImpl : public Statistics {
   virtual bool getTickerMap(std::map<std::string, uint64_t>*) const override;
   virtual bool HistEnabledForType(uint32_t type) const override;
 
+  // Formats the histograms like ToString(), but from only the samples
+  // recorded since `*snapshot` was taken, and then updates `*snapshot` to the
+  // current state. Histograms without such samples are left out. A
+  // default-constructed snapshot reports everything recorded so far.
+  std::string HistogramsToIntervalString(
+      StatisticsHistogramSnapshot* snapshot) const;
+
   const Customizable* Inner() const override { return stats_.get(); }
 
  private:
@@ -6,6 +6,7 @@
 
 #include "rocksdb/statistics.h"
 
+#include "monitoring/statistics.h"
 #include "port/stack_trace.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/utilities/options_type.h"
@@ -40,6 +41,39 @@ TEST_F(StatisticsTest, SanityHistograms) {
   }
 }
 
+TEST_F(StatisticsTest, HistogramsToIntervalString) {
+  StatisticsImpl stats(nullptr);
+  StatisticsHistogramSnapshot snapshot;
+  ASSERT_EQ("", stats.HistogramsToIntervalString(&snapshot));
+
+  for (int i = 0; i < 100; i++) {
+    stats.recordInHistogram(DB_GET, 1000);
+  }
+  std::string interval = stats.HistogramsToIntervalString(&snapshot);
+  ASSERT_NE(std::string::npos,
+            interval.find("rocksdb.db.get.micros P50 : 1000.000000 P95 : "
+                          "1000.000000 P99 : 1000.000000 P100 : 1000.000000 "
+                          "COUNT : 100 SUM : 100000"));
+  ASSERT_EQ(std::string::npos, interval.find("rocksdb.db.write.micros"));
+
+  // Only the samples since the previous call are reported, even though the
+  // cumulative percentiles barely move
+  for (int i = 0; i < 10; i++) {
+    stats.recordInHistogram(DB_GET, 10);
+  }
+  interval = stats.HistogramsToIntervalString(&snapshot);
+  ASSERT_NE(std::string::npos,
+            interval.find("rocksdb.db.get.micros P50 : 10.000000 P95 : "
+                          "10.000000 P99 : 10.000000 P100 : 10.000000 "
+                          "COUNT : 10 SUM : 100"));
+  HistogramData cumulative;
+  stats.histogramData(DB_GET, &cumulative);
+  ASSERT_EQ(110, cumulative.count);
+  ASSERT_GT(cumulative.median, 500);
+
+  ASSERT_EQ("", stats.HistogramsToIntervalString(&snapshot));
+}
+
 TEST_F(StatisticsTest, NoNameStats) {
   static std::unordered_map<std::string, OptionTypeInfo> no_name_opt_info = {
 #ifndef ROCKSDB_LITE
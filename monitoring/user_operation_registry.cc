@@ -0,0 +1,157 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "monitoring/user_operation_registry.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "rocksdb/system_clock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+thread_local UserOperation* UserOperation::active_ = nullptr;
+
+UserOperation::UserOperation(UserOperationRegistry* registry, Type type,
+                             const std::string* cf_name) {
+  Register(registry, type, cf_name);
+}
+
+void UserOperation::Register(UserOperationRegistry* registry, Type type,
+                             const std::string* cf_name) {
+  if (registry == nullptr || registered()) {
+    return;
+  }
+  type_ = type;
+  cf_name_ = cf_name;
+  start_micros_ = registry->clock_->NowMicros();
+  registry->Add(this);
+  registry_ = registry;
+}
+
+void UserOperation::Unregister() {
+  if (!registered()) {
+    return;
+  }
+  assert(active_ != this);
+  registry_->Remove(this);
+  registry_ = nullptr;
+}
+
+const char* UserOperation::GetTypeName(Type type) {
+  switch (type) {
+    case kGet:
+      return "Get";
+    case kMultiGet:
+      return "MultiGet";
+    case kIterator:
+      return "Iterator";
+    case kIngestExternalFile:
+      return "IngestExternalFile";
+    case kSyncWal:
+      return "SyncWAL";
+    default:
+      assert(false);
+      return "Unknown";
+  }
+}
+
+const char* UserOperation::GetStageName(Stage stage) {
+  switch (stage) {
+    case kStageUnknown:
+      return "Unknown";
+    case kStageReadMemTables:
+      return "ReadMemTables";
+    case kStageReadSstFiles:
+      return "ReadSstFiles";
+    case kStagePrepareFiles:
+      return "PrepareFiles";
+    case kStageIngestFiles:
+      return "IngestFiles";
+    case kStageSyncWal:
+      return "SyncWAL";
+    default:
+      assert(false);
+      return "Unknown";
+  }
+}
+
+UserOperationRegistry::UserOperationRegistry(SystemClock* clock)
+    : clock_(clock) {
+  assert(clock_ != nullptr);
+}
+
+UserOperationRegistry::~UserOperationRegistry() {
+  // All operations must have finished, including iterators being destroyed
+#ifndef NDEBUG
+  for (size_t i = 0; i < shards_.Size(); ++i) {
+    const Shard* shard = shards_.AccessAtCore(i);
+    assert(shard->head.next_ == &shard->head);
+  }
+#endif  // NDEBUG
+}
+
+void UserOperationRegistry::Add(UserOperation* op) {
+  auto shard_and_index = shards_.AccessElementAndIndex();
+  Shard* shard = shard_and_index.first;
+  op->shard_ = shard_and_index.second;
+  std::lock_guard<std::mutex> lock(shard->mutex);
+  op->prev_ = shard->head.prev_;
+  op->next_ = &shard->head;
+  shard->head.prev_->next_ = op;
+  shard->head.prev_ = op;
+}
+
+void UserOperationRegistry::Remove(UserOperation* op) {
+  // The thread may have moved to another core since, so use the recorded one
+  Shard* shard = shards_.AccessAtCore(op->shard_);
+  std::lock_guard<std::mutex> lock(shard->mutex);
+  op->prev_->next_ = op->next_;
+  op->next_->prev_ = op->prev_;
+  op->prev_ = nullptr;
+  op->next_ = nullptr;
+}
+
+void UserOperationRegistry::ToString(std::string* out) const {
+  assert(out != nullptr);
+  const uint64_t now_micros = clock_->NowMicros();
+  // Lines by start time, merged from all the shards
+  std::vector<std::pair<uint64_t, std::string>> lines;
+  for (size_t i = 0; i < shards_.Size(); ++i) {
+    Shard* shard = shards_.AccessAtCore(i);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    for (const UserOperation* op = shard->head.next_; op != &shard->head;
+         op = op->next_) {
+      char buf[200];
+      snprintf(buf, sizeof(buf),
+               "%s cf=%s elapsed_micros=%" PRIu64
+               " stage=%s blocks_read=%" PRIu64 " bytes_read=%" PRIu64 "\n",
+               UserOperation::GetTypeName(op->type_),
+               op->cf_name_ != nullptr ? op->cf_name_->c_str() : "",
+               now_micros > op->start_micros_ ? now_micros - op->start_micros_
+                                              : 0,
+               UserOperation::GetStageName(
+                   op->stage_.load(std::memory_order_relaxed)),
+               op->blocks_read_.load(std::memory_order_relaxed),
+               op->bytes_read_.load(std::memory_order_relaxed));
+      lines.emplace_back(op->start_micros_, buf);
+    }
+  }
+  std::stable_sort(lines.begin(), lines.end(),
+                   [](const std::pair<uint64_t, std::string>& a,
+                      const std::pair<uint64_t, std::string>& b) {
+                     return a.first < b.first;
+                   });
+  for (const auto& line : lines) {
+    out->append(line.second);
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
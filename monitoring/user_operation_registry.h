@@ -0,0 +1,184 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// UserOperationRegistry keeps track of the user operations in flight on a DB,
+// such as Get()s, MultiGet()s, live iterators, file ingestions and WAL syncs,
+// together with how much they have read from SST files so far. It backs the
+// "rocksdb.live-user-operations" DB property, which complements
+// GetThreadList(): that only reports background flushes and compactions.
+//
+// An operation registers a UserOperation for as long as it is in flight, and
+// makes it the calling thread's active operation through
+// ActiveUserOperationGuard while running on that thread, so that block reads
+// deep in the table readers can be attributed to it without passing it down.
+//
+// Nothing is registered unless the DB tracks threads, and then operations are
+// kept in per-core lists so that concurrent reads do not serialize on a
+// shared lock.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "port/port.h"
+#include "rocksdb/rocksdb_namespace.h"
+#include "util/core_local.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class SystemClock;
+class UserOperationRegistry;
+
+class UserOperation {
+ public:
+  enum Type : int {
+    kGet = 0,
+    kMultiGet,
+    kIterator,
+    kIngestExternalFile,
+    kSyncWal,
+    kNumTypes,
+  };
+
+  enum Stage : int {
+    kStageUnknown = 0,
+    kStageReadMemTables,
+    kStageReadSstFiles,
+    kStagePrepareFiles,
+    kStageIngestFiles,
+    kStageSyncWal,
+    kNumStages,
+  };
+
+  // An operation that is not registered anywhere until Register() is called
+  UserOperation() {}
+  // Registers the operation right away if `registry` is not nullptr
+  UserOperation(UserOperationRegistry* registry, Type type,
+                const std::string* cf_name);
+  ~UserOperation() { Unregister(); }
+
+  // No copying allowed
+  UserOperation(const UserOperation&) = delete;
+  UserOperation& operator=(const UserOperation&) = delete;
+
+  // No-op if `registry` is nullptr or the operation is already registered.
+  // `cf_name` is nullptr for operations not specific to a column family, and
+  // otherwise has to outlive the registration; it is not copied.
+  void Register(UserOperationRegistry* registry, Type type,
+                const std::string* cf_name);
+  void Unregister();
+  bool registered() const { return registry_ != nullptr; }
+
+  void SetStage(Stage stage) {
+    if (registered()) {
+      stage_.store(stage, std::memory_order_relaxed);
+    }
+  }
+
+  void RecordBlockRead(uint64_t bytes) {
+    blocks_read_.fetch_add(1, std::memory_order_relaxed);
+    bytes_read_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  static const char* GetTypeName(Type type);
+  static const char* GetStageName(Stage stage);
+
+  // The operation that the calling thread is running, if any
+  static UserOperation* Active() { return active_; }
+
+ private:
+  friend class ActiveUserOperationGuard;
+  friend class UserOperationRegistry;
+
+  static thread_local UserOperation* active_;
+
+  UserOperationRegistry* registry_ = nullptr;
+  // The per-core list the operation was added to
+  size_t shard_ = 0;
+  // Guarded by the shard's mutex while registered
+  UserOperation* prev_ = nullptr;
+  UserOperation* next_ = nullptr;
+
+  Type type_ = kGet;
+  const std::string* cf_name_ = nullptr;
+  uint64_t start_micros_ = 0;
+  std::atomic<Stage> stage_{kStageUnknown};
+  std::atomic<uint64_t> blocks_read_{0};
+  std::atomic<uint64_t> bytes_read_{0};
+};
+
+// Makes a registered operation the calling thread's active operation for the
+// lifetime of this object. No-op for an unregistered operation.
+class ActiveUserOperationGuard {
+ public:
+  explicit ActiveUserOperationGuard(UserOperation* op)
+      : active_(op->registered()) {
+    if (active_) {
+      prev_ = UserOperation::active_;
+      UserOperation::active_ = op;
+    }
+  }
+  ~ActiveUserOperationGuard() {
+    if (active_) {
+      UserOperation::active_ = prev_;
+    }
+  }
+
+  // No copying allowed
+  ActiveUserOperationGuard(const ActiveUserOperationGuard&) = delete;
+  ActiveUserOperationGuard& operator=(const ActiveUserOperationGuard&) =
+      delete;
+
+ private:
+  const bool active_;
+  UserOperation* prev_ = nullptr;
+};
+
+// Attributes a block read from a file to the calling thread's active user
+// operation, if any.
+inline void RecordUserOperationBlockRead(uint64_t bytes) {
+  UserOperation* op = UserOperation::Active();
+  if (op != nullptr) {
+    op->RecordBlockRead(bytes);
+  }
+}
+
+class UserOperationRegistry {
+ public:
+  explicit UserOperationRegistry(SystemClock* clock);
+  ~UserOperationRegistry();
+
+  // No copying allowed
+  UserOperationRegistry(const UserOperationRegistry&) = delete;
+  UserOperationRegistry& operator=(const UserOperationRegistry&) = delete;
+
+  // Appends one line per registered operation to `out`, oldest first
+  void ToString(std::string* out) const;
+
+ private:
+  friend class UserOperation;
+
+  struct ALIGN_AS(CACHE_LINE_SIZE) Shard {
+    Shard() {
+      head.prev_ = &head;
+      head.next_ = &head;
+    }
+
+    std::mutex mutex;
+    // Sentinel of the circular list of registered operations, oldest first
+    UserOperation head;
+  };
+
+  void Add(UserOperation* op);
+  void Remove(UserOperation* op);
+
+  SystemClock* const clock_;
+  CoreLocalArray<Shard> shards_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -451,6 +451,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    blob_garbage_collection_force_threshold),
           OptionType::kDouble, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"blob_garbage_collection_file_ratio_threshold",
+         {offsetof(struct MutableCFOptions,
+                   blob_garbage_collection_file_ratio_threshold),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"blob_compaction_readahead_size",
          {offsetof(struct MutableCFOptions, blob_compaction_readahead_size),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
@@ -459,6 +464,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableCFOptions, blob_file_starting_level),
           OptionType::kInt, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"enable_wide_column_blob_files",
+         {offsetof(struct MutableCFOptions, enable_wide_column_blob_files),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"prepopulate_blob_cache",
          OptionTypeInfo::Enum<PrepopulateBlobCache>(
              offsetof(struct MutableCFOptions, prepopulate_blob_cache),
@@ -550,6 +559,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableCFOptions, inplace_update_support),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"inplace_merge_support",
+         {offsetof(struct ImmutableCFOptions, inplace_merge_support),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"level_compaction_dynamic_level_bytes",
          {offsetof(struct ImmutableCFOptions,
                    level_compaction_dynamic_level_bytes),
@@ -898,6 +911,7 @@ ImmutableCFOptions::ImmutableCFOptions(const ColumnFamilyOptions& cf_options)
       max_write_buffer_size_to_maintain(
           cf_options.max_write_buffer_size_to_maintain),
       inplace_update_support(cf_options.inplace_update_support),
+      inplace_merge_support(cf_options.inplace_merge_support),
       inplace_callback(cf_options.inplace_callback),
       memtable_factory(cf_options.memtable_factory),
       table_factory(cf_options.table_factory),
@@ -1123,10 +1137,14 @@ void MutableCFOptions::Dump(Logger* log) const {
                  blob_garbage_collection_age_cutoff);
   ROCKS_LOG_INFO(log, "  blob_garbage_collection_force_threshold: %f",
                  blob_garbage_collection_force_threshold);
+  ROCKS_LOG_INFO(log, "  blob_garbage_collection_file_ratio_threshold: %f",
+                 blob_garbage_collection_file_ratio_threshold);
   ROCKS_LOG_INFO(log, "           blob_compaction_readahead_size: %" PRIu64,
                  blob_compaction_readahead_size);
   ROCKS_LOG_INFO(log, "                 blob_file_starting_level: %d",
                  blob_file_starting_level);
+  ROCKS_LOG_INFO(log, "            enable_wide_column_blob_files: %s",
+                 enable_wide_column_blob_files ? "true" : "false");
   ROCKS_LOG_INFO(log, "                   prepopulate_blob_cache: %s",
                  prepopulate_blob_cache == PrepopulateBlobCache::kFlushOnly
                      ? "flush only"
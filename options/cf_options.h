@@ -46,6 +46,8 @@ struct ImmutableCFOptions {
 
   bool inplace_update_support;
 
+  bool inplace_merge_support;
+
   UpdateStatus (*inplace_callback)(char* existing_value,
                                    uint32_t* existing_value_size,
                                    Slice delta_value,
@@ -151,8 +153,11 @@ struct MutableCFOptions {
             options.blob_garbage_collection_age_cutoff),
         blob_garbage_collection_force_threshold(
             options.blob_garbage_collection_force_threshold),
+        blob_garbage_collection_file_ratio_threshold(
+            options.blob_garbage_collection_file_ratio_threshold),
         blob_compaction_readahead_size(options.blob_compaction_readahead_size),
         blob_file_starting_level(options.blob_file_starting_level),
+        enable_wide_column_blob_files(options.enable_wide_column_blob_files),
         prepopulate_blob_cache(options.prepopulate_blob_cache),
         max_sequential_skip_in_iterations(
             options.max_sequential_skip_in_iterations),
@@ -209,8 +214,10 @@ struct MutableCFOptions {
         enable_blob_garbage_collection(false),
         blob_garbage_collection_age_cutoff(0.0),
         blob_garbage_collection_force_threshold(0.0),
+        blob_garbage_collection_file_ratio_threshold(1.0),
         blob_compaction_readahead_size(0),
         blob_file_starting_level(0),
+        enable_wide_column_blob_files(false),
         prepopulate_blob_cache(PrepopulateBlobCache::kDisable),
         max_sequential_skip_in_iterations(0),
         check_flush_compaction_key_order(true),
@@ -295,8 +302,10 @@ struct MutableCFOptions {
   bool enable_blob_garbage_collection;
   double blob_garbage_collection_age_cutoff;
   double blob_garbage_collection_force_threshold;
+  double blob_garbage_collection_file_ratio_threshold;
   uint64_t blob_compaction_readahead_size;
   int blob_file_starting_level;
+  bool enable_wide_column_blob_files;
   PrepopulateBlobCache prepopulate_blob_cache;
 
   // Misc options
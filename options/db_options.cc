@@ -558,6 +558,18 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, enforce_single_del_contracts),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"stats_get_breakdown_one_in",
+         {offsetof(struct ImmutableDBOptions, stats_get_breakdown_one_in),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"smooth_write_delay",
+         {offsetof(struct ImmutableDBOptions, smooth_write_delay),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"compacted_db_point_index",
+         {offsetof(struct ImmutableDBOptions, compacted_db_point_index),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 };
 
 const std::string OptionsHelper::kDBOptionsName = "DBOptions";
@@ -758,7 +770,10 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       checksum_handoff_file_types(options.checksum_handoff_file_types),
       lowest_used_cache_tier(options.lowest_used_cache_tier),
       compaction_service(options.compaction_service),
-      enforce_single_del_contracts(options.enforce_single_del_contracts) {
+      enforce_single_del_contracts(options.enforce_single_del_contracts),
+      stats_get_breakdown_one_in(options.stats_get_breakdown_one_in),
+      smooth_write_delay(options.smooth_write_delay),
+      compacted_db_point_index(options.compacted_db_point_index) {
   fs = env->GetFileSystem();
   clock = env->GetSystemClock().get();
   logger = info_log.get();
@@ -930,6 +945,13 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    db_host_id.c_str());
   ROCKS_LOG_HEADER(log, "            Options.enforce_single_del_contracts: %s",
                    enforce_single_del_contracts ? "true" : "false");
+  ROCKS_LOG_HEADER(log,
+                   "              Options.stats_get_breakdown_one_in: %" PRIu32,
+                   stats_get_breakdown_one_in);
+  ROCKS_LOG_HEADER(log, "                  Options.smooth_write_delay: %d",
+                   smooth_write_delay);
+  ROCKS_LOG_HEADER(log, "            Options.compacted_db_point_index: %d",
+                   compacted_db_point_index);
 }
 
 bool ImmutableDBOptions::IsWalDirSameAsDBPath() const {
@@ -106,6 +106,9 @@ struct ImmutableDBOptions {
   Logger* logger;
   std::shared_ptr<CompactionService> compaction_service;
   bool enforce_single_del_contracts;
+  uint32_t stats_get_breakdown_one_in;
+  bool smooth_write_delay;
+  bool compacted_db_point_index;
 
   bool IsWalDirSameAsDBPath() const;
   bool IsWalDirSameAsDBPath(const std::string& path) const;
@@ -48,6 +48,7 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       max_write_buffer_size_to_maintain(
           options.max_write_buffer_size_to_maintain),
       inplace_update_support(options.inplace_update_support),
+      inplace_merge_support(options.inplace_merge_support),
       inplace_update_num_locks(options.inplace_update_num_locks),
       experimental_mempurge_threshold(options.experimental_mempurge_threshold),
       inplace_callback(options.inplace_callback),
@@ -106,8 +107,11 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
           options.blob_garbage_collection_age_cutoff),
       blob_garbage_collection_force_threshold(
           options.blob_garbage_collection_force_threshold),
+      blob_garbage_collection_file_ratio_threshold(
+          options.blob_garbage_collection_file_ratio_threshold),
       blob_compaction_readahead_size(options.blob_compaction_readahead_size),
       blob_file_starting_level(options.blob_file_starting_level),
+      enable_wide_column_blob_files(options.enable_wide_column_blob_files),
       blob_cache(options.blob_cache),
       prepopulate_blob_cache(options.prepopulate_blob_cache) {
   assert(memtable_factory.get() != nullptr);
@@ -370,6 +374,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
     ROCKS_LOG_HEADER(log,
                      "                  Options.inplace_update_support: %d",
                      inplace_update_support);
+    ROCKS_LOG_HEADER(log,
+                     "                   Options.inplace_merge_support: %d",
+                     inplace_merge_support);
     ROCKS_LOG_HEADER(
         log,
         "                Options.inplace_update_num_locks: %" ROCKSDB_PRIszt,
@@ -426,11 +433,16 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                      blob_garbage_collection_age_cutoff);
     ROCKS_LOG_HEADER(log, "Options.blob_garbage_collection_force_threshold: %f",
                      blob_garbage_collection_force_threshold);
+    ROCKS_LOG_HEADER(
+        log, "Options.blob_garbage_collection_file_ratio_threshold: %f",
+        blob_garbage_collection_file_ratio_threshold);
     ROCKS_LOG_HEADER(
         log, "         Options.blob_compaction_readahead_size: %" PRIu64,
         blob_compaction_readahead_size);
     ROCKS_LOG_HEADER(log, "               Options.blob_file_starting_level: %d",
                      blob_file_starting_level);
+    ROCKS_LOG_HEADER(log, "          Options.enable_wide_column_blob_files: %s",
+                     enable_wide_column_blob_files ? "true" : "false");
     if (blob_cache) {
       ROCKS_LOG_HEADER(log, "                          Options.blob_cache: %s",
                        blob_cache->Name());
@@ -704,7 +716,8 @@ ReadOptions::ReadOptions()
       value_size_soft_limit(std::numeric_limits<uint64_t>::max()),
       adaptive_readahead(false),
       async_io(false),
-      optimize_multiget_for_io(true) {}
+      optimize_multiget_for_io(true),
+      pin_memtable_values(false) {}
 
 ReadOptions::ReadOptions(bool cksum, bool cache)
     : snapshot(nullptr),
@@ -730,6 +743,7 @@ ReadOptions::ReadOptions(bool cksum, bool cache)
       value_size_soft_limit(std::numeric_limits<uint64_t>::max()),
       adaptive_readahead(false),
       async_io(false),
-      optimize_multiget_for_io(true) {}
+      optimize_multiget_for_io(true),
+      pin_memtable_values(false) {}
 
 }  // namespace ROCKSDB_NAMESPACE
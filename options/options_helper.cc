@@ -186,6 +186,11 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.lowest_used_cache_tier = immutable_db_options.lowest_used_cache_tier;
   options.enforce_single_del_contracts =
       immutable_db_options.enforce_single_del_contracts;
+  options.stats_get_breakdown_one_in =
+      immutable_db_options.stats_get_breakdown_one_in;
+  options.smooth_write_delay = immutable_db_options.smooth_write_delay;
+  options.compacted_db_point_index =
+      immutable_db_options.compacted_db_point_index;
   return options;
 }
 
@@ -258,9 +263,13 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
       moptions.blob_garbage_collection_age_cutoff;
   cf_opts->blob_garbage_collection_force_threshold =
       moptions.blob_garbage_collection_force_threshold;
+  cf_opts->blob_garbage_collection_file_ratio_threshold =
+      moptions.blob_garbage_collection_file_ratio_threshold;
   cf_opts->blob_compaction_readahead_size =
       moptions.blob_compaction_readahead_size;
   cf_opts->blob_file_starting_level = moptions.blob_file_starting_level;
+  cf_opts->enable_wide_column_blob_files =
+      moptions.enable_wide_column_blob_files;
   cf_opts->prepopulate_blob_cache = moptions.prepopulate_blob_cache;
 
   // Misc options
@@ -295,6 +304,7 @@ void UpdateColumnFamilyOptions(const ImmutableCFOptions& ioptions,
   cf_opts->max_write_buffer_size_to_maintain =
       ioptions.max_write_buffer_size_to_maintain;
   cf_opts->inplace_update_support = ioptions.inplace_update_support;
+  cf_opts->inplace_merge_support = ioptions.inplace_merge_support;
   cf_opts->inplace_callback = ioptions.inplace_callback;
   cf_opts->memtable_factory = ioptions.memtable_factory;
   cf_opts->table_factory = ioptions.table_factory;
@@ -1198,7 +1198,8 @@ TEST_F(OptionsTest, GetPlainTableOptionsFromString) {
       config_options, table_opt,
       "user_key_len=66;bloom_bits_per_key=20;hash_table_ratio=0.5;"
       "index_sparseness=8;huge_page_tlb_size=4;encoding_type=kPrefix;"
-      "full_scan_mode=true;store_index_in_file=true",
+      "full_scan_mode=true;store_index_in_file=true;"
+      "key_fingerprint_index=true",
       &new_opt));
   ASSERT_EQ(new_opt.user_key_len, 66u);
   ASSERT_EQ(new_opt.bloom_bits_per_key, 20);
@@ -1208,6 +1209,7 @@ TEST_F(OptionsTest, GetPlainTableOptionsFromString) {
   ASSERT_EQ(new_opt.encoding_type, EncodingType::kPrefix);
   ASSERT_TRUE(new_opt.full_scan_mode);
   ASSERT_TRUE(new_opt.store_index_in_file);
+  ASSERT_TRUE(new_opt.key_fingerprint_index);
 
   // unknown option
   Status s = GetPlainTableOptionsFromString(
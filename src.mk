@@ -125,6 +125,7 @@ LIB_SOURCES =                                                   \
   memory/arena.cc                                               \
   memory/concurrent_arena.cc                                    \
   memory/jemalloc_nodump_allocator.cc                           \
+  memory/huge_page_slab_allocator.cc                            \
   memory/memkind_kmem_allocator.cc                              \
   memory/memory_allocator.cc                                    \
   memtable/alloc_tracker.cc                                     \
@@ -147,6 +148,7 @@ LIB_SOURCES =                                                   \
   monitoring/thread_status_updater_debug.cc                     \
   monitoring/thread_status_util.cc                              \
   monitoring/thread_status_util_debug.cc                        \
+  monitoring/user_operation_registry.cc                         \
   options/cf_options.cc                                         \
   options/configurable.cc                                       \
   options/customizable.cc                                       \
@@ -247,6 +249,7 @@ LIB_SOURCES =                                                   \
   util/threadpool_imp.cc                                        \
   util/xxhash.cc                                                \
   utilities/agg_merge/agg_merge.cc                              \
+  utilities/agg_merge/packed_numeric.cc                         \
   utilities/backup/backup_engine.cc                             \
   utilities/blob_db/blob_compaction_filter.cc                   \
   utilities/blob_db/blob_db.cc                                  \
@@ -282,12 +285,14 @@ LIB_SOURCES =                                                   \
   utilities/object_registry.cc                                  \
   utilities/option_change_migration/option_change_migration.cc  \
   utilities/options/options_util.cc                             \
+  utilities/partitioned_db/partitioned_db.cc                    \
   utilities/persistent_cache/block_cache_tier.cc                \
   utilities/persistent_cache/block_cache_tier_file.cc           \
   utilities/persistent_cache/block_cache_tier_metadata.cc       \
   utilities/persistent_cache/persistent_cache_tier.cc           \
   utilities/persistent_cache/volatile_tier_impl.cc              \
   utilities/simulator_cache/cache_simulator.cc                  \
+  utilities/simulator_cache/miss_ratio_curve_cache.cc           \
   utilities/simulator_cache/sim_cache.cc                        \
   utilities/table_properties_collectors/compact_on_deletion_collector.cc \
   utilities/trace/file_trace_reader_writer.cc                   \
@@ -599,6 +604,7 @@ TEST_MAIN_SOURCES =                                                     \
   utilities/object_registry_test.cc                                     \
   utilities/option_change_migration/option_change_migration_test.cc     \
   utilities/options/options_util_test.cc                                \
+  utilities/partitioned_db/partitioned_db_test.cc                       \
   utilities/persistent_cache/hash_table_test.cc                         \
   utilities/persistent_cache/persistent_cache_test.cc                   \
   utilities/simulator_cache/cache_simulator_test.cc                     \
@@ -620,6 +626,7 @@ TEST_MAIN_SOURCES_C = \
   db/c_test.c                                                           \
 
 MICROBENCH_SOURCES =                                          \
+  microbench/agg_merge_bench.cc                               \
   microbench/ribbon_bench.cc                                  \
   microbench/db_basic_bench.cc                                  \
 
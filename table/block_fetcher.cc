@@ -16,6 +16,7 @@
 #include "logging/logging.h"
 #include "memory/memory_allocator.h"
 #include "monitoring/perf_context_imp.h"
+#include "monitoring/user_operation_registry.h"
 #include "rocksdb/compression_type.h"
 #include "rocksdb/env.h"
 #include "table/block_based/block.h"
@@ -299,6 +300,7 @@ IOStatus BlockFetcher::ReadBlockContents() {
     }
 
     PERF_COUNTER_ADD(block_read_byte, block_size_with_trailer_);
+    RecordUserOperationBlockRead(block_size_with_trailer_);
     if (!io_status_.ok()) {
       return io_status_;
     }
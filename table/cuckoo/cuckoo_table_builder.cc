@@ -9,12 +9,14 @@
 #include <assert.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <string>
 #include <vector>
 
 #include "db/dbformat.h"
 #include "file/writable_file_writer.h"
+#include "port/port.h"
 #include "rocksdb/env.h"
 #include "rocksdb/table.h"
 #include "table/block_based/block_builder.h"
@@ -56,13 +58,14 @@ CuckooTableBuilder::CuckooTableBuilder(
     uint64_t (*get_slice_hash)(const Slice&, uint32_t, uint64_t),
     uint32_t column_family_id, const std::string& column_family_name,
     const std::string& db_id, const std::string& db_session_id,
-    uint64_t file_number)
+    uint64_t file_number, uint32_t build_threads)
     : num_hash_func_(2),
       file_(file),
       max_hash_table_ratio_(max_hash_table_ratio),
       max_num_hash_func_(max_num_hash_table),
       max_search_depth_(max_search_depth),
       cuckoo_block_size_(std::max(1U, cuckoo_block_size)),
+      build_threads_(std::max(1U, build_threads)),
       hash_table_size_(use_module_hash ? 0 : 2),
       is_last_level_file_(false),
       has_seen_first_key_(false),
@@ -199,20 +202,78 @@ Slice CuckooTableBuilder::GetValue(uint64_t idx) const {
       static_cast<size_t>(value_size_));
 }
 
+uint64_t CuckooTableBuilder::GetHash(uint64_t idx, uint32_t hash_cnt) const {
+  if (hash_cnt < num_cached_hash_func_) {
+    return hash_cache_[static_cast<size_t>(idx * num_cached_hash_func_ +
+                                           hash_cnt)];
+  }
+  return CuckooHash(GetUserKey(idx), hash_cnt, use_module_hash_,
+                    hash_table_size_, identity_as_first_hash_,
+                    get_slice_hash_);
+}
+
+void CuckooTableBuilder::ComputeHashCache() {
+  if (build_threads_ <= 1) {
+    return;
+  }
+  const uint32_t num_hash_func = num_hash_func_;
+  hash_cache_.resize(static_cast<size_t>(num_entries_ * num_hash_func));
+  // Threads take chunks of keys in turn, so that they finish together
+  const uint64_t kChunkSize = 1 << 16;
+  std::atomic<uint64_t> next_chunk{0};
+  auto compute_func = [&]() {
+    while (true) {
+      uint64_t begin = next_chunk.fetch_add(1) * kChunkSize;
+      if (begin >= num_entries_) {
+        break;
+      }
+      uint64_t end = std::min(begin + kChunkSize, num_entries_);
+      for (uint64_t idx = begin; idx < end; ++idx) {
+        Slice user_key = GetUserKey(idx);
+        for (uint32_t hash_cnt = 0; hash_cnt < num_hash_func; ++hash_cnt) {
+          hash_cache_[static_cast<size_t>(idx * num_hash_func + hash_cnt)] =
+              CuckooHash(user_key, hash_cnt, use_module_hash_,
+                         hash_table_size_, identity_as_first_hash_,
+                         get_slice_hash_);
+        }
+      }
+    }
+  };
+  const uint64_t num_threads = std::min<uint64_t>(
+      build_threads_, (num_entries_ + kChunkSize - 1) / kChunkSize);
+  std::vector<port::Thread> threads;
+  for (uint64_t i = 1; i < num_threads; i++) {
+    threads.emplace_back(compute_func);
+  }
+  compute_func();
+  for (auto& t : threads) {
+    t.join();
+  }
+  num_cached_hash_func_ = num_hash_func;
+}
+
 Status CuckooTableBuilder::MakeHashTable(std::vector<CuckooBucket>* buckets) {
   buckets->resize(
       static_cast<size_t>(hash_table_size_ + cuckoo_block_size_ - 1));
+  ComputeHashCache();
+  // How many keys ahead the first bucket of a key is prefetched, when the
+  // hash values are known up front
+  const uint32_t kPrefetchDistance = 16;
   uint32_t make_space_for_key_call_id = 0;
   for (uint32_t vector_idx = 0; vector_idx < num_entries_; vector_idx++) {
+    if (num_cached_hash_func_ > 0 &&
+        vector_idx + kPrefetchDistance < num_entries_) {
+      PREFETCH(&(*buckets)[static_cast<size_t>(
+                   GetHash(vector_idx + kPrefetchDistance, 0))],
+               1 /* rw */, 1 /* locality */);
+    }
     uint64_t bucket_id = 0;
     bool bucket_found = false;
     autovector<uint64_t> hash_vals;
     Slice user_key = GetUserKey(vector_idx);
     for (uint32_t hash_cnt = 0; hash_cnt < num_hash_func_ && !bucket_found;
          ++hash_cnt) {
-      uint64_t hash_val =
-          CuckooHash(user_key, hash_cnt, use_module_hash_, hash_table_size_,
-                     identity_as_first_hash_, get_slice_hash_);
+      uint64_t hash_val = GetHash(vector_idx, hash_cnt);
       // If there is a collision, check next cuckoo_block_size_ locations for
       // empty locations. While checking, if we reach end of the hash table,
       // stop searching and proceed for next hash function.
@@ -242,9 +303,7 @@ Status CuckooTableBuilder::MakeHashTable(std::vector<CuckooBucket>* buckets) {
       }
       // We don't really need to rehash the entire table because old hashes are
       // still valid and we only increased the number of hash functions.
-      uint64_t hash_val = CuckooHash(user_key, num_hash_func_, use_module_hash_,
-                                     hash_table_size_, identity_as_first_hash_,
-                                     get_slice_hash_);
+      uint64_t hash_val = GetHash(vector_idx, num_hash_func_);
       ++num_hash_func_;
       for (uint32_t block_idx = 0; block_idx < cuckoo_block_size_;
            ++block_idx, ++hash_val) {
@@ -275,6 +334,10 @@ Status CuckooTableBuilder::Finish() {
           static_cast<uint64_t>(num_entries_ / max_hash_table_ratio_);
     }
     status_ = MakeHashTable(&buckets);
+    // Not needed past the layout
+    hash_cache_.clear();
+    hash_cache_.shrink_to_fit();
+    num_cached_hash_func_ = 0;
     if (!status_.ok()) {
       return status_;
     }
@@ -492,9 +555,7 @@ bool CuckooTableBuilder::MakeSpaceForKey(
         (*buckets)[static_cast<size_t>(curr_node.bucket_id)];
     for (uint32_t hash_cnt = 0; hash_cnt < num_hash_func_ && !null_found;
          ++hash_cnt) {
-      uint64_t child_bucket_id = CuckooHash(
-          GetUserKey(curr_bucket.vector_idx), hash_cnt, use_module_hash_,
-          hash_table_size_, identity_as_first_hash_, get_slice_hash_);
+      uint64_t child_bucket_id = GetHash(curr_bucket.vector_idx, hash_cnt);
       // Iterate inside Cuckoo Block.
       for (uint32_t block_idx = 0; block_idx < cuckoo_block_size_;
            ++block_idx, ++child_bucket_id) {
@@ -32,7 +32,7 @@ class CuckooTableBuilder : public TableBuilder {
       uint64_t (*get_slice_hash)(const Slice&, uint32_t, uint64_t),
       uint32_t column_family_id, const std::string& column_family_name,
       const std::string& db_id = "", const std::string& db_session_id = "",
-      uint64_t file_number = 0);
+      uint64_t file_number = 0, uint32_t build_threads = 1);
   // No copying allowed
   CuckooTableBuilder(const CuckooTableBuilder&) = delete;
   void operator=(const CuckooTableBuilder&) = delete;
@@ -92,6 +92,9 @@ class CuckooTableBuilder : public TableBuilder {
                        const uint32_t call_id,
                        std::vector<CuckooBucket>* buckets, uint64_t* bucket_id);
   Status MakeHashTable(std::vector<CuckooBucket>* buckets);
+  // Fills hash_cache_ using build_threads_ threads
+  void ComputeHashCache();
+  inline uint64_t GetHash(uint64_t idx, uint32_t hash_cnt) const;
 
   inline bool IsDeletedKey(uint64_t idx) const;
   inline Slice GetKey(uint64_t idx) const;
@@ -104,6 +107,7 @@ class CuckooTableBuilder : public TableBuilder {
   const uint32_t max_num_hash_func_;
   const uint32_t max_search_depth_;
   const uint32_t cuckoo_block_size_;
+  const uint32_t build_threads_;
   uint64_t hash_table_size_;
   bool is_last_level_file_;
   bool has_seen_first_key_;
@@ -127,6 +131,10 @@ class CuckooTableBuilder : public TableBuilder {
   bool identity_as_first_hash_;
   uint64_t (*get_slice_hash_)(const Slice& s, uint32_t index,
                               uint64_t max_num_buckets);
+  // Hash values of the keys for the first num_cached_hash_func_ hash
+  // functions, in key index order. Only used with more than one build thread
+  std::vector<uint64_t> hash_cache_;
+  uint32_t num_cached_hash_func_ = 0;
   std::string largest_user_key_ = "";
   std::string smallest_user_key_ = "";
 
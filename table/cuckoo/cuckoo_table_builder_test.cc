@@ -621,6 +621,38 @@ TEST_F(CuckooBuilderTest, FailWhenSameKeyInserted) {
   ASSERT_TRUE(builder.Finish().IsNotSupported());
   ASSERT_OK(file_writer->Close());
 }
+
+TEST_F(CuckooBuilderTest, ParallelBuildWritesSameFile) {
+  // Enough keys for several chunks of hash values
+  const uint64_t kNumKeys = 200000;
+  std::string contents[2];
+  for (uint32_t build_threads : {1, 4}) {
+    fname = test::PerThreadDBPath("ParallelBuild" +
+                                  std::to_string(build_threads));
+    std::unique_ptr<WritableFileWriter> file_writer;
+    ASSERT_OK(WritableFileWriter::Create(env_->GetFileSystem(), fname,
+                                         file_options_, &file_writer, nullptr));
+    CuckooTableBuilder builder(
+        file_writer.get(), kHashTableRatio, 64, 100, BytewiseComparator(), 5,
+        true /* use_module_hash */, false, nullptr /* get_slice_hash */,
+        0 /* column_family_id */, kDefaultColumnFamilyName, "", "", 0,
+        build_threads);
+    ASSERT_OK(builder.status());
+    for (uint64_t i = 0; i < kNumKeys; i++) {
+      std::string user_key;
+      PutFixed64(&user_key, i);
+      builder.Add(Slice(GetInternalKey(user_key, true)),
+                  Slice(user_key.data(), 4));
+      ASSERT_OK(builder.status());
+    }
+    ASSERT_OK(builder.Finish());
+    ASSERT_OK(file_writer->Close());
+    ASSERT_OK(ReadFileToString(env_, fname,
+                               &contents[build_threads == 1 ? 0 : 1]));
+  }
+  ASSERT_FALSE(contents[0].empty());
+  ASSERT_TRUE(contents[0] == contents[1]);
+}
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
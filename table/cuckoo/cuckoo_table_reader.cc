@@ -53,6 +53,7 @@ CuckooTableReader::CuckooTableReader(
       cuckoo_block_bytes_minus_one_(0),
       table_size_(0),
       ucomp_(comparator),
+      bytewise_equal_(!comparator->CanKeysWithDifferentByteContentsBeEqual()),
       get_slice_hash_(get_slice_hash) {
   if (!ioptions.allow_mmap_reads) {
     status_ = Status::InvalidArgument("File is not mmaped");
@@ -161,13 +162,12 @@ Status CuckooTableReader::Get(const ReadOptions& /*readOptions*/,
     const char* bucket = &file_data_.data()[offset];
     for (uint32_t block_idx = 0; block_idx < cuckoo_block_size_;
          ++block_idx, bucket += bucket_length_) {
-      if (ucomp_->Equal(Slice(unused_key_.data(), user_key.size()),
-                        Slice(bucket, user_key.size()))) {
+      if (UserKeyEquals(Slice(unused_key_.data(), user_key.size()), bucket)) {
         return Status::OK();
       }
       // Here, we compare only the user key part as we support only one entry
       // per user key and we don't support snapshot.
-      if (ucomp_->Equal(user_key, Slice(bucket, user_key.size()))) {
+      if (UserKeyEquals(user_key, bucket)) {
         Slice value(bucket + key_length_, value_length_);
         if (is_last_level_) {
           // Sequence number is not stored at the last level, so we will use
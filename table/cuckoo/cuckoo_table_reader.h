@@ -9,6 +9,7 @@
 
 #pragma once
 #ifndef ROCKSDB_LITE
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -75,6 +76,13 @@ class CuckooTableReader : public TableReader {
  private:
   friend class CuckooTableIterator;
   void LoadAllKeys(std::vector<std::pair<Slice, uint32_t>>* key_to_bucket_id);
+  // Whether the bucket starts with user key `user_key`
+  bool UserKeyEquals(const Slice& user_key, const char* bucket) const {
+    if (bytewise_equal_) {
+      return memcmp(user_key.data(), bucket, user_key.size()) == 0;
+    }
+    return ucomp_->Equal(user_key, Slice(bucket, user_key.size()));
+  }
   std::unique_ptr<RandomAccessFileReader> file_;
   Slice file_data_;
   bool is_last_level_;
@@ -92,6 +100,9 @@ class CuckooTableReader : public TableReader {
   uint32_t cuckoo_block_bytes_minus_one_;
   uint64_t table_size_;
   const Comparator* ucomp_;
+  // Whether user keys are equal exactly when their bytes are, so that Get()
+  // can compare them without calling into the comparator
+  const bool bytewise_equal_;
   uint64_t (*get_slice_hash_)(const Slice& s, uint32_t index,
                               uint64_t max_num_buckets);
 };
@@ -40,6 +40,9 @@ DEFINE_bool(enable_perf, false, "Run Benchmark Tests too.");
 DEFINE_bool(write, false,
             "Should write new values to file in performance tests?");
 DEFINE_bool(identity_as_first_hash, true, "use identity as first hash");
+DEFINE_int32(build_threads, 4,
+             "Number of threads building the table in performance tests, "
+             "compared with one thread in TestBuildPerformance.");
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -409,9 +412,10 @@ std::string GetFileName(uint64_t num) {
 // Create last level file as we are interested in measuring performance of
 // last level file only.
 void WriteFile(const std::vector<std::string>& keys, const uint64_t num,
-               double hash_ratio) {
+               double hash_ratio, uint32_t build_threads = 1) {
   Options options;
   options.allow_mmap_reads = true;
+  Env* env = options.env;
   const auto& fs = options.env->GetFileSystem();
   FileOptions file_options(options);
   std::string fname = GetFileName(num);
@@ -422,8 +426,9 @@ void WriteFile(const std::vector<std::string>& keys, const uint64_t num,
   CuckooTableBuilder builder(
       file_writer.get(), hash_ratio, 64, 1000, test::Uint64Comparator(), 5,
       false, FLAGS_identity_as_first_hash, nullptr, 0 /* column_family_id */,
-      kDefaultColumnFamilyName);
+      kDefaultColumnFamilyName, "", "", 0, build_threads);
   ASSERT_OK(builder.status());
+  uint64_t start_time = env->NowMicros();
   for (uint64_t key_idx = 0; key_idx < num; ++key_idx) {
     // Value is just a part of key.
     builder.Add(Slice(keys[key_idx]), Slice(&keys[key_idx][0], 4));
@@ -433,6 +438,9 @@ void WriteFile(const std::vector<std::string>& keys, const uint64_t num,
   ASSERT_OK(builder.Finish());
   ASSERT_EQ(num, builder.NumEntries());
   ASSERT_OK(file_writer->Close());
+  fprintf(stderr,
+          "Building a table of %" PRIu64 " items took %.3fs with %u threads\n",
+          num, (env->NowMicros() - start_time) * 1e-6, build_threads);
 
   uint64_t file_size;
   ASSERT_OK(
@@ -547,7 +555,8 @@ TEST_F(CuckooReaderTest, TestReadPerformance) {
         Env::Default()->FileExists(GetFileName(num)).IsNotFound()) {
       std::vector<std::string> all_keys;
       GetKeys(num, &all_keys);
-      WriteFile(all_keys, num, hash_ratio);
+      WriteFile(all_keys, num, hash_ratio,
+                static_cast<uint32_t>(FLAGS_build_threads));
     }
     ReadKeys(num, 0);
     ReadKeys(num, 10);
@@ -557,6 +566,30 @@ TEST_F(CuckooReaderTest, TestReadPerformance) {
     fprintf(stderr, "\n");
   }
 }
+
+TEST_F(CuckooReaderTest, TestBuildPerformance) {
+  if (!FLAGS_enable_perf) {
+    return;
+  }
+  double hash_ratio = 0.95;
+  std::vector<uint64_t> nums = {16 * 1024 * 1024, 64 * 1024 * 1024};
+#ifndef NDEBUG
+  fprintf(
+      stdout,
+      "WARNING: Not compiled with DNDEBUG. Performance tests may be slow.\n");
+#endif
+  for (uint64_t num : nums) {
+    std::vector<std::string> all_keys;
+    GetKeys(num, &all_keys);
+    WriteFile(all_keys, num, hash_ratio, 1);
+    if (FLAGS_build_threads > 1) {
+      WriteFile(all_keys, num, hash_ratio,
+                static_cast<uint32_t>(FLAGS_build_threads));
+    }
+    ReadKeys(num, 0);
+    fprintf(stderr, "\n");
+  }
+}
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
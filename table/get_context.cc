@@ -310,14 +310,23 @@ bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
               Slice value_to_use = value;
 
               if (type == kTypeWideColumnEntity) {
-                Slice value_copy = value;
+                bool is_blob_index = false;
 
-                if (!WideColumnSerialization::GetValueOfDefaultColumn(
-                         value_copy, value_to_use)
-                         .ok()) {
-                  state_ = kCorrupt;
+                if (!GetValueOfDefaultColumn(value, &value_to_use,
+                                             &is_blob_index)) {
                   return false;
                 }
+
+                if (is_blob_index) {
+                  if (is_blob_index_ == nullptr) {
+                    state_ = kUnexpectedBlobIndex;
+                    return false;
+                  }
+
+                  // Only the default column is needed, which is fetched like
+                  // the value of a kTypeBlobIndex
+                  *is_blob_index_ = true;
+                }
               }
 
               if (LIKELY(value_pinner != nullptr)) {
@@ -330,7 +339,18 @@ bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
                 pinnable_val_->PinSelf(value_to_use);
               }
             } else if (columns_ != nullptr) {
-              if (type == kTypeWideColumnEntity) {
+              if (type == kTypeWideColumnEntity &&
+                  WideColumnSerialization::HasBlobIndices(value)) {
+                std::string resolved_entity;
+                if (!ResolveEntity(value, &resolved_entity)) {
+                  return false;
+                }
+
+                if (!columns_->SetWideColumnValue(resolved_entity).ok()) {
+                  state_ = kCorrupt;
+                  return false;
+                }
+              } else if (type == kTypeWideColumnEntity) {
                 if (!columns_->SetWideColumnValue(value, value_pinner).ok()) {
                   state_ = kCorrupt;
                   return false;
@@ -351,17 +371,28 @@ bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
               Slice blob_value(pin_val);
               push_operand(blob_value, nullptr);
             } else if (type == kTypeWideColumnEntity) {
-              Slice value_copy = value;
               Slice value_of_default;
+              bool is_blob_index = false;
 
-              if (!WideColumnSerialization::GetValueOfDefaultColumn(
-                       value_copy, value_of_default)
-                       .ok()) {
-                state_ = kCorrupt;
+              if (!GetValueOfDefaultColumn(value, &value_of_default,
+                                           &is_blob_index)) {
                 return false;
               }
 
-              push_operand(value_of_default, value_pinner);
+              if (is_blob_index) {
+                if (is_blob_index_ == nullptr) {
+                  state_ = kUnexpectedBlobIndex;
+                  return false;
+                }
+                PinnableSlice pin_val;
+                if (GetBlobValue(value_of_default, &pin_val) == false) {
+                  return false;
+                }
+                Slice blob_value(pin_val);
+                push_operand(blob_value, nullptr);
+              } else {
+                push_operand(value_of_default, value_pinner);
+              }
             } else {
               assert(type == kTypeValue);
               push_operand(value, value_pinner);
@@ -393,17 +424,28 @@ bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
               // It means this function is called as part of DB GetMergeOperands
               // API and the current value should be part of
               // merge_context_->operand_list
-              Slice value_copy = value;
               Slice value_of_default;
+              bool is_blob_index = false;
 
-              if (!WideColumnSerialization::GetValueOfDefaultColumn(
-                       value_copy, value_of_default)
-                       .ok()) {
-                state_ = kCorrupt;
+              if (!GetValueOfDefaultColumn(value, &value_of_default,
+                                           &is_blob_index)) {
                 return false;
               }
 
-              push_operand(value_of_default, value_pinner);
+              if (is_blob_index) {
+                if (is_blob_index_ == nullptr) {
+                  state_ = kUnexpectedBlobIndex;
+                  return false;
+                }
+                PinnableSlice pin_val;
+                if (GetBlobValue(value_of_default, &pin_val) == false) {
+                  return false;
+                }
+                Slice blob_value(pin_val);
+                push_operand(blob_value, nullptr);
+              } else {
+                push_operand(value_of_default, value_pinner);
+              }
             }
           } else {
             assert(type == kTypeValue);
@@ -487,6 +529,15 @@ void GetContext::MergeWithEntity(Slice entity) {
   assert(do_merge_);
   assert(!pinnable_val_ || !columns_);
 
+  std::string resolved_entity;
+  if (WideColumnSerialization::HasBlobIndices(entity)) {
+    if (!ResolveEntity(entity, &resolved_entity)) {
+      return;
+    }
+
+    entity = resolved_entity;
+  }
+
   const Status s = MergeHelper::TimedFullMergeWithEntity(
       merge_operator_, user_key_, entity, merge_context_->GetOperands(),
       pinnable_val_ ? pinnable_val_->GetSelf() : nullptr, columns_, logger_,
@@ -521,6 +572,69 @@ bool GetContext::GetBlobValue(const Slice& blob_index,
   return true;
 }
 
+bool GetContext::GetValueOfDefaultColumn(const Slice& entity, Slice* value,
+                                         bool* is_blob_index) {
+  assert(value);
+  assert(is_blob_index);
+
+  Slice entity_copy = entity;
+
+  if (!WideColumnSerialization::HasBlobIndices(entity)) {
+    *is_blob_index = false;
+
+    if (!WideColumnSerialization::GetValueOfDefaultColumn(entity_copy, *value)
+             .ok()) {
+      state_ = kCorrupt;
+      return false;
+    }
+
+    return true;
+  }
+
+  WideColumns columns;
+  std::vector<WideColumnSerialization::ColumnValueType> value_types;
+
+  if (!WideColumnSerialization::DeserializeWithBlobIndices(entity_copy, columns,
+                                                           value_types)
+           .ok()) {
+    state_ = kCorrupt;
+    return false;
+  }
+
+  if (columns.empty() || columns[0].name() != kDefaultWideColumnName) {
+    value->clear();
+    *is_blob_index = false;
+    return true;
+  }
+
+  *value = columns[0].value();
+  *is_blob_index = value_types[0] == WideColumnSerialization::kColumnBlobIndex;
+
+  return true;
+}
+
+bool GetContext::ResolveEntity(const Slice& entity,
+                               std::string* resolved_entity) {
+  if (blob_fetcher_ == nullptr) {
+    state_ = kUnexpectedBlobIndex;
+    return false;
+  }
+
+  constexpr uint64_t* bytes_read = nullptr;
+
+  const Status status = blob_fetcher_->ResolveEntity(
+      user_key_, entity, resolved_entity, bytes_read);
+  if (!status.ok()) {
+    if (status.IsIncomplete()) {
+      MarkKeyMayExist();
+      return false;
+    }
+    state_ = kCorrupt;
+    return false;
+  }
+  return true;
+}
+
 void GetContext::push_operand(const Slice& value, Cleanable* value_pinner) {
   // TODO(yanqin) preserve timestamps information in merge_context
   if (pinned_iters_mgr() && pinned_iters_mgr()->PinningEnabled() &&
@@ -185,6 +185,13 @@ class GetContext {
   void Merge(const Slice* value);
   void MergeWithEntity(Slice entity);
   bool GetBlobValue(const Slice& blob_index, PinnableSlice* blob_value);
+  // Sets `value` to the value of the default column of `entity`. If that
+  // value is stored in a blob file, sets `value` to its blob index and
+  // `is_blob_index` to true instead.
+  bool GetValueOfDefaultColumn(const Slice& entity, Slice* value,
+                               bool* is_blob_index);
+  // Fetches the column values of `entity` stored in blob files
+  bool ResolveEntity(const Slice& entity, std::string* resolved_entity);
 
   const Comparator* ucmp_;
   const MergeOperator* merge_operator_;
@@ -49,6 +49,10 @@ static std::unordered_map<std::string, OptionTypeInfo> plain_table_type_info = {
      {offsetof(struct PlainTableOptions, store_index_in_file),
       OptionType::kBoolean, OptionVerificationType::kNormal,
       OptionTypeFlags::kNone}},
+    {"key_fingerprint_index",
+     {offsetof(struct PlainTableOptions, key_fingerprint_index),
+      OptionType::kBoolean, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
 };
 
 PlainTableFactory::PlainTableFactory(const PlainTableOptions& options)
@@ -67,7 +71,8 @@ Status PlainTableFactory::NewTableReader(
       table, table_options_.bloom_bits_per_key, table_options_.hash_table_ratio,
       table_options_.index_sparseness, table_options_.huge_page_tlb_size,
       table_options_.full_scan_mode, table_reader_options.immortal,
-      table_reader_options.prefix_extractor.get());
+      table_reader_options.prefix_extractor.get(),
+      table_options_.key_fingerprint_index);
 }
 
 TableBuilder* PlainTableFactory::NewTableBuilder(
@@ -120,6 +125,9 @@ std::string PlainTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  store_index_in_file: %d\n",
            table_options_.store_index_in_file);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  key_fingerprint_index: %d\n",
+           table_options_.key_fingerprint_index);
+  ret.append(buffer);
   return ret;
 }
 
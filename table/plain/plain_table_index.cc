@@ -7,6 +7,7 @@
 #include "table/plain/plain_table_index.h"
 
 #include <cinttypes>
+#include <cstring>
 
 #include "logging/logging.h"
 #include "util/coding.h"
@@ -54,6 +55,40 @@ PlainTableIndex::IndexSearchResult PlainTableIndex::GetOffset(
   }
 }
 
+void PlainTableKeyIndex::Init(
+    const std::vector<std::pair<uint64_t, uint32_t>>& entries, Arena* arena,
+    size_t huge_page_tlb_size, Logger* logger) {
+  // Fill the buckets to about 80% on average, which keeps most probes
+  // within the home bucket
+  num_buckets_ = entries.size() * 5 / (kSlotsPerBucket * 4) + 1;
+  assert(num_buckets_ * kSlotsPerBucket > entries.size());
+  size_t bytes = num_buckets_ * sizeof(Bucket);
+  char* raw = arena->AllocateAligned(bytes + CACHE_LINE_SIZE - 1,
+                                     huge_page_tlb_size, logger);
+  auto cache_line_offset = reinterpret_cast<uintptr_t>(raw) % CACHE_LINE_SIZE;
+  if (cache_line_offset > 0) {
+    raw += CACHE_LINE_SIZE - cache_line_offset;
+  }
+  memset(raw, 0, bytes);
+  buckets_ = reinterpret_cast<Bucket*>(raw);
+
+  for (const auto& entry : entries) {
+    uint16_t fingerprint = GetFingerprint(entry.first);
+    for (size_t i = GetHomeBucket(entry.first);; i = NextBucket(i)) {
+      Bucket& bucket = buckets_[i];
+      size_t slot = 0;
+      while (slot < kSlotsPerBucket && bucket.fingerprints[slot] != 0) {
+        ++slot;
+      }
+      if (slot < kSlotsPerBucket) {
+        bucket.fingerprints[slot] = fingerprint;
+        bucket.offsets[slot] = entry.second;
+        break;
+      }
+    }
+  }
+}
+
 void PlainTableIndexBuilder::IndexRecordList::AddRecord(uint32_t hash,
                                                         uint32_t offset) {
   if (num_records_in_current_group_ == kNumRecordsPerGroup) {
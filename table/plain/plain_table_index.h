@@ -8,12 +8,15 @@
 #ifndef ROCKSDB_LITE
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "memory/arena.h"
 #include "monitoring/histogram.h"
 #include "options/cf_options.h"
+#include "port/port.h"
 #include "rocksdb/options.h"
+#include "util/hash.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -120,6 +123,85 @@ class PlainTableIndex {
   char* sub_index_;
 };
 
+// PlainTableKeyIndex is an optional in-memory index for point lookups, see
+// PlainTableOptions::key_fingerprint_index. It maps every distinct user key
+// in the file to the offset of its first (newest) entry through an open
+// addressing hash table of cache line sized buckets, each holding 16-bit key
+// fingerprints and 32-bit file offsets:
+//
+// +----------------------------------+-------------------------------------+
+// | fingerprints (kSlotsPerBucket x  | file offsets (kSlotsPerBucket x     |
+// | fixed16, 0 for an empty slot)    | fixed32)                            |
+// +----------------------------------+-------------------------------------+
+//
+// A key is placed in the first empty slot starting from its home bucket, so
+// a lookup usually reads one cache line of the index and then decodes only
+// keys whose fingerprint matches from the file; a key absent from the file
+// is usually ruled out without decoding any key.
+class PlainTableKeyIndex {
+ public:
+  PlainTableKeyIndex() {}
+
+  // Builds the index from (HashKey(user_key), offset) pairs, one per
+  // distinct user key. The memory is allocated from `arena`.
+  void Init(const std::vector<std::pair<uint64_t, uint32_t>>& entries,
+            Arena* arena, size_t huge_page_tlb_size, Logger* logger);
+
+  bool IsInitialized() const { return buckets_ != nullptr; }
+
+  // Calls `callback(offset)` for the offset of every key whose fingerprint
+  // matches `hash`, which include the key hashing to `hash` if any, until
+  // `callback` returns true.
+  template <typename Callback>
+  void ForEachCandidate(uint64_t hash, Callback&& callback) const {
+    uint16_t fingerprint = GetFingerprint(hash);
+    // Init() leaves at least one slot empty, which ends every probe
+    for (size_t i = GetHomeBucket(hash);; i = NextBucket(i)) {
+      const Bucket& bucket = buckets_[i];
+      for (size_t slot = 0; slot < kSlotsPerBucket; ++slot) {
+        if (bucket.fingerprints[slot] == 0) {
+          return;
+        }
+        if (bucket.fingerprints[slot] == fingerprint &&
+            callback(bucket.offsets[slot])) {
+          return;
+        }
+      }
+    }
+  }
+
+  size_t GetNumBuckets() const { return num_buckets_; }
+
+  static uint64_t HashKey(const Slice& user_key) {
+    return GetSliceNPHash64(user_key);
+  }
+
+  static constexpr size_t kSlotsPerBucket =
+      CACHE_LINE_SIZE / (sizeof(uint16_t) + sizeof(uint32_t));
+
+ private:
+  struct alignas(CACHE_LINE_SIZE) Bucket {
+    uint16_t fingerprints[kSlotsPerBucket];
+    uint32_t offsets[kSlotsPerBucket];
+  };
+  static_assert(sizeof(Bucket) == CACHE_LINE_SIZE, "Bucket must fill a line");
+
+  size_t GetHomeBucket(uint64_t hash) const {
+    return FastRange32(Upper32of64(hash), static_cast<uint32_t>(num_buckets_));
+  }
+  size_t NextBucket(size_t i) const {
+    return i + 1 == num_buckets_ ? 0 : i + 1;
+  }
+  static uint16_t GetFingerprint(uint64_t hash) {
+    // 0 marks an empty slot
+    uint16_t fingerprint = static_cast<uint16_t>(hash);
+    return fingerprint == 0 ? 1 : fingerprint;
+  }
+
+  size_t num_buckets_ = 0;
+  Bucket* buckets_ = nullptr;
+};
+
 // PlainTableIndexBuilder is used to create plain table index.
 // After calling Finish(), it returns Slice, which is usually
 // used either to initialize PlainTableIndex or
@@ -121,7 +121,7 @@ Status PlainTableReader::Open(
     std::unique_ptr<TableReader>* table_reader, const int bloom_bits_per_key,
     double hash_table_ratio, size_t index_sparseness, size_t huge_page_tlb_size,
     bool full_scan_mode, const bool immortal_table,
-    const SliceTransform* prefix_extractor) {
+    const SliceTransform* prefix_extractor, bool key_fingerprint_index) {
   if (file_size > PlainTableIndex::kMaxFileSize) {
     return Status::NotSupported("File is too large for PlainTableReader!");
   }
@@ -171,7 +171,7 @@ Status PlainTableReader::Open(
   if (!full_scan_mode) {
     s = new_reader->PopulateIndex(props.get(), bloom_bits_per_key,
                                   hash_table_ratio, index_sparseness,
-                                  huge_page_tlb_size);
+                                  huge_page_tlb_size, key_fingerprint_index);
     if (!s.ok()) {
       return s;
     }
@@ -280,6 +280,30 @@ void PlainTableReader::FillBloom(const std::vector<uint32_t>& prefix_hashes) {
   }
 }
 
+Status PlainTableReader::PopulateKeyIndex(size_t huge_page_tlb_size) {
+  std::vector<std::pair<uint64_t, uint32_t>> entries;
+  std::string prev_user_key;
+  uint32_t pos = data_start_offset_;
+  PlainTableKeyDecoder decoder(&file_info_, encoding_type_, user_key_len_,
+                               prefix_extractor_);
+  while (pos < file_info_.data_end_offset) {
+    uint32_t key_offset = pos;
+    ParsedInternalKey key;
+    Slice value_slice;
+    Status s = Next(&decoder, &pos, &key, nullptr, &value_slice);
+    if (!s.ok()) {
+      return s;
+    }
+    if (entries.empty() || key.user_key != prev_user_key) {
+      entries.emplace_back(PlainTableKeyIndex::HashKey(key.user_key),
+                           key_offset);
+      prev_user_key.assign(key.user_key.data(), key.user_key.size());
+    }
+  }
+  key_index_.Init(entries, &arena_, huge_page_tlb_size, ioptions_.logger);
+  return Status::OK();
+}
+
 Status PlainTableReader::MmapDataIfNeeded() {
   if (file_info_.is_mmap_mode) {
     // Get mmapped memory.
@@ -294,7 +318,8 @@ Status PlainTableReader::PopulateIndex(TableProperties* props,
                                        int bloom_bits_per_key,
                                        double hash_table_ratio,
                                        size_t index_sparseness,
-                                       size_t huge_page_tlb_size) {
+                                       size_t huge_page_tlb_size,
+                                       bool key_fingerprint_index) {
   assert(props != nullptr);
 
   BlockContents index_block_contents;
@@ -421,6 +446,15 @@ Status PlainTableReader::PopulateIndex(TableProperties* props,
         std::to_string(0);
   }
 
+  // With kPrefix encoding, the first entry of a key may only be decodable
+  // from an earlier entry, so the key index cannot point at it
+  if (key_fingerprint_index && encoding_type_ == kPlain) {
+    s = PopulateKeyIndex(huge_page_tlb_size);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
   return Status::OK();
 }
 
@@ -501,6 +535,29 @@ Status PlainTableReader::GetOffset(PlainTableKeyDecoder* decoder,
   return Status::OK();
 }
 
+Status PlainTableReader::GetOffsetFromKeyIndex(PlainTableKeyDecoder* decoder,
+                                               const Slice& user_key,
+                                               uint32_t* offset) const {
+  *offset = file_info_.data_end_offset;
+  Status s;
+  key_index_.ForEachCandidate(
+      PlainTableKeyIndex::HashKey(user_key), [&](uint32_t candidate) {
+        ParsedInternalKey candidate_key;
+        uint32_t bytes_read;
+        s = decoder->NextKeyNoValue(candidate, &candidate_key, nullptr,
+                                    &bytes_read);
+        if (!s.ok()) {
+          return true;
+        }
+        if (candidate_key.user_key == user_key) {
+          *offset = candidate;
+          return true;
+        }
+        return false;
+      });
+  return s;
+}
+
 bool PlainTableReader::MatchBloom(uint32_t hash) const {
   if (!enable_bloom_) {
     return true;
@@ -549,35 +606,43 @@ Status PlainTableReader::Get(const ReadOptions& /*ro*/, const Slice& target,
                              GetContext* get_context,
                              const SliceTransform* /* prefix_extractor */,
                              bool /*skip_filters*/) {
-  // Check bloom filter first.
-  Slice prefix_slice;
-  uint32_t prefix_hash;
-  if (IsTotalOrderMode()) {
-    if (full_scan_mode_) {
-      status_ =
-          Status::InvalidArgument("Get() is not allowed in full scan mode.");
-    }
-    // Match whole user key for bloom filter check.
-    if (!MatchBloom(GetSliceHash(ExtractUserKey(target)))) {
-      return Status::OK();
-    }
-    // in total order mode, there is only one bucket 0, and we always use empty
-    // prefix.
-    prefix_slice = Slice();
-    prefix_hash = 0;
-  } else {
-    prefix_slice = GetPrefix(target);
-    prefix_hash = GetSliceHash(prefix_slice);
-    if (!MatchBloom(prefix_hash)) {
-      return Status::OK();
-    }
-  }
   uint32_t offset;
   bool prefix_match;
+  Slice prefix_slice;
   PlainTableKeyDecoder decoder(&file_info_, encoding_type_, user_key_len_,
                                prefix_extractor_);
-  Status s = GetOffset(&decoder, target, prefix_slice, prefix_hash,
-                       prefix_match, &offset);
+  Status s;
+  if (key_index_.IsInitialized()) {
+    // The key index rules out absent keys better than the bloom filter, and
+    // points at the first entry of the key itself
+    prefix_match = true;
+    s = GetOffsetFromKeyIndex(&decoder, ExtractUserKey(target), &offset);
+  } else {
+    // Check bloom filter first.
+    uint32_t prefix_hash;
+    if (IsTotalOrderMode()) {
+      if (full_scan_mode_) {
+        status_ =
+            Status::InvalidArgument("Get() is not allowed in full scan mode.");
+      }
+      // Match whole user key for bloom filter check.
+      if (!MatchBloom(GetSliceHash(ExtractUserKey(target)))) {
+        return Status::OK();
+      }
+      // in total order mode, there is only one bucket 0, and we always use
+      // empty prefix.
+      prefix_slice = Slice();
+      prefix_hash = 0;
+    } else {
+      prefix_slice = GetPrefix(target);
+      prefix_hash = GetSliceHash(prefix_slice);
+      if (!MatchBloom(prefix_hash)) {
+        return Status::OK();
+      }
+    }
+    s = GetOffset(&decoder, target, prefix_slice, prefix_hash, prefix_match,
+                  &offset);
+  }
 
   if (!s.ok()) {
     return s;
@@ -75,7 +75,8 @@ class PlainTableReader : public TableReader {
                      const int bloom_bits_per_key, double hash_table_ratio,
                      size_t index_sparseness, size_t huge_page_tlb_size,
                      bool full_scan_mode, const bool immortal_table = false,
-                     const SliceTransform* prefix_extractor = nullptr);
+                     const SliceTransform* prefix_extractor = nullptr,
+                     bool key_fingerprint_index = false);
 
   // Returns new iterator over table contents
   // compaction_readahead_size: its value will only be used if for_compaction =
@@ -134,7 +135,8 @@ class PlainTableReader : public TableReader {
 
   Status PopulateIndex(TableProperties* props, int bloom_bits_per_key,
                        double hash_table_ratio, size_t index_sparseness,
-                       size_t huge_page_tlb_size);
+                       size_t huge_page_tlb_size,
+                       bool key_fingerprint_index = false);
 
   Status MmapDataIfNeeded();
 
@@ -145,6 +147,8 @@ class PlainTableReader : public TableReader {
   Status status_;
 
   PlainTableIndex index_;
+  // Only initialized with PlainTableOptions::key_fingerprint_index
+  PlainTableKeyIndex key_index_;
   bool full_scan_mode_;
 
   // data_start_offset_ and data_end_offset_ defines the range of the
@@ -216,6 +220,9 @@ class PlainTableReader : public TableReader {
 
   void FillBloom(const std::vector<uint32_t>& prefix_hashes);
 
+  // Builds key_index_ from the offsets of the first entry of every user key
+  Status PopulateKeyIndex(size_t huge_page_tlb_size);
+
   // Read the key and value at `offset` to parameters for keys, the and
   // `seekable`.
   // On success, `offset` will be updated as the offset for the next key.
@@ -233,6 +240,10 @@ class PlainTableReader : public TableReader {
   Status GetOffset(PlainTableKeyDecoder* decoder, const Slice& target,
                    const Slice& prefix, uint32_t prefix_hash,
                    bool& prefix_matched, uint32_t* offset) const;
+  // Get file offset of the first entry for `user_key` from key_index_, or
+  // data_end_offset if there is no such entry.
+  Status GetOffsetFromKeyIndex(PlainTableKeyDecoder* decoder,
+                               const Slice& user_key, uint32_t* offset) const;
 
   bool IsTotalOrderMode() const { return (prefix_extractor_ == nullptr); }
 
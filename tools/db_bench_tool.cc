@@ -424,6 +424,10 @@ DEFINE_double(read_random_exp_range, 0.0,
 
 DEFINE_bool(histogram, false, "Print histogram of operation timings");
 
+DEFINE_bool(report_write_jitter, false,
+            "Time write operations and report how much their latency varies, "
+            "e.g. to compare write delay schemes under --smooth_write_delay");
+
 DEFINE_bool(confidence_interval_only, false,
             "Print 95% confidence interval upper and lower bounds only for "
             "aggregate stats.");
@@ -1086,6 +1090,12 @@ DEFINE_double(blob_garbage_collection_force_threshold,
               "[Integrated BlobDB] The threshold for the ratio of garbage in "
               "the oldest blob files for forcing garbage collection.");
 
+DEFINE_double(blob_garbage_collection_file_ratio_threshold,
+              ROCKSDB_NAMESPACE::AdvancedColumnFamilyOptions()
+                  .blob_garbage_collection_file_ratio_threshold,
+              "[Integrated BlobDB] The ratio of garbage in a blob file at "
+              "which it is garbage collected regardless of its age.");
+
 DEFINE_uint64(blob_compaction_readahead_size,
               ROCKSDB_NAMESPACE::AdvancedColumnFamilyOptions()
                   .blob_compaction_readahead_size,
@@ -1411,6 +1421,10 @@ DEFINE_uint64(delayed_write_rate, 8388608u,
               "Limited bytes allowed to DB when soft_rate_limit or "
               "level0_slowdown_writes_trigger triggers");
 
+DEFINE_bool(smooth_write_delay, ROCKSDB_NAMESPACE::Options().smooth_write_delay,
+            "Delay writes smoothly with the distance to the write stop "
+            "thresholds and the measured compaction throughput");
+
 DEFINE_bool(enable_pipelined_write, true,
             "Allow WAL and memtable writes to be pipelined");
 
@@ -1430,6 +1444,12 @@ DEFINE_bool(inplace_update_support,
             ROCKSDB_NAMESPACE::Options().inplace_update_support,
             "Support in-place memtable update for smaller or same-size values");
 
+DEFINE_bool(inplace_merge_support,
+            ROCKSDB_NAMESPACE::Options().inplace_merge_support,
+            "With --inplace_update_support, fold merge operands into the "
+            "newest memtable entry of the key in place when the result is no "
+            "larger");
+
 DEFINE_uint64(inplace_update_num_locks,
               ROCKSDB_NAMESPACE::Options().inplace_update_num_locks,
               "Number of RW locks to protect in-place memtable updates");
@@ -2267,7 +2287,7 @@ class Stats {
     if (reporter_agent_) {
       reporter_agent_->ReportFinishedOps(num_ops);
     }
-    if (FLAGS_histogram) {
+    if (FLAGS_histogram || FLAGS_report_write_jitter) {
       uint64_t now = clock_->NowMicros();
       uint64_t micros = now - last_op_finish_;
 
@@ -2418,6 +2438,17 @@ class Stats {
                 it->second->ToString().c_str());
       }
     }
+    if (FLAGS_report_write_jitter && hist_.find(kWrite) != hist_.end()) {
+      const HistogramImpl& hist = *hist_[kWrite];
+      double median = std::max(hist.Median(), 1.0);
+      fprintf(stdout,
+              "Write latency jitter: P99/P50 %.1f P99.99/P50 %.1f "
+              "StdDev/Avg %.2f Max %" PRIu64 " micros\n",
+              hist.Percentile(99) / median, hist.Percentile(99.99) / median,
+              hist.Average() > 0 ? hist.StandardDeviation() / hist.Average()
+                                 : 0.0,
+              hist.max());
+    }
     if (FLAGS_report_file_operations) {
       auto* counted_fs =
           FLAGS_env->GetFileSystem()->CheckedCast<CountedFileSystem>();
@@ -4550,11 +4581,13 @@ class Benchmark {
     options.hard_pending_compaction_bytes_limit =
         FLAGS_hard_pending_compaction_bytes_limit;
     options.delayed_write_rate = FLAGS_delayed_write_rate;
+    options.smooth_write_delay = FLAGS_smooth_write_delay;
     options.allow_concurrent_memtable_write =
         FLAGS_allow_concurrent_memtable_write;
     options.experimental_mempurge_threshold =
         FLAGS_experimental_mempurge_threshold;
     options.inplace_update_support = FLAGS_inplace_update_support;
+    options.inplace_merge_support = FLAGS_inplace_merge_support;
     options.inplace_update_num_locks = FLAGS_inplace_update_num_locks;
     options.enable_write_thread_adaptive_yield =
         FLAGS_enable_write_thread_adaptive_yield;
@@ -4645,6 +4678,8 @@ class Benchmark {
         FLAGS_blob_garbage_collection_age_cutoff;
     options.blob_garbage_collection_force_threshold =
         FLAGS_blob_garbage_collection_force_threshold;
+    options.blob_garbage_collection_file_ratio_threshold =
+        FLAGS_blob_garbage_collection_file_ratio_threshold;
     options.blob_compaction_readahead_size =
         FLAGS_blob_compaction_readahead_size;
     options.blob_file_starting_level = FLAGS_blob_file_starting_level;
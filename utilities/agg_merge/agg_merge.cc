@@ -89,12 +89,15 @@ class AggMergeOperator::Accumulator {
       return true;
     }
 
-    // Determine whether we need to do partial merge.
-    if (is_partial_aggregation && !my_func.empty()) {
+    // Determine whether we need to do partial merge. Consecutive operands
+    // usually share the function, which only needs to be looked up once.
+    if (is_partial_aggregation && !my_func.empty() &&
+        my_func != partial_func_) {
       auto f = func_map.find(my_func.ToString());
       if (f == func_map.end() || !f->second->DoPartialAggregate()) {
         return false;
       }
+      partial_func_ = my_func;
     }
 
     if (!func_valid_) {
@@ -149,6 +152,7 @@ class AggMergeOperator::Accumulator {
 
   void Clear() {
     func_.clear();
+    partial_func_.clear();
     values_.clear();
     aggregated_.clear();
     scratch_.clear();
@@ -158,6 +162,8 @@ class AggMergeOperator::Accumulator {
 
  private:
   Slice func_;
+  // The latest function found to allow partial aggregation
+  Slice partial_func_;
   std::vector<Slice> values_;
   std::string aggregated_;
   std::string scratch_;
@@ -126,6 +126,93 @@ TEST_F(AggMergeTest, TestUsingMergeOperator) {
   ASSERT_EQ(v, decoded_list[0]);
   ASSERT_EQ(v1, decoded_list[1]);
 }
+
+TEST_F(AggMergeTest, PackedNumeric) {
+  ASSERT_OK(AddAggregator("psum", NewPackedNumericAggregator(
+                                      PackedNumericAggregation::kSum)));
+  ASSERT_OK(AddAggregator("pmin", NewPackedNumericAggregator(
+                                      PackedNumericAggregation::kMin)));
+  ASSERT_OK(AddAggregator("pmax", NewPackedNumericAggregator(
+                                      PackedNumericAggregation::kMax)));
+  ASSERT_OK(AddAggregator("pcount", NewPackedNumericAggregator(
+                                        PackedNumericAggregation::kCount)));
+
+  Options options = CurrentOptions();
+  options.merge_operator = GetAggMergeOperator();
+  Reopen(options);
+
+  auto merge_ints = [&](const std::string& key, const std::string& func,
+                        const std::vector<int64_t>& values) {
+    std::string payload;
+    EncodePackedNumeric(values, payload);
+    std::string v;
+    ASSERT_OK(EncodeAggFuncAndPayload(func, payload, v));
+    ASSERT_OK(Merge(key, v));
+  };
+  auto get_ints = [&](const std::string& key, const std::string& func) {
+    std::string value = Get(key);
+    Slice f, payload;
+    std::vector<int64_t> values;
+    EXPECT_TRUE(ExtractAggFuncAndValue(value, f, payload));
+    EXPECT_EQ(func, f);
+    EXPECT_TRUE(DecodePackedNumeric(payload, values));
+    return values;
+  };
+
+  // Operands spread over the memtable and files, to be aggregated both
+  // partially and fully
+  for (const std::string func : {"psum", "pmin", "pmax", "pcount"}) {
+    merge_ints(func, func, {3, -4, 5});
+    merge_ints(func, func, {1, 7, -9});
+  }
+  ASSERT_OK(Flush());
+  for (const std::string func : {"psum", "pmin", "pmax", "pcount"}) {
+    merge_ints(func, func, {2, 0, 6});
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  for (const std::string func : {"psum", "pmin", "pmax", "pcount"}) {
+    merge_ints(func, func, {-10, 4, 1});
+  }
+  EXPECT_EQ(std::vector<int64_t>({-4, 7, 3}), get_ints("psum", "psum"));
+  EXPECT_EQ(std::vector<int64_t>({-10, -4, -9}), get_ints("pmin", "pmin"));
+  EXPECT_EQ(std::vector<int64_t>({3, 7, 6}), get_ints("pmax", "pmax"));
+  EXPECT_EQ(std::vector<int64_t>({4, 4, 4}), get_ints("pcount", "pcount"));
+
+  // Doubles
+  std::string payload;
+  std::string v;
+  EncodePackedNumeric(std::vector<double>{1.5, -2.0}, payload);
+  ASSERT_OK(EncodeAggFuncAndPayload("psum", payload, v));
+  ASSERT_OK(Merge("dsum", v));
+  EncodePackedNumeric(std::vector<double>{0.25, 4.0}, payload);
+  ASSERT_OK(EncodeAggFuncAndPayload("psum", payload, v));
+  ASSERT_OK(Merge("dsum", v));
+  std::string value = Get("dsum");
+  Slice func;
+  Slice result;
+  ASSERT_TRUE(ExtractAggFuncAndValue(value, func, result));
+  std::vector<double> doubles;
+  std::vector<int64_t> ints;
+  ASSERT_FALSE(DecodePackedNumeric(result, ints));
+  ASSERT_TRUE(DecodePackedNumeric(result, doubles));
+  EXPECT_EQ(std::vector<double>({1.75, 2.0}), doubles);
+
+  // Mismatched element counts or types fail the aggregation
+  merge_ints("bad", "psum", {1, 2});
+  merge_ints("bad", "psum", {1, 2, 3});
+  value = Get("bad");
+  ASSERT_TRUE(ExtractAggFuncAndValue(value, func, result));
+  EXPECT_EQ(kErrorFuncName, func);
+
+  merge_ints("bad2", "psum", {1});
+  EncodePackedNumeric(std::vector<double>{1.0}, payload);
+  ASSERT_OK(EncodeAggFuncAndPayload("psum", payload, v));
+  ASSERT_OK(Merge("bad2", v));
+  value = Get("bad2");
+  ASSERT_TRUE(ExtractAggFuncAndValue(value, func, result));
+  EXPECT_EQ(kErrorFuncName, func);
+}
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -0,0 +1,229 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/utilities/agg_merge.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// A packed numeric payload is a one byte element type followed by the
+// elements, each encoded with EncodeFixed64().
+enum PackedNumericType : char {
+  kPackedInt64 = 0,
+  kPackedDouble = 1,
+  // int64_t counts produced by PackedNumericAggregation::kCount
+  kPackedCount = 2,
+};
+
+constexpr size_t kElementSize = sizeof(uint64_t);
+
+// Returns false if `payload` is not a packed numeric payload
+bool ParsePackedNumeric(const Slice& payload, PackedNumericType* type,
+                        const char** elements, size_t* num_elements) {
+  if (payload.empty() || (payload.size() - 1) % kElementSize != 0) {
+    return false;
+  }
+  char t = payload[0];
+  if (t != kPackedInt64 && t != kPackedDouble && t != kPackedCount) {
+    return false;
+  }
+  *type = static_cast<PackedNumericType>(t);
+  *elements = payload.data() + 1;
+  *num_elements = (payload.size() - 1) / kElementSize;
+  return true;
+}
+
+template <typename T>
+inline T LoadElement(const char* p) {
+  static_assert(sizeof(T) == kElementSize, "");
+  uint64_t bits = DecodeFixed64(p);
+  T v;
+  memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+template <typename T>
+void EncodeElements(char type, const T* values, size_t n, std::string& output) {
+  output.resize(1 + n * kElementSize);
+  char* p = &output[0];
+  *p++ = type;
+  for (size_t i = 0; i < n; ++i, p += kElementSize) {
+    uint64_t bits;
+    memcpy(&bits, &values[i], sizeof(bits));
+    EncodeFixed64(p, bits);
+  }
+}
+
+template <typename T>
+bool DecodeElements(const Slice& payload, bool is_double,
+                    std::vector<T>& values) {
+  PackedNumericType type;
+  const char* elements;
+  size_t n;
+  if (!ParsePackedNumeric(payload, &type, &elements, &n) ||
+      (type == kPackedDouble) != is_double) {
+    return false;
+  }
+  values.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    values[i] = LoadElement<T>(elements + i * kElementSize);
+  }
+  return true;
+}
+
+// Applies `op` element-wise, acc[i] = op(acc[i], elements[i]). The loop has
+// no dependency between iterations, so it is vectorized by the compiler.
+template <typename T, typename Op>
+inline void ReduceElements(T* acc, const char* elements, size_t n, Op op) {
+  for (size_t i = 0; i < n; ++i) {
+    acc[i] = op(acc[i], LoadElement<T>(elements + i * kElementSize));
+  }
+}
+
+class PackedNumericAggregator : public Aggregator {
+ public:
+  explicit PackedNumericAggregator(PackedNumericAggregation aggregation)
+      : aggregation_(aggregation) {}
+
+  bool Aggregate(const std::vector<Slice>& values,
+                 std::string& result) const override {
+    if (values.empty()) {
+      return false;
+    }
+    PackedNumericType type;
+    const char* elements;
+    size_t n;
+    if (!ParsePackedNumeric(values.back(), &type, &elements, &n)) {
+      return false;
+    }
+    if (aggregation_ == PackedNumericAggregation::kCount) {
+      return Count(values, n, result);
+    }
+    // Counts aggregate like any int64_t values
+    bool is_double = type == kPackedDouble;
+    switch (aggregation_) {
+      case PackedNumericAggregation::kSum:
+        // Unsigned so that overflow wraps around
+        return is_double ? Reduce<double>(values, n, is_double, result,
+                                          [](double a, double b) {
+                                            return a + b;
+                                          })
+                         : Reduce<uint64_t>(values, n, is_double, result,
+                                            [](uint64_t a, uint64_t b) {
+                                              return a + b;
+                                            });
+      case PackedNumericAggregation::kMin:
+        return is_double ? Reduce<double>(values, n, is_double, result,
+                                          [](double a, double b) {
+                                            return b < a ? b : a;
+                                          })
+                         : Reduce<int64_t>(values, n, is_double, result,
+                                           [](int64_t a, int64_t b) {
+                                             return b < a ? b : a;
+                                           });
+      case PackedNumericAggregation::kMax:
+        return is_double ? Reduce<double>(values, n, is_double, result,
+                                          [](double a, double b) {
+                                            return b > a ? b : a;
+                                          })
+                         : Reduce<int64_t>(values, n, is_double, result,
+                                           [](int64_t a, int64_t b) {
+                                             return b > a ? b : a;
+                                           });
+      default:
+        return false;
+    }
+  }
+
+ private:
+  // Reduces the operands in the order of `values`, which AggMergeOperator
+  // fills oldest first. Double sums are rounded at each step, so they may
+  // differ in the last bits depending on which partial merges ran.
+  template <typename T, typename Op>
+  static bool Reduce(const std::vector<Slice>& values, size_t n,
+                     bool is_double, std::string& result, Op op) {
+    std::vector<T> acc(n);
+    for (auto it = values.begin(); it != values.end(); ++it) {
+      PackedNumericType type;
+      const char* elements;
+      size_t num_elements;
+      if (!ParsePackedNumeric(*it, &type, &elements, &num_elements) ||
+          num_elements != n || (type == kPackedDouble) != is_double) {
+        return false;
+      }
+      if (it == values.begin()) {
+        for (size_t i = 0; i < n; ++i) {
+          acc[i] = LoadElement<T>(elements + i * kElementSize);
+        }
+      } else {
+        ReduceElements(acc.data(), elements, n, op);
+      }
+    }
+    EncodeElements(is_double ? kPackedDouble : kPackedInt64, acc.data(), n,
+                   result);
+    return true;
+  }
+
+  static bool Count(const std::vector<Slice>& values, size_t n,
+                    std::string& result) {
+    std::vector<uint64_t> acc(n);
+    for (const Slice& value : values) {
+      PackedNumericType type;
+      const char* elements;
+      size_t num_elements;
+      if (!ParsePackedNumeric(value, &type, &elements, &num_elements) ||
+          num_elements != n) {
+        return false;
+      }
+      if (type == kPackedCount) {
+        ReduceElements(acc.data(), elements, n,
+                       [](uint64_t a, uint64_t b) { return a + b; });
+      } else {
+        for (size_t i = 0; i < n; ++i) {
+          ++acc[i];
+        }
+      }
+    }
+    EncodeElements(kPackedCount, acc.data(), n, result);
+    return true;
+  }
+
+  const PackedNumericAggregation aggregation_;
+};
+}  // namespace
+
+std::unique_ptr<Aggregator> NewPackedNumericAggregator(
+    PackedNumericAggregation aggregation) {
+  return std::unique_ptr<Aggregator>(new PackedNumericAggregator(aggregation));
+}
+
+void EncodePackedNumeric(const std::vector<int64_t>& values,
+                         std::string& output) {
+  EncodeElements(kPackedInt64, values.data(), values.size(), output);
+}
+
+void EncodePackedNumeric(const std::vector<double>& values,
+                         std::string& output) {
+  EncodeElements(kPackedDouble, values.data(), values.size(), output);
+}
+
+bool DecodePackedNumeric(const Slice& payload, std::vector<int64_t>& values) {
+  return DecodeElements(payload, /*is_double=*/false, values);
+}
+
+bool DecodePackedNumeric(const Slice& payload, std::vector<double>& values) {
+  return DecodeElements(payload, /*is_double=*/true, values);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
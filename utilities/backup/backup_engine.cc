@@ -584,6 +584,27 @@ class BackupEngineImpl {
                                       std::string* checksum_hex,
                                       const Temperature src_temperature) const;
 
+  // A file whose crc32c checksum is computed ahead of copying it
+  struct ChecksumWorkItem {
+    std::string src_path;
+    EnvOptions src_env_options;
+    uint64_t size_limit;
+    Temperature src_temperature;
+    std::string checksum_hex;
+
+    ChecksumWorkItem(std::string _src_path, const EnvOptions& _src_env_options,
+                     uint64_t _size_limit, Temperature _src_temperature)
+        : src_path(std::move(_src_path)),
+          src_env_options(_src_env_options),
+          size_limit(_size_limit),
+          src_temperature(_src_temperature) {}
+  };
+
+  // Fill in checksum_hex of each work item, reading up to
+  // max_background_operations files concurrently.
+  IOStatus ComputeChecksumsInParallel(
+      std::vector<ChecksumWorkItem>* work_items) const;
+
   // Obtain db_id and db_session_id from the table properties of file_path
   Status GetFileDbIdentities(Env* src_env, const EnvOptions& src_env_options,
                              const std::string& file_path,
@@ -1365,6 +1386,11 @@ IOStatus BackupEngineImpl::CreateNewBackupWithMetadata(
   std::unordered_set<std::string> live_dst_paths;
 
   std::vector<BackupAfterCopyOrCreateWorkItem> backup_items_to_finish;
+  // Files to be read up front to compute their crc32c checksum, and the
+  // AddBackupFileWorkItem calls waiting on those checksums, in checkpoint
+  // order.
+  std::vector<ChecksumWorkItem> files_to_checksum;
+  std::vector<std::function<IOStatus()>> deferred_work_items;
   // Add a CopyOrCreateWorkItem to the channel for each live file
   Status disabled = db->DisableFileDeletions();
   DBOptions db_options = db->GetDBOptions();
@@ -1435,27 +1461,64 @@ IOStatus BackupEngineImpl::CreateNewBackupWithMetadata(
               src_env_options = src_raw_env_options;
               break;
           }
-          io_st = AddBackupFileWorkItem(
-              live_dst_paths, backup_items_to_finish, new_backup_id,
-              options_.share_table_files &&
-                  (type == kTableFile || type == kBlobFile),
-              src_dirname, fname, src_env_options, rate_limiter, type,
-              size_bytes, db_options.statistics.get(), size_limit_bytes,
+          const bool shared = options_.share_table_files &&
+                              (type == kTableFile || type == kBlobFile);
+          const bool shared_checksum =
               options_.share_files_with_checksum &&
-                  (type == kTableFile || type == kBlobFile),
-              options.progress_callback, "" /* contents */, checksum_func_name,
-              checksum_val, src_temperature);
+              (type == kTableFile || type == kBlobFile);
+          // The shared_checksum name of a file without a DB session id in
+          // its name can only be derived from its contents. Unless the DB
+          // manifest already provides a crc32c checksum, the file has to be
+          // read in full, which we defer so that it can be done in parallel.
+          size_t checksum_idx = std::numeric_limits<size_t>::max();
+          if (shared && shared_checksum &&
+              checksum_func_name != kDbFileChecksumFuncName &&
+              (GetNamingNoFlags() ==
+                   BackupEngineOptions::kLegacyCrc32cAndFileSize ||
+               type == kBlobFile)) {
+            checksum_idx = files_to_checksum.size();
+            files_to_checksum.emplace_back(src_dirname + "/" + fname,
+                                           src_env_options, size_limit_bytes,
+                                           src_temperature);
+          }
+          deferred_work_items.emplace_back([&, shared, shared_checksum,
+                                            checksum_idx, src_dirname, fname,
+                                            src_env_options, type, size_bytes,
+                                            size_limit_bytes,
+                                            checksum_func_name, checksum_val,
+                                            src_temperature]() {
+            std::string src_checksum_func_name = checksum_func_name;
+            std::string src_checksum_str = checksum_val;
+            if (checksum_idx != std::numeric_limits<size_t>::max()) {
+              // Hand over the crc32c checksum as if it came from the DB
+              // manifest, so that it is also verified after copying.
+              src_checksum_func_name = kDbFileChecksumFuncName;
+              src_checksum_str.clear();
+              Slice(files_to_checksum[checksum_idx].checksum_hex)
+                  .DecodeHex(&src_checksum_str);
+            }
+            return AddBackupFileWorkItem(
+                live_dst_paths, backup_items_to_finish, new_backup_id, shared,
+                src_dirname, fname, src_env_options, rate_limiter, type,
+                size_bytes, db_options.statistics.get(), size_limit_bytes,
+                shared_checksum, options.progress_callback, "" /* contents */,
+                src_checksum_func_name, src_checksum_str, src_temperature);
+          });
           return io_st;
         } /* copy_file_cb */,
         [&](const std::string& fname, const std::string& contents,
             FileType type) {
           Log(options_.info_log, "add file for backup %s", fname.c_str());
-          return AddBackupFileWorkItem(
-              live_dst_paths, backup_items_to_finish, new_backup_id,
-              false /* shared */, "" /* src_dir */, fname,
-              EnvOptions() /* src_env_options */, rate_limiter, type,
-              contents.size(), db_options.statistics.get(), 0 /* size_limit */,
-              false /* shared_checksum */, options.progress_callback, contents);
+          deferred_work_items.emplace_back([&, fname, contents, type]() {
+            return AddBackupFileWorkItem(
+                live_dst_paths, backup_items_to_finish, new_backup_id,
+                false /* shared */, "" /* src_dir */, fname,
+                EnvOptions() /* src_env_options */, rate_limiter, type,
+                contents.size(), db_options.statistics.get(),
+                0 /* size_limit */, false /* shared_checksum */,
+                options.progress_callback, contents);
+          });
+          return IOStatus::OK();
         } /* create_file_cb */,
         &sequence_number,
         options.flush_before_backup ? 0 : std::numeric_limits<uint64_t>::max(),
@@ -1463,6 +1526,15 @@ IOStatus BackupEngineImpl::CreateNewBackupWithMetadata(
     if (io_s.ok()) {
       new_backup->SetSequenceNumber(sequence_number);
     }
+    if (io_s.ok()) {
+      io_s = ComputeChecksumsInParallel(&files_to_checksum);
+    }
+    for (auto& work_item : deferred_work_items) {
+      if (!io_s.ok()) {
+        break;
+      }
+      io_s = work_item();
+    }
   }
   ROCKS_LOG_INFO(options_.info_log, "add files for backup done, wait finish.");
   IOStatus item_io_status;
@@ -2421,6 +2493,48 @@ IOStatus BackupEngineImpl::ReadFileAndComputeChecksum(
   return io_s;
 }
 
+IOStatus BackupEngineImpl::ComputeChecksumsInParallel(
+    std::vector<ChecksumWorkItem>* work_items) const {
+  assert(work_items != nullptr);
+  if (work_items->empty()) {
+    return IOStatus::OK();
+  }
+  const size_t num_threads = std::min(
+      work_items->size(),
+      static_cast<size_t>(std::max(options_.max_background_operations, 1)));
+  std::vector<IOStatus> statuses(work_items->size());
+  std::atomic<size_t> next_item{0};
+  auto worker = [&]() {
+    for (size_t i = next_item.fetch_add(1); i < work_items->size();
+         i = next_item.fetch_add(1)) {
+      ChecksumWorkItem& item = (*work_items)[i];
+      TEST_SYNC_POINT_CALLBACK(
+          "BackupEngineImpl::ComputeChecksumsInParallel:Item", &item.src_path);
+      statuses[i] = ReadFileAndComputeChecksum(
+          item.src_path, db_fs_, item.src_env_options, item.size_limit,
+          &item.checksum_hex, item.src_temperature);
+    }
+  };
+  std::vector<port::Thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t t = 1; t < num_threads; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+  IOStatus io_s;
+  for (auto& s : statuses) {
+    if (io_s.ok()) {
+      io_s = s;
+    } else {
+      s.PermitUncheckedError();
+    }
+  }
+  return io_s;
+}
+
 Status BackupEngineImpl::GetFileDbIdentities(
     Env* src_env, const EnvOptions& src_env_options,
     const std::string& file_path, Temperature file_temp,
@@ -14,10 +14,13 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
 #include <utility>
@@ -1747,6 +1750,64 @@ TEST_F(BackupEngineTest, TableFileWithDbChecksumCorruptedDuringBackup) {
   }
 }
 
+TEST_F(BackupEngineTest, LegacyNamingChecksumsComputedInParallel) {
+  const int keys_iteration = 5000;
+  engine_options_->share_files_with_checksum_naming = kLegacyCrc32cAndFileSize;
+  engine_options_->max_background_operations = 4;
+  OpenDBAndBackupEngine(true /* destroy_old_data */, false /* dummy */,
+                        kShareWithChecksum);
+
+  // The first worker to hash a file waits for a second one to start, so the
+  // test only passes if files are hashed concurrently
+  std::mutex mutex;
+  std::condition_variable cv;
+  int in_callback = 0;
+  int max_in_callback = 0;
+  int files_hashed = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "BackupEngineImpl::ComputeChecksumsInParallel:Item",
+      [&](void* arg) {
+        const std::string* src_path = static_cast<std::string*>(arg);
+        ASSERT_TRUE(EndsWith(*src_path, ".sst") ||
+                    EndsWith(*src_path, ".blob"));
+        std::unique_lock<std::mutex> lock(mutex);
+        ++files_hashed;
+        ++in_callback;
+        max_in_callback = std::max(max_in_callback, in_callback);
+        cv.notify_all();
+        cv.wait_for(lock, std::chrono::seconds(10),
+                    [&]() { return max_in_callback >= 2; });
+        --in_callback;
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  for (int i = 0; i < 2; ++i) {
+    // Two table files per backup, so that each one has files to hash in
+    // parallel
+    int begin = keys_iteration * i;
+    FillDB(db_.get(), begin, begin + keys_iteration / 2);
+    ASSERT_OK(db_->Flush(FlushOptions()));
+    FillDB(db_.get(), begin + keys_iteration / 2, begin + keys_iteration);
+    ASSERT_OK(backup_engine_->CreateNewBackup(db_.get(), true));
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  // Without checksums in the DB manifest, every shared table and blob file
+  // has to be read to derive its backup file name, including on the
+  // incremental backup.
+  ASSERT_GE(files_hashed, 2 + 4);
+  ASSERT_GE(max_in_callback, 2);
+
+  // The checksums computed up front match the backed up files
+  ASSERT_OK(backup_engine_->VerifyBackup(1, true /* verify_with_checksum */));
+  ASSERT_OK(backup_engine_->VerifyBackup(2, true /* verify_with_checksum */));
+
+  CloseDBAndBackupEngine();
+  AssertBackupConsistency(1, 0, keys_iteration, keys_iteration * 2);
+  AssertBackupConsistency(2, 0, keys_iteration * 2, keys_iteration * 3);
+}
+
 TEST_F(BackupEngineTest, InterruptCreationTest) {
   // Interrupt backup creation by failing new writes and failing cleanup of the
   // partial state. Then verify a subsequent backup can still succeed.
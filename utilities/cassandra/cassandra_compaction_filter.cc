@@ -40,23 +40,21 @@ CompactionFilter::Decision CassandraCompactionFilter::FilterV2(
     const Slice& existing_value, std::string* new_value,
     std::string* /*skip_until*/) const {
   bool value_changed = false;
-  RowValue row_value =
-      RowValue::Deserialize(existing_value.data(), existing_value.size());
-  RowValue compacted =
-      options_.purge_ttl_on_expiration
-          ? row_value.RemoveExpiredColumns(&value_changed)
-          : row_value.ConvertExpiredColumnsToTombstones(&value_changed);
-
-  if (value_type == ValueType::kValue) {
-    compacted = compacted.RemoveTombstones(options_.gc_grace_period_in_seconds);
+  bool empty = false;
+  if (!RowValue::CompactSerialized(
+          existing_value, options_.purge_ttl_on_expiration,
+          /*remove_tombstones=*/value_type == ValueType::kValue,
+          options_.gc_grace_period_in_seconds, new_value, &value_changed,
+          &empty)) {
+    // Leave malformed rows alone
+    return Decision::kKeep;
   }
 
-  if (compacted.Empty()) {
+  if (empty) {
     return Decision::kRemove;
   }
 
   if (value_changed) {
-    compacted.Serialize(new_value);
     return Decision::kChangeValue;
   }
 
@@ -367,6 +367,77 @@ TEST(RowValueTest, ExpireTtlShouldConvertExpiredColumnsToTombstones) {
   compacted.ConvertExpiredColumnsToTombstones(&changed);
   EXPECT_FALSE(changed);
 }
+
+TEST(RowValueTest, CompactSerializedShouldMatchRowValueCompaction) {
+  int64_t now = time(nullptr);
+
+  std::vector<std::string> rows(6);
+  CreateTestRowValue(
+      {CreateTestColumnSpec(kColumn, 0, ToMicroSeconds(now)),
+       CreateTestColumnSpec(kExpiringColumn, 1,
+                            ToMicroSeconds(now - kTtl - 10)),  // expired
+       CreateTestColumnSpec(kExpiringColumn, 2,
+                            ToMicroSeconds(now)),  // not expired
+       CreateTestColumnSpec(kTombstone, 3, ToMicroSeconds(now - 10)),
+       CreateTestColumnSpec(kExpiringColumn, 4,
+                            ToMicroSeconds(now - kTtl - 1000))})  // expired
+      .Serialize(&rows[0]);
+  CreateTestRowValue(
+      {CreateTestColumnSpec(kColumn, 0, ToMicroSeconds(now)),
+       CreateTestColumnSpec(kExpiringColumn, 1, ToMicroSeconds(now))})
+      .Serialize(&rows[1]);
+  CreateTestRowValue({CreateTestColumnSpec(kExpiringColumn, 0,
+                                           ToMicroSeconds(now - kTtl - 10))})
+      .Serialize(&rows[2]);
+  CreateTestRowValue(
+      {CreateTestColumnSpec(kTombstone, 0, ToMicroSeconds(now - 10))})
+      .Serialize(&rows[3]);
+  CreateRowTombstone(ToMicroSeconds(now)).Serialize(&rows[4]);
+  CreateTestRowValue({}).Serialize(&rows[5]);
+
+  for (const std::string& row : rows) {
+    for (bool purge_ttl_on_expiration : {false, true}) {
+      for (bool remove_tombstones : {false, true}) {
+        for (int32_t gc_grace_period : {0, 100}) {
+          bool expected_changed = false;
+          RowValue row_value = RowValue::Deserialize(row.data(), row.size());
+          RowValue compacted =
+              purge_ttl_on_expiration
+                  ? row_value.RemoveExpiredColumns(&expected_changed)
+                  : row_value.ConvertExpiredColumnsToTombstones(
+                        &expected_changed);
+          if (remove_tombstones) {
+            compacted = compacted.RemoveTombstones(gc_grace_period);
+          }
+
+          std::string dest;
+          bool changed = false;
+          bool empty = false;
+          ASSERT_TRUE(RowValue::CompactSerialized(
+              row, purge_ttl_on_expiration, remove_tombstones,
+              gc_grace_period, &dest, &changed, &empty));
+          EXPECT_EQ(expected_changed, changed);
+          EXPECT_EQ(compacted.Empty(), empty);
+          std::string expected;
+          if (changed && !empty) {
+            compacted.Serialize(&expected);
+          }
+          EXPECT_EQ(expected, dest);
+        }
+      }
+    }
+  }
+
+  // Truncated rows are rejected
+  std::string dest;
+  bool changed = false;
+  bool empty = false;
+  EXPECT_FALSE(RowValue::CompactSerialized(
+      Slice(rows[0].data(), rows[0].size() - 1), false, true, 0, &dest,
+      &changed, &empty));
+  EXPECT_FALSE(RowValue::CompactSerialized(Slice(rows[0].data(), 11), false,
+                                           true, 0, &dest, &changed, &empty));
+}
 }  // namespace cassandra
 }  // namespace ROCKSDB_NAMESPACE
 
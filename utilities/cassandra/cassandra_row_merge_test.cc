@@ -14,6 +14,28 @@ namespace cassandra {
 
 class RowValueMergeTest : public testing::Test {};
 
+// Checks that merging the serialized rows gives the same row as merging the
+// deserialized ones with RowValue::Merge()
+void VerifyMergeSerialized(std::vector<RowValue>&& row_values,
+                           bool remove_tombstones, int32_t gc_grace_period) {
+  std::vector<std::string> serialized(row_values.size());
+  for (size_t i = 0; i < row_values.size(); ++i) {
+    row_values[i].Serialize(&serialized[i]);
+  }
+  RowValue merged = RowValue::Merge(std::move(row_values));
+  if (remove_tombstones) {
+    merged = merged.RemoveTombstones(gc_grace_period);
+  }
+  std::string expected;
+  merged.Serialize(&expected);
+
+  std::vector<Slice> rows(serialized.begin(), serialized.end());
+  std::string dest;
+  ASSERT_TRUE(RowValue::MergeSerialized(rows, remove_tombstones,
+                                        gc_grace_period, &dest));
+  EXPECT_EQ(expected, dest);
+}
+
 TEST(RowValueMergeTest, Merge) {
   std::vector<RowValue> row_values;
   row_values.push_back(CreateTestRowValue({
@@ -88,6 +110,77 @@ TEST(RowValueMergeTest, MergeWithRowTombstone) {
   EXPECT_EQ(merged.LastModifiedTime(), 17);
 }
 
+TEST(RowValueMergeTest, MergeSerialized) {
+  for (bool remove_tombstones : {false, true}) {
+    std::vector<RowValue> row_values;
+    row_values.push_back(CreateTestRowValue({
+        CreateTestColumnSpec(kTombstone, 0, 5),
+        CreateTestColumnSpec(kColumn, 1, 8),
+        CreateTestColumnSpec(kExpiringColumn, 2, 5),
+    }));
+    // Columns out of index order, with negative and repeated indexes
+    row_values.push_back(CreateTestRowValue({
+        CreateTestColumnSpec(kExpiringColumn, 7, 17),
+        CreateTestColumnSpec(kColumn, 0, 2),
+        CreateTestColumnSpec(kTombstone, 2, 7),
+        CreateTestColumnSpec(kExpiringColumn, -3, 5),
+        CreateTestColumnSpec(kColumn, 0, 9),
+    }));
+    row_values.push_back(CreateTestRowValue({
+        CreateTestColumnSpec(kExpiringColumn, 0, 6),
+        CreateTestColumnSpec(kTombstone, 1, 5),
+        CreateTestColumnSpec(kColumn, -128, 4),
+        CreateTestColumnSpec(kTombstone, 127, 11),
+    }));
+    VerifyMergeSerialized(std::move(row_values), remove_tombstones, 0);
+
+    // Row tombstones in between
+    row_values.clear();
+    row_values.push_back(CreateRowTombstone(11));
+    row_values.push_back(CreateTestRowValue({
+        CreateTestColumnSpec(kColumn, 0, 5),
+        CreateTestColumnSpec(kColumn, 1, 6),
+    }));
+    row_values.push_back(CreateTestRowValue({
+        CreateTestColumnSpec(kColumn, 2, 10),
+        CreateTestColumnSpec(kTombstone, 3, 12),
+    }));
+    row_values.push_back(CreateTestRowValue({
+        CreateTestColumnSpec(kColumn, 4, 13),
+        CreateTestColumnSpec(kColumn, 5, 14),
+    }));
+    VerifyMergeSerialized(std::move(row_values), remove_tombstones, 0);
+
+    // The latest row is a row tombstone
+    row_values.clear();
+    row_values.push_back(CreateTestRowValue({
+        CreateTestColumnSpec(kColumn, 4, 13),
+    }));
+    row_values.push_back(CreateRowTombstone(17));
+    row_values.push_back(CreateRowTombstone(15));
+    VerifyMergeSerialized(std::move(row_values), remove_tombstones, 0);
+
+    // A single row is only stripped of collectable tombstones
+    row_values.clear();
+    row_values.push_back(CreateTestRowValue({
+        CreateTestColumnSpec(kColumn, 4, 13),
+        CreateTestColumnSpec(kTombstone, 1, 5),
+        CreateTestColumnSpec(kColumn, 0, 0),
+    }));
+    VerifyMergeSerialized(std::move(row_values), remove_tombstones, 0);
+    row_values.clear();
+    row_values.push_back(CreateRowTombstone(17));
+    VerifyMergeSerialized(std::move(row_values), remove_tombstones, 0);
+  }
+
+  // Truncated rows are rejected
+  std::string row;
+  CreateTestRowValue({CreateTestColumnSpec(kColumn, 4, 13)}).Serialize(&row);
+  std::string dest;
+  std::vector<Slice> rows = {row, Slice(row.data(), row.size() - 1)};
+  EXPECT_FALSE(RowValue::MergeSerialized(rows, true, 0, &dest));
+}
+
 }  // namespace cassandra
 }  // namespace ROCKSDB_NAMESPACE
 
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 
+#include "util/math.h"
 #include "utilities/cassandra/serialize.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -16,6 +17,96 @@ namespace cassandra {
 namespace {
 const int32_t kDefaultLocalDeletionTime = std::numeric_limits<int32_t>::max();
 const int64_t kDefaultMarkedForDeleteAt = std::numeric_limits<int64_t>::min();
+
+using SystemTime = std::chrono::time_point<std::chrono::system_clock>;
+
+const std::size_t kRowHeaderSize = sizeof(int32_t) + sizeof(int64_t);
+const std::size_t kTombstoneSize =
+    2 * sizeof(int8_t) + sizeof(int32_t) + sizeof(int64_t);
+// A Column without its value
+const std::size_t kColumnHeaderSize =
+    2 * sizeof(int8_t) + sizeof(int64_t) + sizeof(int32_t);
+
+SystemTime ExpiresAt(int64_t timestamp, int32_t ttl) {
+  return SystemTime(std::chrono::microseconds(timestamp)) +
+         std::chrono::seconds(ttl);
+}
+
+bool TombstoneCollectable(int32_t local_deletion_time,
+                          int32_t gc_grace_period_in_seconds, SystemTime now) {
+  auto local_deleted_at = SystemTime(std::chrono::seconds(local_deletion_time));
+  auto gc_grace_period = std::chrono::seconds(gc_grace_period_in_seconds);
+  return local_deleted_at + gc_grace_period < now;
+}
+
+// A column of a serialized row, parsed in place
+struct SerializedColumn {
+  int8_t mask;
+  int8_t index;
+  // The marked_for_delete_at of tombstones
+  int64_t timestamp;
+  // Tombstones only
+  int32_t local_deletion_time;
+  // Expiring columns only
+  int32_t ttl;
+  // The whole serialized column
+  const char* data;
+  std::size_t size;
+};
+
+// Parses the column at `offset` of the serialized row `row`, decoding the
+// fields in the same way as ColumnBase::Deserialize(). Returns false if the
+// column is truncated.
+bool ParseColumn(const Slice& row, std::size_t offset,
+                 SerializedColumn* column) {
+  const char* src = row.data();
+  std::size_t available = row.size() - offset;
+  if (available < 2 * sizeof(int8_t)) {
+    return false;
+  }
+  column->mask = Deserialize<int8_t>(src, offset);
+  column->index = Deserialize<int8_t>(src, offset + sizeof(int8_t));
+  if ((column->mask & ColumnTypeMask::DELETION_MASK) != 0) {
+    column->size = kTombstoneSize;
+    if (available < column->size) {
+      return false;
+    }
+    column->local_deletion_time =
+        Deserialize<int32_t>(src, offset + 2 * sizeof(int8_t));
+    column->timestamp = Deserialize<int64_t>(
+        src, offset + 2 * sizeof(int8_t) + sizeof(int32_t));
+  } else {
+    if (available < kColumnHeaderSize) {
+      return false;
+    }
+    column->timestamp = Deserialize<int64_t>(src, offset + 2 * sizeof(int8_t));
+    int32_t value_size = Deserialize<int32_t>(
+        src, offset + 2 * sizeof(int8_t) + sizeof(int64_t));
+    if (value_size < 0) {
+      return false;
+    }
+    column->size = kColumnHeaderSize + static_cast<std::size_t>(value_size);
+    bool expiring = (column->mask & ColumnTypeMask::EXPIRATION_MASK) != 0;
+    if (expiring) {
+      column->size += sizeof(int32_t);
+    }
+    if (available < column->size) {
+      return false;
+    }
+    if (expiring) {
+      column->ttl =
+          Deserialize<int32_t>(src, offset + column->size - sizeof(int32_t));
+    }
+  }
+  column->data = src + offset;
+  return true;
+}
+
+void SerializeRowHeader(int32_t local_deletion_time,
+                        int64_t marked_for_delete_at, std::string* dest) {
+  Serialize<int32_t>(local_deletion_time, dest);
+  Serialize<int64_t>(marked_for_delete_at, dest);
+}
 }  // namespace
 
 ColumnBase::ColumnBase(int8_t mask, int8_t index)
@@ -106,7 +197,7 @@ std::chrono::seconds ExpiringColumn::Ttl() const {
 }
 
 bool ExpiringColumn::Expired() const {
-  return TimePoint() + Ttl() < std::chrono::system_clock::now();
+  return ExpiresAt(Timestamp(), ttl_) < std::chrono::system_clock::now();
 }
 
 std::shared_ptr<Tombstone> ExpiringColumn::ToTombstone() const {
@@ -159,10 +250,8 @@ void Tombstone::Serialize(std::string* dest) const {
 }
 
 bool Tombstone::Collectable(int32_t gc_grace_period_in_seconds) const {
-  auto local_deleted_at = std::chrono::time_point<std::chrono::system_clock>(
-      std::chrono::seconds(local_deletion_time_));
-  auto gc_grace_period = std::chrono::seconds(gc_grace_period_in_seconds);
-  return local_deleted_at + gc_grace_period < std::chrono::system_clock::now();
+  return TombstoneCollectable(local_deletion_time_, gc_grace_period_in_seconds,
+                              std::chrono::system_clock::now());
 }
 
 std::shared_ptr<Tombstone> Tombstone::Deserialize(const char* src,
@@ -363,5 +452,211 @@ RowValue RowValue::Merge(std::vector<RowValue>&& values) {
   return RowValue(std::move(columns), last_modified_time);
 }
 
+bool RowValue::CompactSerialized(const Slice& row, bool purge_ttl_on_expiration,
+                                 bool remove_tombstones,
+                                 int32_t gc_grace_period, std::string* dest,
+                                 bool* changed, bool* empty) {
+  *changed = false;
+  *empty = true;
+  if (row.size() < kRowHeaderSize) {
+    return false;
+  }
+  // Read the clock once for the whole row rather than once per column
+  const SystemTime now = std::chrono::system_clock::now();
+
+  // The first pass only finds out what changes, so that rows which do not
+  // change, the common case, are never copied. The second one writes out
+  // the compacted row, making exactly the same decisions.
+  for (int pass = 0; pass < 2; ++pass) {
+    if (pass == 1) {
+      if (!*changed || *empty) {
+        break;
+      }
+      dest->reserve(dest->size() + row.size());
+      SerializeRowHeader(kDefaultLocalDeletionTime, kDefaultMarkedForDeleteAt,
+                         dest);
+    }
+    SerializedColumn column;
+    for (std::size_t offset = kRowHeaderSize; offset < row.size();
+         offset += column.size) {
+      if (!ParseColumn(row, offset, &column)) {
+        return false;
+      }
+      if (column.mask == ColumnTypeMask::EXPIRATION_MASK) {
+        SystemTime expires_at = ExpiresAt(column.timestamp, column.ttl);
+        if (expires_at < now) {
+          *changed = true;
+          if (purge_ttl_on_expiration) {
+            continue;
+          }
+          // Same as ExpiringColumn::ToTombstone()
+          auto expired_at = expires_at.time_since_epoch();
+          int32_t local_deletion_time = static_cast<int32_t>(
+              std::chrono::duration_cast<std::chrono::seconds>(expired_at)
+                  .count());
+          if (remove_tombstones &&
+              TombstoneCollectable(local_deletion_time, gc_grace_period,
+                                   now)) {
+            continue;
+          }
+          *empty = false;
+          if (pass == 1) {
+            Tombstone(static_cast<int8_t>(ColumnTypeMask::DELETION_MASK),
+                      column.index, local_deletion_time,
+                      std::chrono::duration_cast<std::chrono::microseconds>(
+                          expired_at)
+                          .count())
+                .Serialize(dest);
+          }
+          continue;
+        }
+      } else if (column.mask == ColumnTypeMask::DELETION_MASK &&
+                 remove_tombstones &&
+                 TombstoneCollectable(column.local_deletion_time,
+                                      gc_grace_period, now)) {
+        continue;
+      }
+      *empty = false;
+      if (pass == 1) {
+        dest->append(column.data, column.size);
+      }
+    }
+  }
+  return true;
+}
+
+// Same as Merge(), except that instead of sorting all the columns into a
+// map, the latest column of each index is kept in a table with a slot per
+// possible index. The slots are then visited in index order to write out
+// the merged row, so the columns of the rows do not need to be sorted.
+bool RowValue::MergeSerialized(const std::vector<Slice>& rows,
+                               bool remove_tombstones, int32_t gc_grace_period,
+                               std::string* dest) {
+  assert(rows.size() > 0);
+  const SystemTime now = std::chrono::system_clock::now();
+  auto keep = [&](const SerializedColumn& column) {
+    return !remove_tombstones ||
+           column.mask != ColumnTypeMask::DELETION_MASK ||
+           !TombstoneCollectable(column.local_deletion_time, gc_grace_period,
+                                 now);
+  };
+  SerializedColumn column;
+
+  if (rows.size() == 1) {
+    const Slice& row = rows[0];
+    if (row.size() < kRowHeaderSize) {
+      return false;
+    }
+    if (!remove_tombstones) {
+      dest->append(row.data(), row.size());
+      return true;
+    }
+    // RemoveTombstones() drops the row tombstone, if any, as well
+    SerializeRowHeader(kDefaultLocalDeletionTime, kDefaultMarkedForDeleteAt,
+                       dest);
+    for (std::size_t offset = kRowHeaderSize; offset < row.size();
+         offset += column.size) {
+      if (!ParseColumn(row, offset, &column)) {
+        return false;
+      }
+      if (keep(column)) {
+        dest->append(column.data, column.size);
+      }
+    }
+    return true;
+  }
+
+  struct RowInfo {
+    Slice row;
+    std::size_t position;
+    int64_t last_modified_time;
+    bool tombstone;
+  };
+  std::vector<RowInfo> infos;
+  infos.reserve(rows.size());
+  for (const Slice& row : rows) {
+    if (row.size() < kRowHeaderSize) {
+      return false;
+    }
+    RowInfo info{row, infos.size(), 0, false};
+    if (row.size() == kRowHeaderSize) {
+      int64_t marked_for_delete_at =
+          ROCKSDB_NAMESPACE::cassandra::Deserialize<int64_t>(row.data(),
+                                                             sizeof(int32_t));
+      if (marked_for_delete_at > kDefaultMarkedForDeleteAt) {
+        info.tombstone = true;
+        info.last_modified_time = marked_for_delete_at;
+      }
+    }
+    for (std::size_t offset = kRowHeaderSize; offset < row.size();
+         offset += column.size) {
+      if (!ParseColumn(row, offset, &column)) {
+        return false;
+      }
+      info.last_modified_time =
+          std::max(info.last_modified_time, column.timestamp);
+    }
+    infos.push_back(info);
+  }
+  std::sort(infos.begin(), infos.end(),
+            [](const RowInfo& r1, const RowInfo& r2) {
+              if (r1.last_modified_time != r2.last_modified_time) {
+                return r1.last_modified_time > r2.last_modified_time;
+              }
+              return r1.position < r2.position;
+            });
+
+  // Slot i holds the latest column of index i - 128, if its bit is set in
+  // `present`
+  SerializedColumn latest[256];
+  uint64_t present[4] = {0, 0, 0, 0};
+  bool merged_any = false;
+  int64_t tombstone_timestamp = 0;
+  for (const RowInfo& info : infos) {
+    if (info.tombstone) {
+      if (!merged_any) {
+        if (remove_tombstones) {
+          SerializeRowHeader(kDefaultLocalDeletionTime,
+                             kDefaultMarkedForDeleteAt, dest);
+        } else {
+          dest->append(info.row.data(), info.row.size());
+        }
+        return true;
+      }
+      tombstone_timestamp = info.last_modified_time;
+      break;
+    }
+    for (std::size_t offset = kRowHeaderSize; offset < info.row.size();
+         offset += column.size) {
+      bool parsed = ParseColumn(info.row, offset, &column);
+      assert(parsed);
+      (void)parsed;
+      std::size_t slot = static_cast<uint8_t>(column.index) ^ 0x80u;
+      uint64_t bit = uint64_t{1} << (slot % 64);
+      if ((present[slot / 64] & bit) == 0 ||
+          column.timestamp > latest[slot].timestamp) {
+        present[slot / 64] |= bit;
+        latest[slot] = column;
+      }
+      merged_any = true;
+    }
+  }
+
+  SerializeRowHeader(kDefaultLocalDeletionTime, kDefaultMarkedForDeleteAt,
+                     dest);
+  for (std::size_t word = 0; word < 4; ++word) {
+    for (uint64_t bits = present[word]; bits != 0; bits &= bits - 1) {
+      const SerializedColumn& c =
+          latest[word * 64 + static_cast<std::size_t>(
+                                 CountTrailingZeroBits(bits))];
+      // Like Merge(), drop columns older than the row tombstone
+      if (c.timestamp > tombstone_timestamp && keep(c)) {
+        dest->append(c.data, c.size);
+      }
+    }
+  }
+  return true;
+}
+
 }  // namespace cassandra
 }  // namespace ROCKSDB_NAMESPACE
@@ -57,6 +57,7 @@
 #pragma once
 #include <chrono>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "rocksdb/merge_operator.h"
@@ -170,6 +171,25 @@ class RowValue {
   // Merge multiple rows according to their timestamp.
   static RowValue Merge(std::vector<RowValue>&& values);
 
+  // Compacts the serialized row `row` like RemoveExpiredColumns(), or like
+  // ConvertExpiredColumnsToTombstones() if `purge_ttl_on_expiration` is
+  // false, followed by RemoveTombstones() if `remove_tombstones` is true.
+  // This is done in one pass over the serialized columns, without
+  // deserializing them. Sets `*changed` like those methods do and `*empty`
+  // if no column is left. The compacted row is only appended to `dest` if it
+  // changed and is not empty. Returns false if `row` is malformed.
+  static bool CompactSerialized(const Slice& row, bool purge_ttl_on_expiration,
+                                bool remove_tombstones,
+                                int32_t gc_grace_period, std::string* dest,
+                                bool* changed, bool* empty);
+  // Merges serialized rows like Merge(), followed by RemoveTombstones() if
+  // `remove_tombstones` is true, and appends the result to `dest`. Columns
+  // are picked out of the serialized rows in place, without deserializing
+  // any RowValue. Returns false if any of the rows is malformed.
+  static bool MergeSerialized(const std::vector<Slice>& rows,
+                              bool remove_tombstones, int32_t gc_grace_period,
+                              std::string* dest);
+
   const Columns& get_columns() { return columns_; }
 
  private:
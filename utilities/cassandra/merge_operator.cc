@@ -42,22 +42,17 @@ bool CassandraValueMergeOperator::FullMergeV2(
     MergeOperationOutput* merge_out) const {
   // Clear the *new_value for writing.
   merge_out->new_value.clear();
-  std::vector<RowValue> row_values;
+  std::vector<Slice> rows;
+  rows.reserve(merge_in.operand_list.size() + 1);
   if (merge_in.existing_value) {
-    row_values.push_back(RowValue::Deserialize(
-        merge_in.existing_value->data(), merge_in.existing_value->size()));
+    rows.push_back(*merge_in.existing_value);
   }
+  rows.insert(rows.end(), merge_in.operand_list.begin(),
+              merge_in.operand_list.end());
 
-  for (auto& operand : merge_in.operand_list) {
-    row_values.push_back(RowValue::Deserialize(operand.data(), operand.size()));
-  }
-
-  RowValue merged = RowValue::Merge(std::move(row_values));
-  merged = merged.RemoveTombstones(options_.gc_grace_period_in_seconds);
-  merge_out->new_value.reserve(merged.Size());
-  merged.Serialize(&(merge_out->new_value));
-
-  return true;
+  return RowValue::MergeSerialized(rows, /*remove_tombstones=*/true,
+                                   options_.gc_grace_period_in_seconds,
+                                   &merge_out->new_value);
 }
 
 bool CassandraValueMergeOperator::PartialMergeMulti(
@@ -67,14 +62,10 @@ bool CassandraValueMergeOperator::PartialMergeMulti(
   assert(new_value);
   new_value->clear();
 
-  std::vector<RowValue> row_values;
-  for (auto& operand : operand_list) {
-    row_values.push_back(RowValue::Deserialize(operand.data(), operand.size()));
-  }
-  RowValue merged = RowValue::Merge(std::move(row_values));
-  new_value->reserve(merged.Size());
-  merged.Serialize(new_value);
-  return true;
+  std::vector<Slice> rows(operand_list.begin(), operand_list.end());
+  return RowValue::MergeSerialized(rows, /*remove_tombstones=*/false,
+                                   options_.gc_grace_period_in_seconds,
+                                   new_value);
 }
 
 }  // namespace cassandra
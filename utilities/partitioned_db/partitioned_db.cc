@@ -0,0 +1,1193 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+
+#include "rocksdb/utilities/partitioned_db.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "db/wide/wide_column_serialization.h"
+#include "db/write_batch_internal.h"
+#include "port/port.h"
+#include "rocksdb/threadpool.h"
+#include "rocksdb/write_buffer_manager.h"
+#include "util/fastrange.h"
+#include "util/hash.h"
+#include "util/heap.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+class HashKeyPartitioner : public KeyPartitioner {
+ public:
+  const char* Name() const override { return "rocksdb.HashKeyPartitioner"; }
+
+  size_t GetPartition(const Slice& key, size_t num_partitions) const override {
+    // The partition of a key is persisted, so the hash has to be stable
+    return FastRange64(Hash64(key.data(), key.size()), num_partitions);
+  }
+};
+
+std::string PartitionName(const std::string& dbname, size_t index) {
+  return dbname + "/partition-" + std::to_string(index);
+}
+
+// Runs fn(0), ..., fn(n - 1) on the calling thread and on the threads of
+// `pool`, if any, and returns once all of them returned.
+void FanOut(ThreadPool* pool, size_t n,
+            const std::function<void(size_t)>& fn) {
+  if (pool == nullptr || n <= 1) {
+    for (size_t i = 0; i < n; ++i) {
+      fn(i);
+    }
+    return;
+  }
+  struct FanOutState {
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t done = 0;
+  };
+  // Helpers may only start once all the work is done, so they share the
+  // state but only call `fn` while the calling thread still waits for it
+  auto state = std::make_shared<FanOutState>();
+  const std::function<void(size_t)>* fn_ptr = &fn;
+  auto work = [state, fn_ptr, n]() {
+    size_t completed = 0;
+    for (size_t i = state->next.fetch_add(1, std::memory_order_relaxed); i < n;
+         i = state->next.fetch_add(1, std::memory_order_relaxed)) {
+      (*fn_ptr)(i);
+      ++completed;
+    }
+    if (completed > 0) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->done += completed;
+      if (state->done == n) {
+        state->cv.notify_all();
+      }
+    }
+  };
+  size_t num_helpers = std::min(
+      n - 1, static_cast<size_t>(std::max(pool->GetBackgroundThreads(), 0)));
+  for (size_t i = 0; i < num_helpers; ++i) {
+    pool->SubmitJob(work);
+  }
+  work();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cv.wait(lock, [&state, n]() { return state->done == n; });
+}
+
+// A snapshot of every partition, taken while no write was in progress
+class PartitionedSnapshot : public Snapshot {
+ public:
+  explicit PartitionedSnapshot(std::vector<const Snapshot*>&& snapshots)
+      : snapshots_(std::move(snapshots)) {}
+
+  // Each partition numbers its writes independently, so the sequence number
+  // is that of the first partition
+  SequenceNumber GetSequenceNumber() const override {
+    return snapshots_[0]->GetSequenceNumber();
+  }
+  int64_t GetUnixTime() const override { return snapshots_[0]->GetUnixTime(); }
+  uint64_t GetTimestamp() const override {
+    return snapshots_[0]->GetTimestamp();
+  }
+
+  const std::vector<const Snapshot*>& snapshots() const { return snapshots_; }
+
+ private:
+  const std::vector<const Snapshot*> snapshots_;
+};
+
+// Merges iterators over the partitions, whose keys are disjoint
+class PartitionedIterator : public Iterator {
+ public:
+  PartitionedIterator(const Comparator* comparator,
+                      std::vector<Iterator*>&& children)
+      : children_(std::move(children)),
+        min_heap_(MinComparator{comparator}),
+        max_heap_(MaxComparator{comparator}) {}
+
+  ~PartitionedIterator() override {
+    for (Iterator* child : children_) {
+      delete child;
+    }
+  }
+
+  bool Valid() const override { return current_ != nullptr; }
+
+  void SeekToFirst() override {
+    for (Iterator* child : children_) {
+      child->SeekToFirst();
+    }
+    InitHeap(/*forward=*/true);
+  }
+
+  void SeekToLast() override {
+    for (Iterator* child : children_) {
+      child->SeekToLast();
+    }
+    InitHeap(/*forward=*/false);
+  }
+
+  void Seek(const Slice& target) override {
+    for (Iterator* child : children_) {
+      child->Seek(target);
+    }
+    InitHeap(/*forward=*/true);
+  }
+
+  void SeekForPrev(const Slice& target) override {
+    for (Iterator* child : children_) {
+      child->SeekForPrev(target);
+    }
+    InitHeap(/*forward=*/false);
+  }
+
+  void Next() override {
+    assert(Valid());
+    if (!forward_) {
+      // No other partition holds key(), so seeking to it positions them at
+      // their first key after it
+      for (Iterator* child : children_) {
+        if (child != current_) {
+          child->Seek(current_->key());
+        }
+      }
+      current_->Next();
+      InitHeap(/*forward=*/true);
+      return;
+    }
+    current_->Next();
+    UpdateTop(&min_heap_);
+  }
+
+  void Prev() override {
+    assert(Valid());
+    if (forward_) {
+      for (Iterator* child : children_) {
+        if (child != current_) {
+          child->SeekForPrev(current_->key());
+        }
+      }
+      current_->Prev();
+      InitHeap(/*forward=*/false);
+      return;
+    }
+    current_->Prev();
+    UpdateTop(&max_heap_);
+  }
+
+  Slice key() const override {
+    assert(Valid());
+    return current_->key();
+  }
+
+  Slice value() const override {
+    assert(Valid());
+    return current_->value();
+  }
+
+  const WideColumns& columns() const override {
+    assert(Valid());
+    return current_->columns();
+  }
+
+  Status status() const override { return status_; }
+
+ private:
+  struct MinComparator {
+    bool operator()(Iterator* a, Iterator* b) const {
+      return comparator->Compare(a->key(), b->key()) > 0;
+    }
+    const Comparator* comparator;
+  };
+  struct MaxComparator {
+    bool operator()(Iterator* a, Iterator* b) const {
+      return comparator->Compare(a->key(), b->key()) < 0;
+    }
+    const Comparator* comparator;
+  };
+
+  void InitHeap(bool forward) {
+    forward_ = forward;
+    status_ = Status::OK();
+    min_heap_.clear();
+    max_heap_.clear();
+    for (Iterator* child : children_) {
+      if (child->Valid()) {
+        if (forward) {
+          min_heap_.push(child);
+        } else {
+          max_heap_.push(child);
+        }
+      } else if (status_.ok()) {
+        status_ = child->status();
+      }
+    }
+    SetCurrent();
+  }
+
+  // Re-sorts the child at the top of `heap` after it moved
+  template <typename Heap>
+  void UpdateTop(Heap* heap) {
+    if (current_->Valid()) {
+      heap->replace_top(current_);
+    } else {
+      status_ = current_->status();
+      heap->pop();
+    }
+    SetCurrent();
+  }
+
+  void SetCurrent() {
+    if (!status_.ok()) {
+      current_ = nullptr;
+    } else if (forward_) {
+      current_ = min_heap_.empty() ? nullptr : min_heap_.top();
+    } else {
+      current_ = max_heap_.empty() ? nullptr : max_heap_.top();
+    }
+  }
+
+  std::vector<Iterator*> children_;
+  BinaryHeap<Iterator*, MinComparator> min_heap_;
+  BinaryHeap<Iterator*, MaxComparator> max_heap_;
+  Iterator* current_ = nullptr;
+  bool forward_ = true;
+  Status status_;
+};
+
+Status ColumnFamilyNotSupported() {
+  return Status::NotSupported(
+      "PartitionedDB only supports the default column family.");
+}
+
+Status TimestampNotSupported() {
+  return Status::NotSupported(
+      "PartitionedDB does not support user-defined timestamps.");
+}
+
+// For methods whose arguments, like table file names, cannot be routed to a
+// partition by key
+Status NotSupportedAcrossPartitions(const char* method) {
+  return Status::NotSupported(
+      method, "not supported by PartitionedDB, use GetPartition()");
+}
+
+bool IsDefaultColumnFamily(ColumnFamilyHandle* column_family) {
+  return column_family == nullptr ||
+         column_family->GetID() == 0 /* kDefaultColumnFamily */;
+}
+}  // namespace
+
+class PartitionedDBImpl : public PartitionedDB {
+ public:
+  PartitionedDBImpl(const Options& options,
+                    const PartitionedDBOptions& partitioned_options,
+                    std::vector<DB*>&& dbs,
+                    std::unique_ptr<ThreadPool>&& fanout_pool)
+      : PartitionedDB(dbs[0]),
+        comparator_(options.comparator),
+        partitioner_(partitioned_options.partitioner),
+        fanout_pool_(std::move(fanout_pool)) {
+    partitions_.reserve(dbs.size());
+    for (DB* db : dbs) {
+      partitions_.emplace_back(new Partition);
+      partitions_.back()->db = db;
+    }
+  }
+
+  ~PartitionedDBImpl() override {
+    if (fanout_pool_ != nullptr) {
+      fanout_pool_->JoinAllThreads();
+    }
+    // The first partition is deleted by StackableDB
+    for (size_t i = 1; i < partitions_.size(); ++i) {
+      delete partitions_[i]->db;
+    }
+  }
+
+  size_t NumPartitions() const override { return partitions_.size(); }
+
+  size_t GetPartitionIndex(const Slice& key) const override {
+    return partitioner_->GetPartition(key, partitions_.size());
+  }
+
+  DB* GetPartition(size_t index) const override {
+    assert(index < partitions_.size());
+    return partitions_[index]->db;
+  }
+
+  Status Close() override {
+    Status s;
+    for (auto& partition : partitions_) {
+      Status close_status = partition->db->Close();
+      if (s.ok()) {
+        s = close_status;
+      } else {
+        close_status.PermitUncheckedError();
+      }
+    }
+    return s;
+  }
+
+  Status CreateColumnFamily(const ColumnFamilyOptions& /*options*/,
+                            const std::string& /*column_family_name*/,
+                            ColumnFamilyHandle** /*handle*/) override {
+    return ColumnFamilyNotSupported();
+  }
+
+  Status CreateColumnFamilies(
+      const ColumnFamilyOptions& /*options*/,
+      const std::vector<std::string>& /*column_family_names*/,
+      std::vector<ColumnFamilyHandle*>* /*handles*/) override {
+    return ColumnFamilyNotSupported();
+  }
+
+  Status CreateColumnFamilies(
+      const std::vector<ColumnFamilyDescriptor>& /*column_families*/,
+      std::vector<ColumnFamilyHandle*>* /*handles*/) override {
+    return ColumnFamilyNotSupported();
+  }
+
+  using DB::CreateColumnFamilyWithImport;
+  Status CreateColumnFamilyWithImport(
+      const ColumnFamilyOptions& /*options*/,
+      const std::string& /*column_family_name*/,
+      const ImportColumnFamilyOptions& /*import_options*/,
+      const ExportImportFilesMetaData& /*metadata*/,
+      ColumnFamilyHandle** /*handle*/) override {
+    return ColumnFamilyNotSupported();
+  }
+
+  using DB::Put;
+  Status Put(const WriteOptions& options, ColumnFamilyHandle* column_family,
+             const Slice& key, const Slice& value) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    Partition& partition = PartitionOf(key);
+    ReadLock lock(&partition.write_mutex);
+    return partition.db->Put(options, key, value);
+  }
+
+  Status Put(const WriteOptions& /*options*/,
+             ColumnFamilyHandle* /*column_family*/, const Slice& /*key*/,
+             const Slice& /*ts*/, const Slice& /*value*/) override {
+    return TimestampNotSupported();
+  }
+
+  using DB::PutEntity;
+  Status PutEntity(const WriteOptions& options,
+                   ColumnFamilyHandle* column_family, const Slice& key,
+                   const WideColumns& columns) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    Partition& partition = PartitionOf(key);
+    ReadLock lock(&partition.write_mutex);
+    return partition.db->PutEntity(
+        options, partition.db->DefaultColumnFamily(), key, columns);
+  }
+
+  using DB::Delete;
+  Status Delete(const WriteOptions& options, ColumnFamilyHandle* column_family,
+                const Slice& key) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    Partition& partition = PartitionOf(key);
+    ReadLock lock(&partition.write_mutex);
+    return partition.db->Delete(options, key);
+  }
+
+  Status Delete(const WriteOptions& /*options*/,
+                ColumnFamilyHandle* /*column_family*/, const Slice& /*key*/,
+                const Slice& /*ts*/) override {
+    return TimestampNotSupported();
+  }
+
+  using DB::SingleDelete;
+  Status SingleDelete(const WriteOptions& options,
+                      ColumnFamilyHandle* column_family,
+                      const Slice& key) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    Partition& partition = PartitionOf(key);
+    ReadLock lock(&partition.write_mutex);
+    return partition.db->SingleDelete(options, key);
+  }
+
+  Status SingleDelete(const WriteOptions& /*options*/,
+                      ColumnFamilyHandle* /*column_family*/,
+                      const Slice& /*key*/, const Slice& /*ts*/) override {
+    return TimestampNotSupported();
+  }
+
+  using DB::DeleteRange;
+  Status DeleteRange(const WriteOptions& options,
+                     ColumnFamilyHandle* column_family, const Slice& begin_key,
+                     const Slice& end_key) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    WriteBatch batch;
+    Status s = batch.DeleteRange(begin_key, end_key);
+    if (s.ok()) {
+      s = Write(options, &batch);
+    }
+    return s;
+  }
+
+  using DB::Merge;
+  Status Merge(const WriteOptions& options, ColumnFamilyHandle* column_family,
+               const Slice& key, const Slice& value) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    Partition& partition = PartitionOf(key);
+    ReadLock lock(&partition.write_mutex);
+    return partition.db->Merge(options, key, value);
+  }
+
+  Status Merge(const WriteOptions& /*options*/,
+               ColumnFamilyHandle* /*column_family*/, const Slice& /*key*/,
+               const Slice& /*ts*/, const Slice& /*value*/) override {
+    return TimestampNotSupported();
+  }
+
+  Status Write(const WriteOptions& options, WriteBatch* updates) override;
+
+  using DB::Get;
+  Status Get(const ReadOptions& options, ColumnFamilyHandle* column_family,
+             const Slice& key, PinnableSlice* value) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    Status s = CheckSnapshot(options);
+    if (!s.ok()) {
+      return s;
+    }
+    size_t index = GetPartitionIndex(key);
+    DB* db = partitions_[index]->db;
+    return db->Get(PartitionReadOptions(options, index),
+                   db->DefaultColumnFamily(), key, value);
+  }
+
+  using DB::GetEntity;
+  Status GetEntity(const ReadOptions& options,
+                   ColumnFamilyHandle* column_family, const Slice& key,
+                   PinnableWideColumns* columns) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    Status s = CheckSnapshot(options);
+    if (!s.ok()) {
+      return s;
+    }
+    size_t index = GetPartitionIndex(key);
+    DB* db = partitions_[index]->db;
+    return db->GetEntity(PartitionReadOptions(options, index),
+                         db->DefaultColumnFamily(), key, columns);
+  }
+
+  using DB::GetMergeOperands;
+  Status GetMergeOperands(const ReadOptions& options,
+                          ColumnFamilyHandle* column_family, const Slice& key,
+                          PinnableSlice* merge_operands,
+                          GetMergeOperandsOptions* get_merge_operands_options,
+                          int* number_of_operands) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    Status s = CheckSnapshot(options);
+    if (!s.ok()) {
+      return s;
+    }
+    size_t index = GetPartitionIndex(key);
+    DB* db = partitions_[index]->db;
+    return db->GetMergeOperands(PartitionReadOptions(options, index),
+                                db->DefaultColumnFamily(), key, merge_operands,
+                                get_merge_operands_options,
+                                number_of_operands);
+  }
+
+  using DB::KeyMayExist;
+  bool KeyMayExist(const ReadOptions& options,
+                   ColumnFamilyHandle* column_family, const Slice& key,
+                   std::string* value, bool* value_found = nullptr) override {
+    if (!IsDefaultColumnFamily(column_family) ||
+        !CheckSnapshot(options).ok()) {
+      return true;
+    }
+    size_t index = GetPartitionIndex(key);
+    DB* db = partitions_[index]->db;
+    return db->KeyMayExist(PartitionReadOptions(options, index),
+                           db->DefaultColumnFamily(), key, value, value_found);
+  }
+
+  using DB::MultiGet;
+  std::vector<Status> MultiGet(
+      const ReadOptions& options,
+      const std::vector<ColumnFamilyHandle*>& column_families,
+      const std::vector<Slice>& keys,
+      std::vector<std::string>* values) override;
+
+  void MultiGet(const ReadOptions& options, ColumnFamilyHandle* column_family,
+                const size_t num_keys, const Slice* keys, PinnableSlice* values,
+                Status* statuses, const bool sorted_input = false) override;
+
+  using DB::NewIterator;
+  Iterator* NewIterator(const ReadOptions& options,
+                        ColumnFamilyHandle* column_family) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return NewErrorIterator(ColumnFamilyNotSupported());
+    }
+    Status s = CheckSnapshot(options);
+    if (!s.ok()) {
+      return NewErrorIterator(s);
+    }
+    std::vector<Iterator*> children(partitions_.size());
+    for (size_t i = 0; i < partitions_.size(); ++i) {
+      children[i] =
+          partitions_[i]->db->NewIterator(PartitionReadOptions(options, i));
+    }
+    return new PartitionedIterator(comparator_, std::move(children));
+  }
+
+  Status NewIterators(const ReadOptions& /*options*/,
+                      const std::vector<ColumnFamilyHandle*>& /*cfs*/,
+                      std::vector<Iterator*>* /*iterators*/) override {
+    return ColumnFamilyNotSupported();
+  }
+
+  const Snapshot* GetSnapshot() override;
+  void ReleaseSnapshot(const Snapshot* snapshot) override;
+
+  using DB::GetAggregatedIntProperty;
+  bool GetAggregatedIntProperty(const Slice& property,
+                                uint64_t* value) override {
+    uint64_t sum = 0;
+    for (auto& partition : partitions_) {
+      uint64_t partition_value;
+      if (!partition->db->GetAggregatedIntProperty(property,
+                                                   &partition_value)) {
+        return false;
+      }
+      sum += partition_value;
+    }
+    *value = sum;
+    return true;
+  }
+
+  using DB::GetApproximateSizes;
+  Status GetApproximateSizes(const SizeApproximationOptions& options,
+                             ColumnFamilyHandle* column_family, const Range* r,
+                             int n, uint64_t* sizes) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    std::fill(sizes, sizes + n, 0);
+    std::vector<uint64_t> partition_sizes(static_cast<size_t>(n));
+    for (auto& partition : partitions_) {
+      Status s = partition->db->GetApproximateSizes(
+          options, partition->db->DefaultColumnFamily(), r, n,
+          partition_sizes.data());
+      if (!s.ok()) {
+        return s;
+      }
+      for (int i = 0; i < n; ++i) {
+        sizes[i] += partition_sizes[i];
+      }
+    }
+    return Status::OK();
+  }
+
+  using DB::CompactRange;
+  Status CompactRange(const CompactRangeOptions& options,
+                      ColumnFamilyHandle* column_family, const Slice* begin,
+                      const Slice* end) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    return ForEachPartition([&](DB* db) {
+      return db->CompactRange(options, db->DefaultColumnFamily(), begin, end);
+    });
+  }
+
+  using DB::CompactFiles;
+  Status CompactFiles(
+      const CompactionOptions& /*compact_options*/,
+      ColumnFamilyHandle* /*column_family*/,
+      const std::vector<std::string>& /*input_file_names*/,
+      const int /*output_level*/, const int /*output_path_id*/ = -1,
+      std::vector<std::string>* const /*output_file_names*/ = nullptr,
+      CompactionJobInfo* /*compaction_job_info*/ = nullptr) override {
+    return NotSupportedAcrossPartitions("CompactFiles()");
+  }
+
+  Status SuggestCompactRange(ColumnFamilyHandle* column_family,
+                             const Slice* begin, const Slice* end) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    return ForEachPartition([&](DB* db) {
+      return db->SuggestCompactRange(db->DefaultColumnFamily(), begin, end);
+    });
+  }
+
+  Status PromoteL0(ColumnFamilyHandle* /*column_family*/,
+                   int /*target_level*/) override {
+    return NotSupportedAcrossPartitions("PromoteL0()");
+  }
+
+  Status DeleteFile(std::string /*name*/) override {
+    return NotSupportedAcrossPartitions("DeleteFile()");
+  }
+
+  using DB::IngestExternalFile;
+  Status IngestExternalFile(
+      ColumnFamilyHandle* /*column_family*/,
+      const std::vector<std::string>& /*external_files*/,
+      const IngestExternalFileOptions& /*options*/) override {
+    return NotSupportedAcrossPartitions("IngestExternalFile()");
+  }
+
+  using DB::IngestExternalFiles;
+  Status IngestExternalFiles(
+      const std::vector<IngestExternalFileArg>& /*args*/) override {
+    return NotSupportedAcrossPartitions("IngestExternalFiles()");
+  }
+
+  Status GetUpdatesSince(
+      SequenceNumber /*seq_number*/,
+      std::unique_ptr<TransactionLogIterator>* /*iter*/,
+      const TransactionLogIterator::ReadOptions& /*read_options*/) override {
+    return NotSupportedAcrossPartitions("GetUpdatesSince()");
+  }
+
+  Status IncreaseFullHistoryTsLow(ColumnFamilyHandle* /*column_family*/,
+                                  std::string /*ts_low*/) override {
+    return TimestampNotSupported();
+  }
+
+  using DB::SetOptions;
+  Status SetOptions(ColumnFamilyHandle* column_family,
+                    const std::unordered_map<std::string, std::string>&
+                        new_options) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    return ForEachPartition([&](DB* db) {
+      return db->SetOptions(db->DefaultColumnFamily(), new_options);
+    });
+  }
+
+  Status SetDBOptions(const std::unordered_map<std::string, std::string>&
+                          new_options) override {
+    return ForEachPartition(
+        [&](DB* db) { return db->SetDBOptions(new_options); });
+  }
+
+  using DB::Flush;
+  Status Flush(const FlushOptions& options,
+               ColumnFamilyHandle* column_family) override {
+    if (!IsDefaultColumnFamily(column_family)) {
+      return ColumnFamilyNotSupported();
+    }
+    return ForEachPartition([&](DB* db) { return db->Flush(options); });
+  }
+
+  Status Flush(
+      const FlushOptions& options,
+      const std::vector<ColumnFamilyHandle*>& column_families) override {
+    for (ColumnFamilyHandle* column_family : column_families) {
+      if (!IsDefaultColumnFamily(column_family)) {
+        return ColumnFamilyNotSupported();
+      }
+    }
+    return ForEachPartition([&](DB* db) { return db->Flush(options); });
+  }
+
+  Status SyncWAL() override {
+    return ForEachPartition([](DB* db) { return db->SyncWAL(); });
+  }
+
+  Status FlushWAL(bool sync) override {
+    return ForEachPartition([sync](DB* db) { return db->FlushWAL(sync); });
+  }
+
+ private:
+  struct ALIGN_AS(CACHE_LINE_SIZE) Partition {
+    DB* db = nullptr;
+    // Held shared by every write to the partition, and exclusively by
+    // GetSnapshot() while it snapshots all partitions
+    port::RWMutex write_mutex;
+  };
+
+  Partition& PartitionOf(const Slice& key) {
+    return *partitions_[GetPartitionIndex(key)];
+  }
+
+  // Returns InvalidArgument unless the snapshot of `options`, if any, was
+  // taken by GetSnapshot() of this DB and not released yet
+  Status CheckSnapshot(const ReadOptions& options) {
+    if (options.snapshot == nullptr) {
+      return Status::OK();
+    }
+    ReadLock lock(&snapshots_mutex_);
+    if (snapshots_.count(options.snapshot) == 0) {
+      return Status::InvalidArgument(
+          "Snapshot was not taken by GetSnapshot() of this PartitionedDB or "
+          "was released.");
+    }
+    return Status::OK();
+  }
+
+  // Replaces the snapshot of `options`, if any, by that of partition `index`.
+  // REQUIRES: CheckSnapshot(options) returned OK
+  ReadOptions PartitionReadOptions(const ReadOptions& options,
+                                   size_t index) const {
+    ReadOptions partition_options(options);
+    if (options.snapshot != nullptr) {
+      partition_options.snapshot =
+          static_cast<const PartitionedSnapshot*>(options.snapshot)
+              ->snapshots()[index];
+    }
+    return partition_options;
+  }
+
+  // Runs `fn` on every partition, in parallel, and returns the first error
+  Status ForEachPartition(const std::function<Status(DB*)>& fn) {
+    std::vector<Status> statuses(partitions_.size());
+    FanOut(fanout_pool_.get(), partitions_.size(), [&](size_t i) {
+      statuses[i] = fn(partitions_[i]->db);
+    });
+    Status s;
+    for (Status& partition_status : statuses) {
+      if (s.ok()) {
+        s = partition_status;
+      } else {
+        partition_status.PermitUncheckedError();
+      }
+    }
+    return s;
+  }
+
+  void MultiGetImpl(const ReadOptions& options, size_t num_keys,
+                    const Slice* keys, PinnableSlice* values,
+                    Status* statuses);
+
+  const Comparator* comparator_;
+  std::shared_ptr<KeyPartitioner> partitioner_;
+  std::vector<std::unique_ptr<Partition>> partitions_;
+  std::unique_ptr<ThreadPool> fanout_pool_;
+  // The snapshots returned by GetSnapshot() and not released yet
+  port::RWMutex snapshots_mutex_;
+  std::unordered_set<const Snapshot*> snapshots_;
+};
+
+namespace {
+// Splits a WriteBatch of the default column family into one per partition
+class PartitionBatchSplitter : public WriteBatch::Handler {
+ public:
+  explicit PartitionBatchSplitter(const PartitionedDB* db)
+      : db_(db), batches_(db->NumPartitions()) {}
+
+  Status PutCF(uint32_t column_family_id, const Slice& key,
+               const Slice& value) override {
+    if (column_family_id != 0) {
+      return ColumnFamilyNotSupported();
+    }
+    return WriteBatchInternal::Put(BatchOf(key), column_family_id, key, value);
+  }
+
+  Status PutEntityCF(uint32_t column_family_id, const Slice& key,
+                     const Slice& entity) override {
+    if (column_family_id != 0) {
+      return ColumnFamilyNotSupported();
+    }
+    Slice input = entity;
+    WideColumns columns;
+    Status s = WideColumnSerialization::Deserialize(input, columns);
+    if (!s.ok()) {
+      return s;
+    }
+    return WriteBatchInternal::PutEntity(BatchOf(key), column_family_id, key,
+                                         columns);
+  }
+
+  Status DeleteCF(uint32_t column_family_id, const Slice& key) override {
+    if (column_family_id != 0) {
+      return ColumnFamilyNotSupported();
+    }
+    return WriteBatchInternal::Delete(BatchOf(key), column_family_id, key);
+  }
+
+  Status SingleDeleteCF(uint32_t column_family_id, const Slice& key) override {
+    if (column_family_id != 0) {
+      return ColumnFamilyNotSupported();
+    }
+    return WriteBatchInternal::SingleDelete(BatchOf(key), column_family_id,
+                                            key);
+  }
+
+  Status DeleteRangeCF(uint32_t column_family_id, const Slice& begin_key,
+                       const Slice& end_key) override {
+    if (column_family_id != 0) {
+      return ColumnFamilyNotSupported();
+    }
+    // The keys of the range may be in any partition
+    for (size_t i = 0; i < batches_.size(); ++i) {
+      Status s = WriteBatchInternal::DeleteRange(BatchAt(i), column_family_id,
+                                                 begin_key, end_key);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    return Status::OK();
+  }
+
+  Status MergeCF(uint32_t column_family_id, const Slice& key,
+                 const Slice& value) override {
+    if (column_family_id != 0) {
+      return ColumnFamilyNotSupported();
+    }
+    return WriteBatchInternal::Merge(BatchOf(key), column_family_id, key,
+                                     value);
+  }
+
+  void LogData(const Slice& blob) override { blobs_.push_back(blob); }
+
+  // Returns the batch of partition `index`, or nullptr if the split batch
+  // has no update for it
+  WriteBatch* Finish(size_t index) {
+    WriteBatch* batch = batches_[index].get();
+    if (batch != nullptr) {
+      // The blobs do not belong to any key, so every partition written to
+      // logs them
+      for (const Slice& blob : blobs_) {
+        batch->PutLogData(blob).PermitUncheckedError();
+      }
+    }
+    return batch;
+  }
+
+ private:
+  WriteBatch* BatchOf(const Slice& key) {
+    return BatchAt(db_->GetPartitionIndex(key));
+  }
+
+  WriteBatch* BatchAt(size_t index) {
+    if (batches_[index] == nullptr) {
+      batches_[index].reset(new WriteBatch());
+    }
+    return batches_[index].get();
+  }
+
+  const PartitionedDB* db_;
+  std::vector<std::unique_ptr<WriteBatch>> batches_;
+  std::vector<Slice> blobs_;
+};
+}  // namespace
+
+Status PartitionedDBImpl::Write(const WriteOptions& options,
+                                WriteBatch* updates) {
+  if (updates == nullptr) {
+    return Status::InvalidArgument("Batch is nullptr!");
+  }
+  PartitionBatchSplitter splitter(this);
+  Status s = updates->Iterate(&splitter);
+  if (!s.ok()) {
+    return s;
+  }
+  std::vector<std::pair<size_t, WriteBatch*>> batches;
+  for (size_t i = 0; i < partitions_.size(); ++i) {
+    WriteBatch* batch = splitter.Finish(i);
+    if (batch != nullptr) {
+      batches.emplace_back(i, batch);
+    }
+  }
+  if (batches.size() <= 1) {
+    // Write the caller's batch as is, with its protection info. A batch
+    // without updates, e.g. with only LogData() records, goes to the first
+    // partition.
+    Partition& partition =
+        *partitions_[batches.empty() ? 0 : batches[0].first];
+    ReadLock lock(&partition.write_mutex);
+    return partition.db->Write(options, updates);
+  }
+  // Locked in increasing partition order, like GetSnapshot() does, so that
+  // no snapshot is taken while only part of the batch is written
+  for (auto& batch : batches) {
+    partitions_[batch.first]->write_mutex.ReadLock();
+  }
+  std::string written;
+  for (auto& batch : batches) {
+    s = partitions_[batch.first]->db->Write(options, batch.second);
+    if (!s.ok()) {
+      break;
+    }
+    written.append(written.empty() ? "" : ", ")
+        .append(std::to_string(batch.first));
+  }
+  for (auto& batch : batches) {
+    partitions_[batch.first]->write_mutex.ReadUnlock();
+  }
+  if (!s.ok() && !written.empty()) {
+    // The partitions written before the failure keep their part of the batch
+    s = Status(s.code(), s.subcode(), s.severity(),
+               std::string(s.getState() != nullptr ? s.getState() : "") +
+                   " (already written to partitions " + written + ")");
+  }
+  return s;
+}
+
+void PartitionedDBImpl::MultiGetImpl(const ReadOptions& options,
+                                     size_t num_keys, const Slice* keys,
+                                     PinnableSlice* values, Status* statuses) {
+  Status s = CheckSnapshot(options);
+  if (!s.ok()) {
+    std::fill(statuses, statuses + num_keys, s);
+    return;
+  }
+  // Group the keys by partition, keeping their order within each partition
+  struct PartitionKeys {
+    size_t partition;
+    std::vector<size_t> indices;
+    std::vector<Slice> keys;
+    std::vector<PinnableSlice> values;
+    std::vector<Status> statuses;
+  };
+  std::vector<size_t> group_of(partitions_.size(), SIZE_MAX);
+  std::vector<PartitionKeys> groups;
+  for (size_t i = 0; i < num_keys; ++i) {
+    size_t index = GetPartitionIndex(keys[i]);
+    if (group_of[index] == SIZE_MAX) {
+      group_of[index] = groups.size();
+      groups.emplace_back();
+      groups.back().partition = index;
+    }
+    PartitionKeys& group = groups[group_of[index]];
+    group.indices.push_back(i);
+    group.keys.push_back(keys[i]);
+  }
+  FanOut(fanout_pool_.get(), groups.size(), [&](size_t g) {
+    PartitionKeys& group = groups[g];
+    DB* db = partitions_[group.partition]->db;
+    size_t n = group.keys.size();
+    group.values.resize(n);
+    group.statuses.resize(n);
+    db->MultiGet(PartitionReadOptions(options, group.partition),
+                 db->DefaultColumnFamily(), n, group.keys.data(),
+                 group.values.data(), group.statuses.data());
+  });
+  for (PartitionKeys& group : groups) {
+    for (size_t j = 0; j < group.indices.size(); ++j) {
+      size_t i = group.indices[j];
+      values[i] = std::move(group.values[j]);
+      statuses[i] = std::move(group.statuses[j]);
+    }
+  }
+}
+
+std::vector<Status> PartitionedDBImpl::MultiGet(
+    const ReadOptions& options,
+    const std::vector<ColumnFamilyHandle*>& column_families,
+    const std::vector<Slice>& keys, std::vector<std::string>* values) {
+  size_t num_keys = keys.size();
+  std::vector<Status> statuses(num_keys);
+  values->resize(num_keys);
+  for (ColumnFamilyHandle* column_family : column_families) {
+    if (!IsDefaultColumnFamily(column_family)) {
+      std::fill(statuses.begin(), statuses.end(), ColumnFamilyNotSupported());
+      return statuses;
+    }
+  }
+  std::vector<PinnableSlice> pinnable_values(num_keys);
+  MultiGetImpl(options, num_keys, keys.data(), pinnable_values.data(),
+               statuses.data());
+  for (size_t i = 0; i < num_keys; ++i) {
+    if (statuses[i].ok()) {
+      (*values)[i].assign(pinnable_values[i].data(), pinnable_values[i].size());
+    }
+  }
+  return statuses;
+}
+
+void PartitionedDBImpl::MultiGet(const ReadOptions& options,
+                                 ColumnFamilyHandle* column_family,
+                                 const size_t num_keys, const Slice* keys,
+                                 PinnableSlice* values, Status* statuses,
+                                 const bool /*sorted_input*/) {
+  if (!IsDefaultColumnFamily(column_family)) {
+    std::fill(statuses, statuses + num_keys, ColumnFamilyNotSupported());
+    return;
+  }
+  MultiGetImpl(options, num_keys, keys, values, statuses);
+}
+
+const Snapshot* PartitionedDBImpl::GetSnapshot() {
+  std::vector<const Snapshot*> snapshots(partitions_.size());
+  // Wait for the writes in progress and hold off new ones, so that a write
+  // to several partitions is in either all or none of the snapshots
+  for (auto& partition : partitions_) {
+    partition->write_mutex.WriteLock();
+  }
+  bool ok = true;
+  for (size_t i = 0; i < partitions_.size(); ++i) {
+    snapshots[i] = partitions_[i]->db->GetSnapshot();
+    ok = ok && snapshots[i] != nullptr;
+  }
+  for (auto& partition : partitions_) {
+    partition->write_mutex.WriteUnlock();
+  }
+  if (!ok) {
+    // Snapshots are not supported, e.g. with inplace_update_support
+    for (size_t i = 0; i < partitions_.size(); ++i) {
+      if (snapshots[i] != nullptr) {
+        partitions_[i]->db->ReleaseSnapshot(snapshots[i]);
+      }
+    }
+    return nullptr;
+  }
+  auto snapshot = new PartitionedSnapshot(std::move(snapshots));
+  WriteLock lock(&snapshots_mutex_);
+  snapshots_.insert(snapshot);
+  return snapshot;
+}
+
+void PartitionedDBImpl::ReleaseSnapshot(const Snapshot* snapshot) {
+  if (snapshot == nullptr) {
+    return;
+  }
+  {
+    WriteLock lock(&snapshots_mutex_);
+    if (snapshots_.erase(snapshot) == 0) {
+      // Not ours, or already released
+      return;
+    }
+  }
+  auto partitioned = static_cast<const PartitionedSnapshot*>(snapshot);
+  for (size_t i = 0; i < partitions_.size(); ++i) {
+    partitions_[i]->db->ReleaseSnapshot(partitioned->snapshots()[i]);
+  }
+  delete partitioned;
+}
+
+std::shared_ptr<KeyPartitioner> NewHashKeyPartitioner() {
+  return std::make_shared<HashKeyPartitioner>();
+}
+
+Status PartitionedDB::Open(const Options& options,
+                           const PartitionedDBOptions& partitioned_options,
+                           const std::string& dbname, PartitionedDB** dbptr) {
+  *dbptr = nullptr;
+  const size_t num_partitions = partitioned_options.num_partitions;
+  if (num_partitions == 0) {
+    return Status::InvalidArgument("num_partitions must be positive.");
+  }
+  if (options.comparator->timestamp_size() > 0) {
+    return Status::NotSupported(
+        "PartitionedDB does not support user-defined timestamps.");
+  }
+  Env* env = options.env;
+  Status s;
+  if (options.create_if_missing) {
+    s = env->CreateDirIfMissing(dbname);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  // Keys would be looked up in the wrong partitions if their number changed
+  bool has_first = env->FileExists(PartitionName(dbname, 0)).ok();
+  bool has_last =
+      env->FileExists(PartitionName(dbname, num_partitions - 1)).ok();
+  bool has_more = env->FileExists(PartitionName(dbname, num_partitions)).ok();
+  if (has_more || has_first != has_last) {
+    return Status::InvalidArgument(
+        dbname, "was created with a different number of partitions.");
+  }
+
+  PartitionedDBOptions popts(partitioned_options);
+  if (popts.partitioner == nullptr) {
+    popts.partitioner = NewHashKeyPartitioner();
+  }
+  Options partition_options(options);
+  if (partition_options.write_buffer_manager == nullptr &&
+      partition_options.db_write_buffer_size > 0) {
+    partition_options.write_buffer_manager =
+        std::make_shared<WriteBufferManager>(
+            partition_options.db_write_buffer_size);
+  }
+  std::unique_ptr<ThreadPool> fanout_pool;
+  if (popts.fanout_threads > 0) {
+    fanout_pool.reset(NewThreadPool(popts.fanout_threads));
+  }
+
+  std::vector<DB*> dbs(num_partitions, nullptr);
+  std::vector<Status> statuses(num_partitions);
+  FanOut(fanout_pool.get(), num_partitions, [&](size_t i) {
+    statuses[i] =
+        DB::Open(partition_options, PartitionName(dbname, i), &dbs[i]);
+  });
+  for (Status& partition_status : statuses) {
+    if (s.ok()) {
+      s = partition_status;
+    } else {
+      partition_status.PermitUncheckedError();
+    }
+  }
+  if (!s.ok()) {
+    for (DB* db : dbs) {
+      delete db;
+    }
+    if (fanout_pool != nullptr) {
+      fanout_pool->JoinAllThreads();
+    }
+    return s;
+  }
+  *dbptr = new PartitionedDBImpl(options, popts, std::move(dbs),
+                                 std::move(fanout_pool));
+  return Status::OK();
+}
+
+Status DestroyPartitionedDB(const std::string& dbname, const Options& options,
+                           const PartitionedDBOptions& partitioned_options) {
+  Status s;
+  for (size_t i = 0; i < partitioned_options.num_partitions; ++i) {
+    std::string name = PartitionName(dbname, i);
+    if (options.env->FileExists(name).IsNotFound()) {
+      continue;
+    }
+    Status partition_status = DestroyDB(name, options);
+    if (s.ok()) {
+      s = partition_status;
+    } else {
+      partition_status.PermitUncheckedError();
+    }
+  }
+  if (s.ok()) {
+    // Fails if the directory holds anything else, like the info log
+    options.env->DeleteDir(dbname).PermitUncheckedError();
+  }
+  return s;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
@@ -0,0 +1,519 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+
+#include "rocksdb/utilities/partitioned_db.h"
+
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "port/stack_trace.h"
+#include "rocksdb/write_buffer_manager.h"
+#include "test_util/testharness.h"
+#include "test_util/testutil.h"
+#include "utilities/merge_operators.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class PartitionedDBTest : public testing::Test {
+ public:
+  PartitionedDBTest() {
+    dbname_ = test::PerThreadDBPath("partitioned_db_test");
+    options_.create_if_missing = true;
+    options_.env = Env::Default();
+    partitioned_options_.num_partitions = 4;
+    EXPECT_OK(DestroyPartitionedDB(dbname_, options_, partitioned_options_));
+  }
+
+  ~PartitionedDBTest() override {
+    CloseDB();
+    EXPECT_OK(DestroyPartitionedDB(dbname_, options_, partitioned_options_));
+  }
+
+  Status OpenDB() {
+    PartitionedDB* db = nullptr;
+    Status s =
+        PartitionedDB::Open(options_, partitioned_options_, dbname_, &db);
+    db_.reset(db);
+    return s;
+  }
+
+  void CloseDB() {
+    if (db_ != nullptr) {
+      EXPECT_OK(db_->Close());
+      db_.reset();
+    }
+  }
+
+  static std::string Key(int i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "key%06d", i);
+    return buf;
+  }
+
+  // Returns keys [0, n) in different partitions
+  std::vector<std::string> KeysInDifferentPartitions(size_t n) {
+    std::vector<std::string> keys(n);
+    std::vector<bool> found(db_->NumPartitions(), false);
+    size_t num_found = 0;
+    for (int i = 0; num_found < n; ++i) {
+      std::string key = Key(i);
+      size_t index = db_->GetPartitionIndex(key);
+      if (!found[index]) {
+        found[index] = true;
+        keys[num_found++] = key;
+      }
+    }
+    return keys;
+  }
+
+  // Checks that forward and backward iteration returns `expected`
+  void VerifyIteration(const std::map<std::string, std::string>& expected,
+                       const ReadOptions& read_options = ReadOptions()) {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    auto it = expected.begin();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++it) {
+      ASSERT_TRUE(it != expected.end());
+      ASSERT_EQ(it->first, iter->key().ToString());
+      ASSERT_EQ(it->second, iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(it == expected.end());
+
+    auto rit = expected.rbegin();
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev(), ++rit) {
+      ASSERT_TRUE(rit != expected.rend());
+      ASSERT_EQ(rit->first, iter->key().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(rit == expected.rend());
+  }
+
+  std::string dbname_;
+  Options options_;
+  PartitionedDBOptions partitioned_options_;
+  std::unique_ptr<PartitionedDB> db_;
+};
+
+TEST_F(PartitionedDBTest, RoutesKeysToPartitions) {
+  ASSERT_OK(OpenDB());
+  ASSERT_EQ(4U, db_->NumPartitions());
+  const int kNumKeys = 1000;
+  std::vector<int> keys_per_partition(db_->NumPartitions());
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(db_->Put(WriteOptions(), Key(i), "v" + std::to_string(i)));
+  }
+  for (int i = 0; i < kNumKeys; ++i) {
+    std::string value;
+    ASSERT_OK(db_->Get(ReadOptions(), Key(i), &value));
+    ASSERT_EQ("v" + std::to_string(i), value);
+    size_t index = db_->GetPartitionIndex(Key(i));
+    ++keys_per_partition[index];
+    for (size_t p = 0; p < db_->NumPartitions(); ++p) {
+      Status s = db_->GetPartition(p)->Get(ReadOptions(), Key(i), &value);
+      if (p == index) {
+        ASSERT_OK(s);
+      } else {
+        ASSERT_TRUE(s.IsNotFound());
+      }
+    }
+  }
+  for (int count : keys_per_partition) {
+    ASSERT_GT(count, kNumKeys / 8);
+  }
+
+  ASSERT_OK(db_->Delete(WriteOptions(), Key(1)));
+  std::string value;
+  ASSERT_TRUE(db_->Get(ReadOptions(), Key(1), &value).IsNotFound());
+
+  // Data and routing survive a reopen
+  CloseDB();
+  ASSERT_OK(OpenDB());
+  ASSERT_OK(db_->Get(ReadOptions(), Key(2), &value));
+  ASSERT_EQ("v2", value);
+  ASSERT_TRUE(db_->Get(ReadOptions(), Key(1), &value).IsNotFound());
+}
+
+TEST_F(PartitionedDBTest, NumPartitionsCannotChange) {
+  ASSERT_OK(OpenDB());
+  CloseDB();
+  PartitionedDBOptions saved = partitioned_options_;
+  partitioned_options_.num_partitions = 3;
+  ASSERT_TRUE(OpenDB().IsInvalidArgument());
+  partitioned_options_.num_partitions = 5;
+  ASSERT_TRUE(OpenDB().IsInvalidArgument());
+  partitioned_options_ = saved;
+  ASSERT_OK(OpenDB());
+}
+
+TEST_F(PartitionedDBTest, SharesWriteBufferManager) {
+  options_.db_write_buffer_size = 1 << 20;
+  ASSERT_OK(OpenDB());
+  std::shared_ptr<WriteBufferManager> wbm =
+      db_->GetPartition(0)->GetDBOptions().write_buffer_manager;
+  ASSERT_NE(nullptr, wbm);
+  ASSERT_EQ(options_.db_write_buffer_size, wbm->buffer_size());
+  for (size_t i = 1; i < db_->NumPartitions(); ++i) {
+    ASSERT_EQ(wbm, db_->GetPartition(i)->GetDBOptions().write_buffer_manager);
+  }
+}
+
+TEST_F(PartitionedDBTest, WriteBatchSpanningPartitions) {
+  options_.merge_operator = MergeOperators::CreateStringAppendOperator();
+  ASSERT_OK(OpenDB());
+  std::map<std::string, std::string> expected;
+  WriteBatch batch;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(batch.Put(Key(i), "v"));
+    expected[Key(i)] = "v";
+  }
+  ASSERT_OK(batch.Delete(Key(3)));
+  expected.erase(Key(3));
+  ASSERT_OK(batch.Merge(Key(4), "w"));
+  expected[Key(4)] = "v,w";
+  ASSERT_OK(batch.DeleteRange(Key(10), Key(20)));
+  for (int i = 10; i < 20; ++i) {
+    expected.erase(Key(i));
+  }
+  ASSERT_OK(db_->Write(WriteOptions(), &batch));
+  VerifyIteration(expected);
+
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(50), Key(60)));
+  for (int i = 50; i < 60; ++i) {
+    expected.erase(Key(i));
+  }
+  VerifyIteration(expected);
+}
+
+TEST_F(PartitionedDBTest, MergedIterator) {
+  ASSERT_OK(OpenDB());
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < 500; i += 2) {
+    ASSERT_OK(db_->Put(WriteOptions(), Key(i), "v" + std::to_string(i)));
+    expected[Key(i)] = "v" + std::to_string(i);
+  }
+  // Some keys in files, others in memtables
+  ASSERT_OK(db_->Flush(FlushOptions()));
+  for (int i = 500; i < 600; i += 2) {
+    ASSERT_OK(db_->Put(WriteOptions(), Key(i), "v" + std::to_string(i)));
+    expected[Key(i)] = "v" + std::to_string(i);
+  }
+  VerifyIteration(expected);
+
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  iter->Seek(Key(101));
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(Key(102), iter->key().ToString());
+  // Switch directions on the way
+  iter->Prev();
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(Key(100), iter->key().ToString());
+  iter->Prev();
+  ASSERT_EQ(Key(98), iter->key().ToString());
+  iter->Next();
+  ASSERT_EQ(Key(100), iter->key().ToString());
+  iter->Next();
+  ASSERT_EQ(Key(102), iter->key().ToString());
+  iter->SeekForPrev(Key(101));
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(Key(100), iter->key().ToString());
+  iter->Next();
+  ASSERT_EQ(Key(102), iter->key().ToString());
+  iter->Seek(Key(599));
+  ASSERT_FALSE(iter->Valid());
+  ASSERT_OK(iter->status());
+}
+
+TEST_F(PartitionedDBTest, MultiGet) {
+  ASSERT_OK(OpenDB());
+  for (int i = 0; i < 100; i += 2) {
+    ASSERT_OK(db_->Put(WriteOptions(), Key(i), "v" + std::to_string(i)));
+  }
+  std::vector<std::string> key_strs;
+  for (int i = 0; i < 100; ++i) {
+    key_strs.push_back(Key(i));
+  }
+  std::vector<Slice> keys(key_strs.begin(), key_strs.end());
+
+  std::vector<std::string> values;
+  std::vector<Status> statuses = db_->MultiGet(ReadOptions(), keys, &values);
+  ASSERT_EQ(keys.size(), statuses.size());
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2 == 0) {
+      ASSERT_OK(statuses[i]);
+      ASSERT_EQ("v" + std::to_string(i), values[i]);
+    } else {
+      ASSERT_TRUE(statuses[i].IsNotFound());
+    }
+  }
+
+  std::vector<PinnableSlice> pinnable_values(keys.size());
+  std::vector<Status> batched_statuses(keys.size());
+  db_->MultiGet(ReadOptions(), db_->DefaultColumnFamily(), keys.size(),
+                keys.data(), pinnable_values.data(), batched_statuses.data());
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2 == 0) {
+      ASSERT_OK(batched_statuses[i]);
+      ASSERT_EQ("v" + std::to_string(i), pinnable_values[i].ToString());
+    } else {
+      ASSERT_TRUE(batched_statuses[i].IsNotFound());
+    }
+  }
+}
+
+TEST_F(PartitionedDBTest, Snapshot) {
+  ASSERT_OK(OpenDB());
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(db_->Put(WriteOptions(), Key(i), "old"));
+  }
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_NE(nullptr, snapshot);
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < 100; ++i) {
+    expected[Key(i)] = "old";
+    ASSERT_OK(db_->Put(WriteOptions(), Key(i), "new"));
+  }
+  ASSERT_OK(db_->Put(WriteOptions(), Key(100), "new"));
+
+  ReadOptions read_options;
+  read_options.snapshot = snapshot;
+  std::string value;
+  ASSERT_OK(db_->Get(read_options, Key(7), &value));
+  ASSERT_EQ("old", value);
+  ASSERT_TRUE(db_->Get(read_options, Key(100), &value).IsNotFound());
+  VerifyIteration(expected, read_options);
+  std::vector<std::string> values;
+  std::vector<Status> statuses =
+      db_->MultiGet(read_options, {Key(1), Key(2), Key(100)}, &values);
+  ASSERT_EQ("old", values[0]);
+  ASSERT_EQ("old", values[1]);
+  ASSERT_TRUE(statuses[2].IsNotFound());
+  db_->ReleaseSnapshot(snapshot);
+}
+
+TEST_F(PartitionedDBTest, ForeignSnapshot) {
+  ASSERT_OK(OpenDB());
+  ASSERT_OK(db_->Put(WriteOptions(), Key(0), "value"));
+  DB* partition = db_->GetPartition(0);
+  const Snapshot* snapshot = partition->GetSnapshot();
+
+  ReadOptions read_options;
+  read_options.snapshot = snapshot;
+  std::string value;
+  ASSERT_TRUE(db_->Get(read_options, Key(0), &value).IsInvalidArgument());
+  std::vector<std::string> values;
+  std::vector<Status> statuses =
+      db_->MultiGet(read_options, {Key(0), Key(1)}, &values);
+  ASSERT_TRUE(statuses[0].IsInvalidArgument());
+  ASSERT_TRUE(statuses[1].IsInvalidArgument());
+  std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+  ASSERT_TRUE(iter->status().IsInvalidArgument());
+  iter.reset();
+
+  // Not released by the PartitionedDB, which does not own it
+  db_->ReleaseSnapshot(snapshot);
+  partition->ReleaseSnapshot(snapshot);
+}
+
+TEST_F(PartitionedDBTest, SnapshotSeesWholeBatches) {
+  ASSERT_OK(OpenDB());
+  std::vector<std::string> keys = KeysInDifferentPartitions(2);
+  std::atomic<bool> stop{false};
+  // Every batch updates both keys to the same value
+  std::thread writer([&]() {
+    for (int i = 0; !stop.load(); ++i) {
+      WriteBatch batch;
+      ASSERT_OK(batch.Put(keys[0], std::to_string(i)));
+      ASSERT_OK(batch.Put(keys[1], std::to_string(i)));
+      ASSERT_OK(db_->Write(WriteOptions(), &batch));
+    }
+  });
+  for (int i = 0; i < 200; ++i) {
+    ManagedSnapshot snapshot(db_.get());
+    ReadOptions read_options;
+    read_options.snapshot = snapshot.snapshot();
+    std::string value0, value1;
+    Status s0 = db_->Get(read_options, keys[0], &value0);
+    Status s1 = db_->Get(read_options, keys[1], &value1);
+    ASSERT_EQ(s0.IsNotFound(), s1.IsNotFound());
+    ASSERT_EQ(value0, value1);
+  }
+  stop.store(true);
+  writer.join();
+}
+
+TEST_F(PartitionedDBTest, CompactRange) {
+  options_.disable_auto_compactions = true;
+  ASSERT_OK(OpenDB());
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 200; ++i) {
+      ASSERT_OK(db_->Put(WriteOptions(), Key(i), std::to_string(round)));
+    }
+    ASSERT_OK(db_->Flush(FlushOptions()));
+  }
+  for (size_t p = 0; p < db_->NumPartitions(); ++p) {
+    std::string files;
+    ASSERT_TRUE(db_->GetPartition(p)->GetProperty(
+        "rocksdb.num-files-at-level0", &files));
+    ASSERT_EQ("3", files);
+  }
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  for (size_t p = 0; p < db_->NumPartitions(); ++p) {
+    std::string files;
+    ASSERT_TRUE(db_->GetPartition(p)->GetProperty(
+        "rocksdb.num-files-at-level0", &files));
+    ASSERT_EQ("0", files);
+  }
+  std::string value;
+  ASSERT_OK(db_->Get(ReadOptions(), Key(5), &value));
+  ASSERT_EQ("2", value);
+  uint64_t num_keys = 0;
+  ASSERT_TRUE(
+      db_->GetAggregatedIntProperty("rocksdb.estimate-num-keys", &num_keys));
+  ASSERT_EQ(200U, num_keys);
+}
+
+TEST_F(PartitionedDBTest, FanOutOnCallingThread) {
+  partitioned_options_.fanout_threads = 0;
+  ASSERT_OK(OpenDB());
+  for (int i = 0; i < 50; ++i) {
+    ASSERT_OK(db_->Put(WriteOptions(), Key(i), "v"));
+  }
+  ASSERT_OK(db_->Flush(FlushOptions()));
+  std::vector<std::string> values;
+  std::vector<Status> statuses =
+      db_->MultiGet(ReadOptions(), {Key(0), Key(49), Key(50)}, &values);
+  ASSERT_OK(statuses[0]);
+  ASSERT_OK(statuses[1]);
+  ASSERT_TRUE(statuses[2].IsNotFound());
+}
+
+TEST_F(PartitionedDBTest, OtherColumnFamiliesNotSupported) {
+  ASSERT_OK(OpenDB());
+  ColumnFamilyHandle* cf = nullptr;
+  ASSERT_OK(db_->GetPartition(0)->CreateColumnFamily(ColumnFamilyOptions(),
+                                                     "other", &cf));
+  ASSERT_TRUE(db_->Put(WriteOptions(), cf, "key", "value").IsNotSupported());
+  std::string value;
+  ASSERT_TRUE(db_->Get(ReadOptions(), cf, "key", &value).IsNotSupported());
+  WriteBatch batch;
+  ASSERT_OK(batch.Put(cf, "key", "value"));
+  ASSERT_TRUE(db_->Write(WriteOptions(), &batch).IsNotSupported());
+  ASSERT_OK(db_->GetPartition(0)->DestroyColumnFamilyHandle(cf));
+}
+
+TEST_F(PartitionedDBTest, LogDataOnlyBatch) {
+  ASSERT_OK(OpenDB());
+  std::vector<uint64_t> wal_sizes(db_->NumPartitions());
+  for (size_t i = 0; i < db_->NumPartitions(); ++i) {
+    std::unique_ptr<LogFile> wal;
+    ASSERT_OK(db_->GetPartition(i)->GetCurrentWalFile(&wal));
+    wal_sizes[i] = wal->SizeFileBytes();
+  }
+  WriteBatch batch;
+  ASSERT_OK(batch.PutLogData("blob"));
+  ASSERT_OK(db_->Write(WriteOptions(), &batch));
+  // Only the first partition logs it
+  for (size_t i = 0; i < db_->NumPartitions(); ++i) {
+    std::unique_ptr<LogFile> wal;
+    ASSERT_OK(db_->GetPartition(i)->GetCurrentWalFile(&wal));
+    if (i == 0) {
+      ASSERT_GT(wal->SizeFileBytes(), wal_sizes[i]);
+    } else {
+      ASSERT_EQ(wal->SizeFileBytes(), wal_sizes[i]);
+    }
+  }
+}
+
+TEST_F(PartitionedDBTest, GetMergeOperands) {
+  options_.merge_operator = MergeOperators::CreateStringAppendOperator();
+  ASSERT_OK(OpenDB());
+  std::vector<std::string> keys = KeysInDifferentPartitions(2);
+  for (const std::string& key : keys) {
+    ASSERT_OK(db_->Merge(WriteOptions(), key, "a"));
+    ASSERT_OK(db_->Merge(WriteOptions(), key, "b"));
+  }
+  for (const std::string& key : keys) {
+    std::vector<PinnableSlice> operands(2);
+    GetMergeOperandsOptions merge_operands_options;
+    merge_operands_options.expected_max_number_of_operands = 2;
+    int number_of_operands = 0;
+    ASSERT_OK(db_->GetMergeOperands(ReadOptions(), db_->DefaultColumnFamily(),
+                                    key, operands.data(),
+                                    &merge_operands_options,
+                                    &number_of_operands));
+    ASSERT_EQ(2, number_of_operands);
+    ASSERT_EQ("a", operands[0]);
+    ASSERT_EQ("b", operands[1]);
+  }
+}
+
+TEST_F(PartitionedDBTest, SetOptionsOfEveryPartition) {
+  ASSERT_OK(OpenDB());
+  ASSERT_OK(db_->SetOptions({{"disable_auto_compactions", "true"}}));
+  ASSERT_OK(db_->SetDBOptions({{"max_background_jobs", "5"}}));
+  for (size_t i = 0; i < db_->NumPartitions(); ++i) {
+    ASSERT_TRUE(db_->GetPartition(i)->GetOptions().disable_auto_compactions);
+    ASSERT_EQ(5, db_->GetPartition(i)->GetDBOptions().max_background_jobs);
+  }
+}
+
+TEST_F(PartitionedDBTest, FileAndTimestampMethodsNotSupported) {
+  ASSERT_OK(OpenDB());
+  ASSERT_OK(db_->Put(WriteOptions(), "key", "value"));
+  ASSERT_OK(db_->Flush(FlushOptions()));
+  ColumnFamilyHandle* cf = nullptr;
+  ASSERT_TRUE(db_->CreateColumnFamily(ColumnFamilyOptions(), "other", &cf)
+                  .IsNotSupported());
+  ASSERT_EQ(nullptr, cf);
+  ASSERT_TRUE(db_->IngestExternalFile({dbname_ + "/file.sst"},
+                                      IngestExternalFileOptions())
+                  .IsNotSupported());
+  std::vector<LiveFileMetaData> files;
+  db_->GetPartition(db_->GetPartitionIndex("key"))
+      ->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(1, files.size());
+  ASSERT_TRUE(db_->CompactFiles(CompactionOptions(), {files[0].name}, 1)
+                  .IsNotSupported());
+  ASSERT_TRUE(db_->DeleteFile(files[0].name).IsNotSupported());
+  ASSERT_TRUE(db_->PromoteL0(db_->DefaultColumnFamily(), 1).IsNotSupported());
+  std::unique_ptr<TransactionLogIterator> iter;
+  ASSERT_TRUE(
+      db_->GetUpdatesSince(0, &iter, TransactionLogIterator::ReadOptions())
+          .IsNotSupported());
+  ASSERT_TRUE(db_->Put(WriteOptions(), db_->DefaultColumnFamily(), "key",
+                       "ts", "value")
+                  .IsNotSupported());
+  std::string value;
+  ASSERT_OK(db_->Get(ReadOptions(), "key", &value));
+  ASSERT_EQ("value", value);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#else
+#include <stdio.h>
+
+int main(int /*argc*/, char** /*argv*/) {
+  fprintf(stderr,
+          "SKIPPED as PartitionedDB is not supported in ROCKSDB_LITE\n");
+  return 0;
+}
+
+#endif  // !ROCKSDB_LITE
@@ -0,0 +1,298 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "rocksdb/utilities/sim_cache.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// The sampling decision looks at the low kSamplingBits bits of a seeded key
+// hash, so that it is independent of how the wrapped cache shards its keys.
+constexpr int kSamplingBits = 24;
+constexpr uint64_t kSamplingModulus = uint64_t{1} << kSamplingBits;
+constexpr uint64_t kSamplingSeed = 0x5A8D5A8D;
+
+class MissRatioCurveCacheImpl : public MissRatioCurveCache {
+ public:
+  MissRatioCurveCacheImpl(std::shared_ptr<Cache> cache,
+                          std::vector<size_t> capacities,
+                          uint64_t sampling_threshold)
+      : cache_(std::move(cache)),
+        sampling_threshold_(sampling_threshold),
+        sampled_lookups_(0) {
+    std::sort(capacities.begin(), capacities.end());
+    capacities.erase(std::unique(capacities.begin(), capacities.end()),
+                     capacities.end());
+    sims_.reserve(capacities.size());
+    for (size_t capacity : capacities) {
+      sims_.emplace_back(capacity, GetSamplingRate());
+    }
+  }
+
+  ~MissRatioCurveCacheImpl() override {}
+
+  void SetCapacity(size_t capacity) override { cache_->SetCapacity(capacity); }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) override {
+    cache_->SetStrictCapacityLimit(strict_capacity_limit);
+  }
+
+  using Cache::Insert;
+  Status Insert(const Slice& key, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value), Handle** handle,
+                Priority priority) override {
+    if (IsSampled(key)) {
+      SimulateInsert(key, charge, priority);
+    }
+    return cache_->Insert(key, value, charge, deleter, handle, priority);
+  }
+
+  Status Insert(const Slice& key, void* value, const CacheItemHelper* helper,
+                size_t charge, Handle** handle = nullptr,
+                Priority priority = Priority::LOW) override {
+    if (IsSampled(key)) {
+      SimulateInsert(key, charge, priority);
+    }
+    return cache_->Insert(key, value, helper, charge, handle, priority);
+  }
+
+  using Cache::Lookup;
+  Handle* Lookup(const Slice& key, Statistics* stats) override {
+    Handle* h = cache_->Lookup(key, stats);
+    if (IsSampled(key)) {
+      SimulateLookup(key, h, Priority::LOW);
+    }
+    return h;
+  }
+
+  Handle* Lookup(const Slice& key, const CacheItemHelper* helper_cb,
+                 const CreateCallback& create_cb, Priority priority, bool wait,
+                 Statistics* stats = nullptr) override {
+    Handle* h = cache_->Lookup(key, helper_cb, create_cb, priority, wait, stats);
+    if (IsSampled(key)) {
+      SimulateLookup(key, h, priority);
+    }
+    return h;
+  }
+
+  bool Ref(Handle* handle) override { return cache_->Ref(handle); }
+
+  using Cache::Release;
+  bool Release(Handle* handle, bool erase_if_last_ref = false) override {
+    return cache_->Release(handle, erase_if_last_ref);
+  }
+
+  bool Release(Handle* handle, bool useful, bool erase_if_last_ref) override {
+    return cache_->Release(handle, useful, erase_if_last_ref);
+  }
+
+  bool IsReady(Handle* handle) override { return cache_->IsReady(handle); }
+
+  void Wait(Handle* handle) override { cache_->Wait(handle); }
+
+  void WaitAll(std::vector<Handle*>& handles) override {
+    cache_->WaitAll(handles);
+  }
+
+  void Erase(const Slice& key) override {
+    cache_->Erase(key);
+    if (IsSampled(key)) {
+      for (auto& sim : sims_) {
+        sim.cache->Erase(key);
+      }
+    }
+  }
+
+  void* Value(Handle* handle) override { return cache_->Value(handle); }
+
+  uint64_t NewId() override { return cache_->NewId(); }
+
+  size_t GetCapacity() const override { return cache_->GetCapacity(); }
+
+  bool HasStrictCapacityLimit() const override {
+    return cache_->HasStrictCapacityLimit();
+  }
+
+  size_t GetUsage() const override { return cache_->GetUsage(); }
+
+  size_t GetUsage(Handle* handle) const override {
+    return cache_->GetUsage(handle);
+  }
+
+  size_t GetCharge(Handle* handle) const override {
+    return cache_->GetCharge(handle);
+  }
+
+  DeleterFn GetDeleter(Handle* handle) const override {
+    return cache_->GetDeleter(handle);
+  }
+
+  size_t GetPinnedUsage() const override { return cache_->GetPinnedUsage(); }
+
+  void DisownData() override {
+    cache_->DisownData();
+    for (auto& sim : sims_) {
+      sim.cache->DisownData();
+    }
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t),
+                              bool thread_safe) override {
+    // only apply to cache_ since the simulated caches don't hold values
+    cache_->ApplyToAllCacheEntries(callback, thread_safe);
+  }
+
+  void ApplyToAllEntries(
+      const std::function<void(const Slice& key, void* value, size_t charge,
+                               DeleterFn deleter)>& callback,
+      const ApplyToAllEntriesOptions& opts) override {
+    cache_->ApplyToAllEntries(callback, opts);
+  }
+
+  void EraseUnRefEntries() override {
+    cache_->EraseUnRefEntries();
+    for (auto& sim : sims_) {
+      sim.cache->EraseUnRefEntries();
+    }
+  }
+
+  std::string GetPrintableOptions() const override {
+    std::string ret = cache_->GetPrintableOptions();
+    ret.append("    miss_ratio_curve_sampling_rate: ");
+    ret.append(std::to_string(GetSamplingRate()));
+    ret.append("\n    miss_ratio_curve_capacities:");
+    for (const auto& sim : sims_) {
+      ret.append(" ");
+      ret.append(std::to_string(sim.capacity));
+    }
+    ret.append("\n");
+    return ret;
+  }
+
+  double GetSamplingRate() const override {
+    return static_cast<double>(sampling_threshold_) / kSamplingModulus;
+  }
+
+  uint64_t GetSampledLookups() const override {
+    return sampled_lookups_.load(std::memory_order_relaxed);
+  }
+
+  std::vector<std::pair<size_t, double>> GetMissRatioCurve() const override {
+    std::vector<std::pair<size_t, double>> curve;
+    curve.reserve(sims_.size());
+    uint64_t lookups = GetSampledLookups();
+    for (const auto& sim : sims_) {
+      uint64_t misses = sim.misses.load(std::memory_order_relaxed);
+      // The counters are not updated atomically together
+      double miss_ratio =
+          lookups == 0 ? 0.0
+                       : std::min(1.0, static_cast<double>(misses) / lookups);
+      curve.emplace_back(sim.capacity, miss_ratio);
+    }
+    return curve;
+  }
+
+  void ResetMissRatioCurve() override {
+    sampled_lookups_.store(0, std::memory_order_relaxed);
+    for (auto& sim : sims_) {
+      sim.misses.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  // A key-only LRU cache simulating the block cache at one capacity for the
+  // sampled keys
+  struct SimulatedCache {
+    SimulatedCache(size_t _capacity, double sampling_rate)
+        : capacity(_capacity), misses(0) {
+      LRUCacheOptions co;
+      co.capacity = static_cast<size_t>(
+          std::llround(static_cast<double>(capacity) * sampling_rate));
+      // The sampled keys are few enough not to need sharding, and sharding
+      // a small scaled-down capacity would make it less accurate
+      co.num_shard_bits = 0;
+      co.metadata_charge_policy = kDontChargeCacheMetadata;
+      cache = NewLRUCache(co);
+    }
+    SimulatedCache(SimulatedCache&& other) noexcept
+        : capacity(other.capacity),
+          cache(std::move(other.cache)),
+          misses(other.misses.load(std::memory_order_relaxed)) {}
+
+    size_t capacity;
+    std::shared_ptr<Cache> cache;
+    std::atomic<uint64_t> misses;
+  };
+
+  bool IsSampled(const Slice& key) const {
+    return (GetSliceNPHash64(key, kSamplingSeed) & (kSamplingModulus - 1)) <
+           sampling_threshold_;
+  }
+
+  static void NoopDeleter(const Slice& /*key*/, void* /*value*/) {}
+
+  void SimulateInsert(const Slice& key, size_t charge, Priority priority) {
+    for (auto& sim : sims_) {
+      Handle* h = sim.cache->Lookup(key);
+      if (h == nullptr) {
+        sim.cache->Insert(key, nullptr, charge, &NoopDeleter, nullptr, priority)
+            .PermitUncheckedError();
+      } else {
+        sim.cache->Release(h);
+      }
+    }
+  }
+
+  // `h` is the result of the lookup in the wrapped cache. A simulated miss
+  // on a key the wrapped cache has is followed by no Insert(), so the key is
+  // inserted into the simulated cache right away instead.
+  void SimulateLookup(const Slice& key, Handle* h, Priority priority) {
+    sampled_lookups_.fetch_add(1, std::memory_order_relaxed);
+    size_t charge = 0;
+    if (h != nullptr && cache_->Value(h) != nullptr) {
+      charge = cache_->GetCharge(h);
+    }
+    for (auto& sim : sims_) {
+      Handle* sim_h = sim.cache->Lookup(key);
+      if (sim_h != nullptr) {
+        sim.cache->Release(sim_h);
+        continue;
+      }
+      sim.misses.fetch_add(1, std::memory_order_relaxed);
+      if (charge > 0) {
+        sim.cache->Insert(key, nullptr, charge, &NoopDeleter, nullptr, priority)
+            .PermitUncheckedError();
+      }
+    }
+  }
+
+  std::shared_ptr<Cache> cache_;
+  const uint64_t sampling_threshold_;
+  std::atomic<uint64_t> sampled_lookups_;
+  std::vector<SimulatedCache> sims_;
+};
+
+}  // end anonymous namespace
+
+std::shared_ptr<MissRatioCurveCache> NewMissRatioCurveCache(
+    std::shared_ptr<Cache> cache, const MissRatioCurveCacheOptions& options) {
+  if (cache == nullptr || options.capacities.empty() ||
+      !(options.sampling_rate > 0.0 && options.sampling_rate <= 1.0)) {
+    return nullptr;
+  }
+  uint64_t sampling_threshold = std::max<uint64_t>(
+      1, static_cast<uint64_t>(options.sampling_rate * kSamplingModulus));
+  return std::make_shared<MissRatioCurveCacheImpl>(
+      std::move(cache), options.capacities, sampling_threshold);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -217,6 +217,109 @@ TEST_F(SimCacheTest, SimCacheLogging) {
   ASSERT_GT(fsize, max_size - 100);
 }
 
+TEST_F(SimCacheTest, MissRatioCurveCache) {
+  MissRatioCurveCacheOptions mrc_options;
+  mrc_options.capacities = {100, 10};
+  mrc_options.sampling_rate = 1.0;
+  std::shared_ptr<MissRatioCurveCache> mrc_cache =
+      NewMissRatioCurveCache(NewLRUCache(1000, 0), mrc_options);
+  ASSERT_NE(mrc_cache, nullptr);
+  ASSERT_EQ(1.0, mrc_cache->GetSamplingRate());
+
+  // Cycle through 50 unit-charge entries, which only fit in the larger
+  // simulated capacity.
+  auto cycle = [&](int times) {
+    for (int t = 0; t < times; t++) {
+      for (int i = 0; i < 50; i++) {
+        std::string key = "k" + std::to_string(i);
+        Cache::Handle* h = mrc_cache->Lookup(key);
+        if (h == nullptr) {
+          ASSERT_OK(mrc_cache->Insert(
+              key, nullptr, 1, [](const Slice& /*k*/, void* /*v*/) {}));
+        } else {
+          mrc_cache->Release(h);
+        }
+      }
+    }
+  };
+  cycle(10);
+  ASSERT_EQ(500, mrc_cache->GetSampledLookups());
+  auto curve = mrc_cache->GetMissRatioCurve();
+  ASSERT_EQ(2, curve.size());
+  ASSERT_EQ(10, curve[0].first);
+  ASSERT_EQ(1.0, curve[0].second);
+  ASSERT_EQ(100, curve[1].first);
+  ASSERT_DOUBLE_EQ(0.1, curve[1].second);
+
+  // The simulated caches stay warm across a reset
+  mrc_cache->ResetMissRatioCurve();
+  ASSERT_EQ(0, mrc_cache->GetSampledLookups());
+  cycle(1);
+  curve = mrc_cache->GetMissRatioCurve();
+  ASSERT_EQ(1.0, curve[0].second);
+  ASSERT_EQ(0.0, curve[1].second);
+
+  // Only about the requested fraction of the keys is simulated
+  mrc_options.sampling_rate = 0.25;
+  mrc_cache = NewMissRatioCurveCache(NewLRUCache(1000), mrc_options);
+  ASSERT_NE(mrc_cache, nullptr);
+  for (int i = 0; i < 10000; i++) {
+    ASSERT_EQ(nullptr, mrc_cache->Lookup("k" + std::to_string(i)));
+  }
+  ASSERT_GT(mrc_cache->GetSampledLookups(), 2000);
+  ASSERT_LT(mrc_cache->GetSampledLookups(), 3000);
+
+  mrc_options.sampling_rate = 0.0;
+  ASSERT_EQ(nullptr, NewMissRatioCurveCache(NewLRUCache(1000), mrc_options));
+  mrc_options.sampling_rate = 0.5;
+  mrc_options.capacities.clear();
+  ASSERT_EQ(nullptr, NewMissRatioCurveCache(NewLRUCache(1000), mrc_options));
+}
+
+TEST_F(SimCacheTest, MissRatioCurveProperty) {
+  auto table_options = GetTableOptions();
+  auto options = GetOptions(table_options);
+  options.disable_auto_compactions = true;
+  Reopen(options);
+  std::map<std::string, std::string> values;
+  ASSERT_FALSE(
+      db_->GetMapProperty(DB::Properties::kBlockCacheMissRatioCurve, &values));
+
+  MissRatioCurveCacheOptions mrc_options;
+  mrc_options.capacities = {1, 1024 * 1024};
+  mrc_options.sampling_rate = 1.0;
+  std::shared_ptr<MissRatioCurveCache> mrc_cache =
+      NewMissRatioCurveCache(NewLRUCache(1024 * 1024), mrc_options);
+  table_options.block_cache = mrc_cache;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  int num_block_entries = 20;
+  for (int i = 0; i < num_block_entries; i++) {
+    ASSERT_OK(Put(Key(i), "val"));
+    ASSERT_OK(Flush());
+  }
+  mrc_cache->ResetMissRatioCurve();
+  for (int t = 0; t < 2; t++) {
+    for (int i = 0; i < num_block_entries; i++) {
+      ASSERT_EQ(Get(Key(i)), "val");
+    }
+  }
+
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kBlockCacheMissRatioCurve, &values));
+  ASSERT_EQ("1.000000", values["sampling_rate"]);
+  ASSERT_GE(std::stoull(values["sampled_lookups"]), 2 * num_block_entries);
+  // Nothing fits in one byte, while everything read twice fits in 1MB
+  ASSERT_EQ(1.0, std::stod(values["miss_ratio.1"]));
+  ASSERT_LE(std::stod(values["miss_ratio.1048576"]), 0.5);
+
+  std::string value;
+  ASSERT_TRUE(
+      db_->GetProperty(DB::Properties::kBlockCacheMissRatioCurve, &value));
+  ASSERT_NE(value.find("miss ratio"), std::string::npos);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -8,15 +8,191 @@
 #include "utilities/trace/replayer_impl.h"
 
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <thread>
+#include <vector>
 
+#include "port/port.h"
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/system_clock.h"
-#include "util/threadpool_imp.h"
+#include "rocksdb/write_batch.h"
+#include "util/fastrange.h"
+#include "util/hash.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+
+// Maps the keys accessed by a TraceRecord to the `num_partitions` replay
+// partitions they fall into.
+class ReplayPartitioner : public WriteBatch::Handler {
+ public:
+  explicit ReplayPartitioner(size_t num_partitions)
+      : num_partitions_(num_partitions), touched_(num_partitions, false) {}
+
+  // Returns the number of partitions the keys of `record` fall into, and
+  // marks them in `*touched`. If the keys cannot be told, all the partitions
+  // are marked.
+  size_t GetPartitions(const TraceRecord& record, std::vector<bool>* touched) {
+    switch (record.GetTraceType()) {
+      case kTraceWrite: {
+        WriteBatch batch(static_cast<const WriteQueryTraceRecord&>(record)
+                             .GetWriteBatchRep()
+                             .ToString());
+        if (!batch.Iterate(this).ok()) {
+          unknown_ = true;
+        }
+        break;
+      }
+      case kTraceGet: {
+        const auto& get = static_cast<const GetQueryTraceRecord&>(record);
+        AddKey(get.GetColumnFamilyID(), get.GetKey());
+        break;
+      }
+      case kTraceIteratorSeek:
+      case kTraceIteratorSeekForPrev: {
+        // Only ordered with respect to the seek target, not the keys visited
+        const auto& seek =
+            static_cast<const IteratorSeekQueryTraceRecord&>(record);
+        AddKey(seek.GetColumnFamilyID(), seek.GetKey());
+        break;
+      }
+      case kTraceMultiGet: {
+        const auto& multi_get =
+            static_cast<const MultiGetQueryTraceRecord&>(record);
+        std::vector<uint32_t> cf_ids = multi_get.GetColumnFamilyIDs();
+        std::vector<Slice> keys = multi_get.GetKeys();
+        for (size_t i = 0; i < keys.size() && i < cf_ids.size(); ++i) {
+          AddKey(cf_ids[i], keys[i]);
+        }
+        break;
+      }
+      default:
+        unknown_ = true;
+        break;
+    }
+    if (unknown_) {
+      touched_.assign(num_partitions_, true);
+      num_touched_ = num_partitions_;
+    }
+    *touched = std::move(touched_);
+    return num_touched_;
+  }
+
+  Status PutCF(uint32_t column_family_id, const Slice& key,
+               const Slice& /*value*/) override {
+    AddKey(column_family_id, key);
+    return Status::OK();
+  }
+  Status PutEntityCF(uint32_t column_family_id, const Slice& key,
+                     const Slice& /*entity*/) override {
+    AddKey(column_family_id, key);
+    return Status::OK();
+  }
+  Status DeleteCF(uint32_t column_family_id, const Slice& key) override {
+    AddKey(column_family_id, key);
+    return Status::OK();
+  }
+  Status SingleDeleteCF(uint32_t column_family_id, const Slice& key) override {
+    AddKey(column_family_id, key);
+    return Status::OK();
+  }
+  Status DeleteRangeCF(uint32_t /*column_family_id*/,
+                       const Slice& /*begin_key*/,
+                       const Slice& /*end_key*/) override {
+    unknown_ = true;
+    return Status::OK();
+  }
+  Status MergeCF(uint32_t column_family_id, const Slice& key,
+                 const Slice& /*value*/) override {
+    AddKey(column_family_id, key);
+    return Status::OK();
+  }
+  Status PutBlobIndexCF(uint32_t column_family_id, const Slice& key,
+                        const Slice& /*value*/) override {
+    AddKey(column_family_id, key);
+    return Status::OK();
+  }
+
+  bool Continue() override { return !unknown_; }
+
+ private:
+  void AddKey(uint32_t column_family_id, const Slice& key) {
+    size_t partition = FastRange64(
+        Hash64(key.data(), key.size(), column_family_id), num_partitions_);
+    if (!touched_[partition]) {
+      touched_[partition] = true;
+      ++num_touched_;
+    }
+  }
+
+  const size_t num_partitions_;
+  std::vector<bool> touched_;
+  size_t num_touched_ = 0;
+  bool unknown_ = false;
+};
+
+// The TraceRecords of one replay partition, executed in trace order by one
+// thread.
+class ReplayPartition {
+ public:
+  // Blocks while too many records are queued, so reading the trace does not
+  // run arbitrarily far ahead of the replay.
+  void Add(std::unique_ptr<ReplayerWorkerArg>&& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return queue_.size() < kMaxQueuedRecords; });
+    queue_.push_back(std::move(item));
+    cv_.notify_all();
+  }
+
+  // Blocks until all the queued records have been executed.
+  void WaitUntilIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return queue_.empty() && !busy_; });
+  }
+
+  // Lets Run() return once all the queued records have been executed.
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    cv_.notify_all();
+  }
+
+  void Run(const std::function<void(ReplayerWorkerArg*)>& execute) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] { return !queue_.empty() || closed_; });
+      if (queue_.empty()) {
+        return;
+      }
+      std::unique_ptr<ReplayerWorkerArg> item = std::move(queue_.front());
+      queue_.pop_front();
+      busy_ = true;
+      // Make room for the reader
+      cv_.notify_all();
+      lock.unlock();
+      execute(item.get());
+      item.reset();
+      lock.lock();
+      busy_ = false;
+      cv_.notify_all();
+    }
+  }
+
+ private:
+  static constexpr size_t kMaxQueuedRecords = 1024;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<ReplayerWorkerArg>> queue_;
+  bool busy_ = false;
+  bool closed_ = false;
+};
+
+}  // namespace
+
 ReplayerImpl::ReplayerImpl(DB* db,
                            const std::vector<ColumnFamilyHandle*>& handles,
                            std::unique_ptr<TraceReader>&& reader)
@@ -148,10 +324,19 @@ Status ReplayerImpl::Replay(
       }
     }
   } else {
-    // Multi-threaded replay.
-    ThreadPoolImpl thread_pool;
-    thread_pool.SetHostEnv(env_);
-    thread_pool.SetBackgroundThreads(static_cast<int>(options.num_threads));
+    // Multi-threaded replay. Records are partitioned by the keys they access,
+    // and each partition is replayed in trace order by its own thread, so
+    // operations on the same key are executed in the order they were traced.
+    // This thread reads and decodes the trace ahead of the replay threads,
+    // which wait for the scheduled time of each record themselves. A record
+    // whose keys fall into different partitions, e.g. a write batch of
+    // several keys, waits until the replay threads of just those partitions
+    // have executed everything queued before it, and is then executed by
+    // this thread; the other partitions keep replaying meanwhile. Records
+    // whose partitions cannot be told, like range deletions, wait for every
+    // partition. No later record is read until it has executed.
+    const size_t num_partitions = options.num_threads;
+    std::vector<ReplayPartition> partitions(num_partitions);
 
     std::mutex mtx;
     // Background decoding and execution status.
@@ -180,11 +365,37 @@ Status ReplayerImpl::Replay(
         last_err_ts = err_ts;
       }
     };
+    auto bg_ok = [&mtx, &bg_s]() {
+      std::lock_guard<std::mutex> gd(mtx);
+      return bg_s.ok();
+    };
+    std::function<void(ReplayerWorkerArg*)> execute =
+        [this, &error_cb, &result_callback](ReplayerWorkerArg* item) {
+          if (item->execute_at > std::chrono::system_clock::now()) {
+            std::this_thread::sleep_until(item->execute_at);
+          }
+          Status es;
+          if (result_callback == nullptr) {
+            es = Execute(item->record, nullptr);
+          } else {
+            std::unique_ptr<TraceRecordResult> res;
+            es = Execute(item->record, &res);
+            result_callback(es, std::move(res));
+          }
+          error_cb(es, item->trace_ts);
+        };
+
+    std::vector<port::Thread> threads;
+    threads.reserve(num_partitions);
+    for (size_t i = 0; i < num_partitions; ++i) {
+      threads.emplace_back(
+          [&partitions, &execute, i]() { partitions[i].Run(execute); });
+    }
 
     std::chrono::system_clock::time_point replay_epoch =
         std::chrono::system_clock::now();
 
-    while (bg_s.ok() && s.ok()) {
+    while (s.ok() && bg_ok()) {
       Trace trace;
       s = ReadTrace(&trace);
       // If already at trace end, ReadTrace should return Status::Incomplete().
@@ -192,47 +403,60 @@ Status ReplayerImpl::Replay(
         break;
       }
 
-      TraceType trace_type = trace.type;
-
-      // No need to sleep before breaking the loop if at the trace end.
-      if (trace_type == kTraceEnd) {
+      if (trace.type == kTraceEnd) {
         trace_end_ = true;
         s = Status::Incomplete("Trace end.");
         break;
       }
 
-      // In multi-threaded replay, sleep first then start decoding and
-      // execution in a thread.
-      std::chrono::system_clock::time_point sleep_to =
+      std::unique_ptr<ReplayerWorkerArg> item(new ReplayerWorkerArg);
+      item->trace_ts = trace.ts;
+      item->execute_at =
           replay_epoch +
           std::chrono::microseconds(static_cast<uint64_t>(std::llround(
               1.0 * (trace.ts - header_ts_) / options.fast_forward)));
-      if (sleep_to > std::chrono::system_clock::now()) {
-        std::this_thread::sleep_until(sleep_to);
+      s = TracerHelper::DecodeTraceRecord(&trace, trace_file_version_,
+                                          &item->record);
+      // Skip unsupported traces, stop for other errors.
+      if (s.IsNotSupported()) {
+        if (result_callback != nullptr) {
+          result_callback(s, nullptr);
+        }
+        s = Status::OK();
+        continue;
+      }
+      if (!s.ok()) {
+        break;
       }
 
-      if (trace_type == kTraceWrite || trace_type == kTraceGet ||
-          trace_type == kTraceIteratorSeek ||
-          trace_type == kTraceIteratorSeekForPrev ||
-          trace_type == kTraceMultiGet) {
-        std::unique_ptr<ReplayerWorkerArg> ra(new ReplayerWorkerArg);
-        ra->trace_entry = std::move(trace);
-        ra->handler = exec_handler_.get();
-        ra->trace_file_version = trace_file_version_;
-        ra->error_cb = error_cb;
-        ra->result_cb = result_callback;
-        thread_pool.Schedule(&ReplayerImpl::BackgroundWork, ra.release(),
-                             nullptr, nullptr);
+      std::vector<bool> touched;
+      size_t num_touched = ReplayPartitioner(num_partitions)
+                               .GetPartitions(*item->record, &touched);
+      if (num_touched == 1) {
+        size_t partition = 0;
+        while (!touched[partition]) {
+          ++partition;
+        }
+        partitions[partition].Add(std::move(item));
       } else {
-        // Skip unsupported traces.
-        if (result_callback != nullptr) {
-          result_callback(Status::NotSupported("Unsupported trace type."),
-                          nullptr);
+        // Only has to be ordered after the earlier records of the partitions
+        // it accesses. Later records are not read until it has executed.
+        for (size_t i = 0; i < num_partitions; ++i) {
+          if (touched[i]) {
+            partitions[i].WaitUntilIdle();
+          }
         }
+        execute(item.get());
       }
     }
 
-    thread_pool.WaitForJobsAndJoinAllThreads();
+    for (auto& p : partitions) {
+      p.Close();
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    // Errors of earlier TraceRecords take precedence
     if (!bg_s.ok()) {
       s = bg_s;
     }
@@ -282,35 +506,5 @@ Status ReplayerImpl::ReadTrace(Trace* trace) {
   return TracerHelper::DecodeTrace(encoded_trace, trace);
 }
 
-void ReplayerImpl::BackgroundWork(void* arg) {
-  std::unique_ptr<ReplayerWorkerArg> ra(
-      reinterpret_cast<ReplayerWorkerArg*>(arg));
-  assert(ra != nullptr);
-
-  std::unique_ptr<TraceRecord> record;
-  Status s = TracerHelper::DecodeTraceRecord(&(ra->trace_entry),
-                                             ra->trace_file_version, &record);
-  if (!s.ok()) {
-    // Stop the replay
-    if (ra->error_cb != nullptr) {
-      ra->error_cb(s, ra->trace_entry.ts);
-    }
-    // Report the result
-    if (ra->result_cb != nullptr) {
-      ra->result_cb(s, nullptr);
-    }
-    return;
-  }
-
-  if (ra->result_cb == nullptr) {
-    s = record->Accept(ra->handler, nullptr);
-  } else {
-    std::unique_ptr<TraceRecordResult> res;
-    s = record->Accept(ra->handler, &res);
-    ra->result_cb(s, std::move(res));
-  }
-  record.reset();
-}
-
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // ROCKSDB_LITE
@@ -7,6 +7,7 @@
 #ifndef ROCKSDB_LITE
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -52,9 +53,6 @@ class ReplayerImpl : public Replayer {
   Status ReadHeader(Trace* header);
   Status ReadTrace(Trace* trace);
 
-  // Generic function to execute a Trace in a thread pool.
-  static void BackgroundWork(void* arg);
-
   std::unique_ptr<TraceReader> trace_reader_;
   std::mutex mutex_;
   std::atomic<bool> prepared_;
@@ -68,18 +66,14 @@ class ReplayerImpl : public Replayer {
   int trace_file_version_;
 };
 
-// Arguments passed to BackgroundWork() for replaying in a thread pool.
+// A decoded TraceRecord waiting to be replayed by a replay thread.
 struct ReplayerWorkerArg {
-  Trace trace_entry;
-  int trace_file_version;
-  // Handler to execute TraceRecord.
-  TraceRecord::Handler* handler;
-  // Callback function to report the error status and the timestamp of the
-  // TraceRecord (not the start/end timestamp of executing the TraceRecord).
-  std::function<void(Status, uint64_t)> error_cb;
-  // Callback function to report the trace execution status and operation
-  // execution status/result(s).
-  std::function<void(Status, std::unique_ptr<TraceRecordResult>&&)> result_cb;
+  std::unique_ptr<TraceRecord> record;
+  // Timestamp of the TraceRecord in the trace (not the start/end timestamp of
+  // executing the TraceRecord), to report errors by.
+  uint64_t trace_ts = 0;
+  // When the TraceRecord is to be executed, scaled by fast forwarding.
+  std::chrono::system_clock::time_point execute_at;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -6,6 +6,12 @@
 
 #include "utilities/ttl/db_ttl_impl.h"
 
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <utility>
+
+#include "db/column_family.h"
 #include "db/write_batch_internal.h"
 #include "file/filename.h"
 #include "logging/logging.h"
@@ -16,9 +22,13 @@
 #include "rocksdb/utilities/db_ttl.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "rocksdb/utilities/options_type.h"
+#include "util/cast_util.h"
 #include "util/coding.h"
 
 namespace ROCKSDB_NAMESPACE {
+const std::string DBWithTTLImpl::kNewestTimestampProperty =
+    "rocksdb.ttl.newest-timestamp";
+
 static std::unordered_map<std::string, OptionTypeInfo> ttl_merge_op_type_info =
     {{"user_operator",
       OptionTypeInfo::AsCustomSharedPtr<MergeOperator>(
@@ -170,6 +180,58 @@ void DBWithTTLImpl::SanitizeOptions(int32_t ttl, ColumnFamilyOptions* options,
     options->merge_operator.reset(
         new TtlMergeOperator(options->merge_operator, clock));
   }
+
+  auto& collectors = options->table_properties_collector_factories;
+  if (std::none_of(collectors.begin(), collectors.end(),
+                   [](const std::shared_ptr<TablePropertiesCollectorFactory>&
+                          factory) {
+                     return factory && factory->IsInstanceOf(
+                                           TtlTablePropertiesCollectorFactory::
+                                               kClassName());
+                   })) {
+    collectors.push_back(
+        std::make_shared<TtlTablePropertiesCollectorFactory>());
+  }
+}
+
+Status TtlTablePropertiesCollector::AddUserKey(const Slice& /*key*/,
+                                               const Slice& value,
+                                               EntryType type,
+                                               SequenceNumber /*seq*/,
+                                               uint64_t /*file_size*/) {
+  if (!all_values_) {
+    return Status::OK();
+  }
+  if (type != kEntryPut || !DBWithTTLImpl::SanityCheckTimestamp(value).ok()) {
+    // Deletions shadow older entries and merge operands are not removed by
+    // the compaction filter, so such files are never dropped as expired
+    all_values_ = false;
+    return Status::OK();
+  }
+  int32_t timestamp = DecodeFixed32(value.data() + value.size() -
+                                    DBWithTTLImpl::kTSLength);
+  newest_timestamp_ = std::max(newest_timestamp_, timestamp);
+  return Status::OK();
+}
+
+Status TtlTablePropertiesCollector::Finish(
+    UserCollectedProperties* properties) {
+  if (all_values_ && newest_timestamp_ > 0) {
+    std::string encoded;
+    PutFixed32(&encoded, static_cast<uint32_t>(newest_timestamp_));
+    properties->insert({DBWithTTLImpl::kNewestTimestampProperty, encoded});
+  }
+  return Status::OK();
+}
+
+UserCollectedProperties TtlTablePropertiesCollector::GetReadableProperties()
+    const {
+  UserCollectedProperties readable;
+  if (all_values_ && newest_timestamp_ > 0) {
+    readable.insert({DBWithTTLImpl::kNewestTimestampProperty,
+                     std::to_string(newest_timestamp_)});
+  }
+  return readable;
 }
 
 static std::unordered_map<std::string, OptionTypeInfo> ttl_type_info = {
@@ -261,6 +323,26 @@ TtlCompactionFilterFactory::CreateCompactionFilter(
       ttl_, clock_, nullptr, std::move(user_comp_filter_from_factory)));
 }
 
+bool TtlCompactionFilterFactory::ShouldDropTableFile(
+    const TableProperties& props) const {
+  if (ttl_ <= 0 || props.num_merge_operands > 0) {
+    return false;
+  }
+  const auto& user_props = props.user_collected_properties;
+  auto it = user_props.find(DBWithTTLImpl::kNewestTimestampProperty);
+  if (it == user_props.end() ||
+      it->second.size() != DBWithTTLImpl::kTSLength) {
+    return false;
+  }
+  int64_t curtime;
+  if (!clock_->GetCurrentTime(&curtime).ok()) {
+    return false;
+  }
+  // Same as DBWithTTLImpl::IsStale() for the newest value of the file
+  int32_t newest = static_cast<int32_t>(DecodeFixed32(it->second.data()));
+  return static_cast<int64_t>(newest) + ttl_ < curtime;
+}
+
 Status TtlCompactionFilterFactory::PrepareOptions(
     const ConfigOptions& config_options) {
   if (clock_ == nullptr) {
@@ -302,11 +384,20 @@ int RegisterTtlObjects(ObjectLibrary& library, const std::string& /*arg*/) {
          std::string* /* errmsg */) {
         return new TtlCompactionFilter(0, nullptr, nullptr);
       });
+  library.AddFactory<TablePropertiesCollectorFactory>(
+      TtlTablePropertiesCollectorFactory::kClassName(),
+      [](const std::string& /*uri*/,
+         std::unique_ptr<TablePropertiesCollectorFactory>* guard,
+         std::string* /* errmsg */) {
+        guard->reset(new TtlTablePropertiesCollectorFactory());
+        return guard->get();
+      });
   size_t num_types;
   return static_cast<int>(library.GetFactoryCount(&num_types));
 }
 // Open the db inside DBWithTTLImpl because options needs pointer to its ttl
-DBWithTTLImpl::DBWithTTLImpl(DB* db) : DBWithTTL(db), closed_(false) {}
+DBWithTTLImpl::DBWithTTLImpl(DB* db, bool read_only)
+    : DBWithTTL(db), closed_(false), read_only_(read_only) {}
 
 DBWithTTLImpl::~DBWithTTLImpl() {
   if (!closed_) {
@@ -384,7 +475,7 @@ Status DBWithTTL::Open(
     st = DB::Open(db_options, dbname, column_families_sanitized, handles, &db);
   }
   if (st.ok()) {
-    *dbptr = new DBWithTTLImpl(db);
+    *dbptr = new DBWithTTLImpl(db, read_only);
   } else {
     *dbptr = nullptr;
   }
@@ -592,7 +683,50 @@ Status DBWithTTLImpl::Write(const WriteOptions& opts, WriteBatch* updates) {
 
 Iterator* DBWithTTLImpl::NewIterator(const ReadOptions& opts,
                                      ColumnFamilyHandle* column_family) {
-  return new TtlIterator(db_->NewIterator(opts, column_family));
+  if (read_only_) {
+    return new TtlIterator(db_->NewIterator(opts, column_family));
+  }
+  auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(
+      column_family == nullptr ? DefaultColumnFamily() : column_family);
+  std::shared_ptr<CompactionFilterFactory> factory =
+      cfh->cfd()->ioptions()->compaction_filter_factory;
+  if (factory == nullptr || opts.snapshot != nullptr ||
+      !factory->IsInstanceOf(TtlCompactionFilterFactory::kClassName())) {
+    return new TtlIterator(db_->NewIterator(opts, column_family));
+  }
+  // Skip the files whose values have all expired and that no older file
+  // overlaps. What is read is then the same as once compaction has dropped
+  // them, which it does not while a snapshot can see them. The files are
+  // identified by their unique id, as the filter only gets their properties.
+  // Newer versions cannot add older files below them, so the list also
+  // holds after a refresh.
+  auto* db_impl = static_cast_with_check<DBImpl>(db_->GetRootDB());
+  ColumnFamilyData* cfd = cfh->cfd();
+  auto droppable =
+      std::make_shared<std::set<std::pair<std::string, uint64_t>>>();
+  SuperVersion* sv = db_impl->GetAndRefSuperVersion(cfd);
+  const VersionStorageInfo* vstorage = sv->current->storage_info();
+  for (int level = 0; level < vstorage->num_levels(); level++) {
+    for (const FileMetaData* f : vstorage->LevelFiles(level)) {
+      if (vstorage->IsDroppableFile(*cfd->ioptions(), level, *f)) {
+        std::shared_ptr<const TableProperties> props =
+            f->fd.table_reader->GetTableProperties();
+        droppable->emplace(props->db_session_id, props->orig_file_number);
+      }
+    }
+  }
+  db_impl->ReturnAndCleanupSuperVersion(cfd, sv);
+  if (droppable->empty()) {
+    return new TtlIterator(db_->NewIterator(opts, column_family));
+  }
+  ReadOptions ttl_opts = opts;
+  ttl_opts.table_filter = [droppable, user_filter = opts.table_filter](
+                              const TableProperties& props) {
+    return droppable->count({props.db_session_id, props.orig_file_number}) ==
+               0 &&
+           (!user_filter || user_filter(props));
+  };
+  return new TtlIterator(db_->NewIterator(ttl_opts, column_family));
 }
 
 void DBWithTTLImpl::SetTtl(ColumnFamilyHandle* h, int32_t ttl) {
@@ -15,6 +15,7 @@
 #include "rocksdb/db.h"
 #include "rocksdb/merge_operator.h"
 #include "rocksdb/system_clock.h"
+#include "rocksdb/table_properties.h"
 #include "rocksdb/utilities/db_ttl.h"
 #include "utilities/compaction_filters/layered_compaction_filter_base.h"
 
@@ -33,7 +34,7 @@ class DBWithTTLImpl : public DBWithTTL {
                               SystemClock* clock);
 
   static void RegisterTtlClasses();
-  explicit DBWithTTLImpl(DB* db);
+  explicit DBWithTTLImpl(DB* db, bool read_only = false);
 
   virtual ~DBWithTTLImpl();
 
@@ -101,6 +102,10 @@ class DBWithTTLImpl : public DBWithTTL {
 
   static const int32_t kMaxTimestamp = 2147483647;  // 01/18/2038:7:14PM GMT-8
 
+  // Table property holding the newest timestamp of the values in a table
+  // file, as a fixed32. Only set if all the entries of the file are values.
+  static const std::string kNewestTimestampProperty;
+
   void SetTtl(int32_t ttl) override { SetTtl(DefaultColumnFamily(), ttl); }
 
   void SetTtl(ColumnFamilyHandle* h, int32_t ttl) override;
@@ -108,6 +113,9 @@ class DBWithTTLImpl : public DBWithTTL {
  private:
   // remember whether the Close completes or not
   bool closed_;
+  // Nothing is ever compacted in read-only mode, so reads return expired
+  // entries as they are
+  const bool read_only_;
 };
 
 class TtlIterator : public Iterator {
@@ -188,6 +196,9 @@ class TtlCompactionFilterFactory : public CompactionFilterFactory {
 
   std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) override;
+  bool SupportsDroppingTableFiles() const override { return true; }
+  // Files whose values have all expired, by their newest timestamp property
+  bool ShouldDropTableFile(const TableProperties& props) const override;
   void SetTtl(int32_t ttl) { ttl_ = ttl; }
 
   const char* Name() const override { return kClassName(); }
@@ -205,6 +216,34 @@ class TtlCompactionFilterFactory : public CompactionFilterFactory {
   std::shared_ptr<CompactionFilterFactory> user_comp_filter_factory_;
 };
 
+// Collects DBWithTTLImpl::kNewestTimestampProperty
+class TtlTablePropertiesCollector : public TablePropertiesCollector {
+ public:
+  Status AddUserKey(const Slice& key, const Slice& value, EntryType type,
+                    SequenceNumber seq, uint64_t file_size) override;
+  Status Finish(UserCollectedProperties* properties) override;
+  UserCollectedProperties GetReadableProperties() const override;
+  const char* Name() const override { return "TtlTablePropertiesCollector"; }
+
+ private:
+  int32_t newest_timestamp_ = 0;
+  // Whether all the entries so far are values with a valid timestamp
+  bool all_values_ = true;
+};
+
+class TtlTablePropertiesCollectorFactory
+    : public TablePropertiesCollectorFactory {
+ public:
+  TablePropertiesCollector* CreateTablePropertiesCollector(
+      TablePropertiesCollectorFactory::Context /*context*/) override {
+    return new TtlTablePropertiesCollector();
+  }
+  static const char* kClassName() {
+    return "TtlTablePropertiesCollectorFactory";
+  }
+  const char* Name() const override { return kClassName(); }
+};
+
 class TtlMergeOperator : public MergeOperator {
  public:
   explicit TtlMergeOperator(const std::shared_ptr<MergeOperator>& merge_op,
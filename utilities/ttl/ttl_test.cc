@@ -8,12 +8,15 @@
 #include <map>
 #include <memory>
 
+#include "db/db_impl/db_impl.h"
 #include "rocksdb/compaction_filter.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/merge_operator.h"
 #include "rocksdb/utilities/db_ttl.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "test_util/testharness.h"
+#include "util/cast_util.h"
+#include "util/coding.h"
 #include "util/string_util.h"
 #include "utilities/merge_operators/bytesxor.h"
 #include "utilities/ttl/db_ttl_impl.h"
@@ -86,6 +89,12 @@ class TtlTest : public testing::Test {
     OpenTtl(ttl);
   }
 
+  // Open database with TTL support and automatic compactions disabled
+  void OpenTtlWithoutAutoCompaction(int32_t ttl) {
+    options_.disable_auto_compactions = true;
+    OpenTtl(ttl);
+  }
+
   // Open database with TTL support in read_only mode
   void OpenReadOnlyTtl(int32_t ttl) {
     ASSERT_TRUE(db_ttl_ == nullptr);
@@ -205,6 +214,17 @@ class TtlTest : public testing::Test {
     ASSERT_OK(db_ttl_->Write(wops, &wb));
   }
 
+  // Returns the number of entries seen by a TtlIterator
+  int64_t CountIterEntries() {
+    std::unique_ptr<Iterator> dbiter(db_ttl_->NewIterator(ReadOptions()));
+    int64_t count = 0;
+    for (dbiter->SeekToFirst(); dbiter->Valid(); dbiter->Next()) {
+      ++count;
+    }
+    EXPECT_OK(dbiter->status());
+    return count;
+  }
+
   // checks the whole kvmap_ to return correct values using KeyMayExist
   void SimpleKeyMayExistCheck() {
     static ReadOptions ropts;
@@ -727,6 +747,151 @@ TEST_F(TtlTest, DeleteRangeTest) {
   CloseTtl();
 }
 
+// Table files written by DBWithTTL record the newest timestamp of their
+// values, unless they also have other entries
+TEST_F(TtlTest, NewestTimestampProperty) {
+  MakeKVMap(kSampleSize_);
+
+  OpenTtl(1);
+  int64_t now;
+  ASSERT_OK(env_->GetCurrentTime(&now));
+  PutValues(0, kSampleSize_ / 2);
+  env_->Sleep(1);
+  PutValues(kSampleSize_ / 2, kSampleSize_ - kSampleSize_ / 2, false);
+  ASSERT_OK(db_ttl_->Delete(WriteOptions(), "keymock"));
+  ASSERT_OK(db_ttl_->Flush(FlushOptions()));
+
+  TablePropertiesCollection props;
+  ASSERT_OK(db_ttl_->GetPropertiesOfAllTables(&props));
+  ASSERT_EQ(props.size(), 2);
+  int num_with_property = 0;
+  for (const auto& file_props : props) {
+    const auto& user_props = file_props.second->user_collected_properties;
+    auto it = user_props.find(DBWithTTLImpl::kNewestTimestampProperty);
+    if (it != user_props.end()) {
+      ASSERT_EQ(size_t{DBWithTTLImpl::kTSLength}, it->second.size());
+      ASSERT_EQ(static_cast<int64_t>(DecodeFixed32(it->second.data())), now);
+      ++num_with_property;
+    }
+  }
+  ASSERT_EQ(num_with_property, 1);
+  CloseTtl();
+}
+
+// Iterators skip the files whose values have all expired, as compaction
+// would drop them
+TEST_F(TtlTest, IterSkipsExpiredFiles) {
+  MakeKVMap(kSampleSize_);
+
+  OpenTtlWithoutAutoCompaction(1);
+  PutValues(0, kSampleSize_ / 2);  // T=0:Insert Set1. Delete at t=1
+  ASSERT_EQ(CountIterEntries(), kSampleSize_ / 2 + 1);
+  env_->Sleep(2);
+  // T=2:Set2 has a deletion, so its file is read although expired
+  PutValues(kSampleSize_ / 2, kSampleSize_ - kSampleSize_ / 2, false);
+  ASSERT_OK(db_ttl_->Delete(WriteOptions(), "keymock"));
+  ASSERT_OK(db_ttl_->Flush(FlushOptions()));
+  ASSERT_EQ(CountIterEntries(), kSampleSize_ - kSampleSize_ / 2);
+  env_->Sleep(2);
+  ASSERT_EQ(CountIterEntries(), kSampleSize_ - kSampleSize_ / 2);
+  // T=4:Set1's file is still there until compacted
+  CompactCheck(0, kSampleSize_ / 2);
+  CloseTtl();
+}
+
+// Files whose values have all expired are deleted without being compacted
+TEST_F(TtlTest, DropExpiredFiles) {
+  MakeKVMap(kSampleSize_);
+
+  OpenTtl(1);
+  PutValues(0, kSampleSize_ / 2);  // T=0:Insert Set1. Delete at t=1
+  env_->Sleep(2);
+  // T=2:Insert Set2, whose flush lets Set1's file be dropped
+  PutValues(kSampleSize_ / 2, kSampleSize_ - kSampleSize_ / 2);
+  auto* dbimpl = static_cast_with_check<DBImpl>(db_ttl_->GetRootDB());
+  ASSERT_OK(dbimpl->TEST_WaitForCompact());
+
+  std::vector<LiveFileMetaData> files;
+  db_ttl_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(files.size(), 1);
+  CompactCheck(0, kSampleSize_ / 2, false);
+  CompactCheck(kSampleSize_ / 2, kSampleSize_ - kSampleSize_ / 2);
+  CloseTtl();
+}
+
+// Files that a live snapshot can see are kept until it is released
+TEST_F(TtlTest, DropExpiredFilesKeptForSnapshot) {
+  MakeKVMap(kSampleSize_);
+
+  OpenTtl(1);
+  PutValues(0, kSampleSize_ / 2);  // T=0:Insert Set1. Delete at t=1
+  const Snapshot* snapshot = db_ttl_->GetSnapshot();
+  env_->Sleep(2);
+  // T=2:Insert Set2. Set1's file is kept for the snapshot
+  PutValues(kSampleSize_ / 2, kSampleSize_ - kSampleSize_ / 2);
+  auto* dbimpl = static_cast_with_check<DBImpl>(db_ttl_->GetRootDB());
+  ASSERT_OK(dbimpl->TEST_WaitForCompact());
+
+  std::vector<LiveFileMetaData> files;
+  db_ttl_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(files.size(), 2);
+  ReadOptions ropts;
+  ropts.snapshot = snapshot;
+  std::unique_ptr<Iterator> iter(db_ttl_->NewIterator(ropts));
+  int64_t count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ++count;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(count, kSampleSize_ / 2 + 1);
+  iter.reset();
+
+  // Set1's file is dropped after the next flush once the snapshot is gone
+  db_ttl_->ReleaseSnapshot(snapshot);
+  PutValues(kSampleSize_ / 2, kSampleSize_ - kSampleSize_ / 2);
+  ASSERT_OK(dbimpl->TEST_WaitForCompact());
+  files.clear();
+  db_ttl_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(files.size(), 2);
+  CompactCheck(0, kSampleSize_ / 2, false);
+  CompactCheck(kSampleSize_ / 2, kSampleSize_ - kSampleSize_ / 2);
+  CloseTtl();
+}
+
+// Expired files are neither dropped nor skipped while an older file below
+// them has older versions of their keys, which would become visible
+TEST_F(TtlTest, ExpiredFilesKeptOverOlderVersions) {
+  OpenTtl(10);
+  ASSERT_OK(db_ttl_->Put(WriteOptions(), "key", "old"));  // T=0
+  ASSERT_OK(db_ttl_->Flush(FlushOptions()));
+  ASSERT_OK(db_ttl_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  // The newer version gets an older timestamp, so it expires first
+  env_->Sleep(-5);
+  ASSERT_OK(db_ttl_->Put(WriteOptions(), "key", "new"));  // T=-5
+  ASSERT_OK(db_ttl_->Flush(FlushOptions()));
+  // T=6:The newer version expired at t=5, the older one expires at t=10.
+  // Flushing another file would let the newer file be dropped
+  env_->Sleep(11);
+  ASSERT_OK(db_ttl_->Put(WriteOptions(), "other", "value"));
+  ASSERT_OK(db_ttl_->Flush(FlushOptions()));
+  auto* dbimpl = static_cast_with_check<DBImpl>(db_ttl_->GetRootDB());
+  ASSERT_OK(dbimpl->TEST_WaitForCompact());
+
+  std::vector<LiveFileMetaData> files;
+  db_ttl_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(files.size(), 3);
+  std::string value;
+  ASSERT_OK(db_ttl_->Get(ReadOptions(), "key", &value));
+  ASSERT_EQ(value, "new");
+  std::unique_ptr<Iterator> iter(db_ttl_->NewIterator(ReadOptions()));
+  iter->Seek("key");
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(iter->key(), "key");
+  ASSERT_EQ(iter->value(), "new");
+  iter.reset();
+  CloseTtl();
+}
+
 class DummyFilter : public CompactionFilter {
  public:
   bool Filter(int /*level*/, const Slice& /*key*/, const Slice& /*value*/,
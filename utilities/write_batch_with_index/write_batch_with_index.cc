@@ -8,6 +8,7 @@
 #include "rocksdb/utilities/write_batch_with_index.h"
 
 #include <memory>
+#include <unordered_map>
 
 #include "db/column_family.h"
 #include "db/db_impl/db_impl.h"
@@ -19,10 +20,43 @@
 #include "rocksdb/comparator.h"
 #include "rocksdb/iterator.h"
 #include "util/cast_util.h"
+#include "util/hash.h"
 #include "util/string_util.h"
 #include "utilities/write_batch_with_index/write_batch_with_index_internal.h"
 
 namespace ROCKSDB_NAMESPACE {
+namespace {
+Slice GetIndexEntryKey(const ReadableWriteBatch* write_batch,
+                       const WriteBatchIndexEntry* entry) {
+  return entry->search_key != nullptr
+             ? *entry->search_key
+             : Slice(write_batch->Data().data() + entry->key_offset,
+                     entry->key_size);
+}
+
+// Hashes and compares index entries by column family and key bytes
+struct IndexEntryKeyHash {
+  explicit IndexEntryKeyHash(const ReadableWriteBatch* _write_batch)
+      : write_batch(_write_batch) {}
+  size_t operator()(const WriteBatchIndexEntry* entry) const {
+    return static_cast<size_t>(GetSliceNPHash64(
+        GetIndexEntryKey(write_batch, entry), entry->column_family));
+  }
+  const ReadableWriteBatch* write_batch;
+};
+
+struct IndexEntryKeyEqual {
+  explicit IndexEntryKeyEqual(const ReadableWriteBatch* _write_batch)
+      : write_batch(_write_batch) {}
+  bool operator()(const WriteBatchIndexEntry* a,
+                  const WriteBatchIndexEntry* b) const {
+    return a->column_family == b->column_family &&
+           GetIndexEntryKey(write_batch, a) == GetIndexEntryKey(write_batch, b);
+  }
+  const ReadableWriteBatch* write_batch;
+};
+}  // namespace
+
 struct WriteBatchWithIndex::Rep {
   explicit Rep(const Comparator* index_comparator, size_t reserved_bytes = 0,
                size_t max_bytes = 0, bool _overwrite_key = false,
@@ -31,6 +65,9 @@ struct WriteBatchWithIndex::Rep {
                     index_comparator ? index_comparator->timestamp_size() : 0),
         comparator(index_comparator, &write_batch),
         skip_list(comparator, &arena),
+        pending_entries(&skip_list, &comparator),
+        latest_entries(0, IndexEntryKeyHash(&write_batch),
+                       IndexEntryKeyEqual(&write_batch)),
         overwrite_key(_overwrite_key),
         last_entry_offset(0),
         last_sub_batch_offset(0),
@@ -39,6 +76,15 @@ struct WriteBatchWithIndex::Rep {
   WriteBatchEntryComparator comparator;
   Arena arena;
   WriteBatchEntrySkipList skip_list;
+  // Entries added to the index but not yet inserted into skip_list
+  WriteBatchEntryPendingList pending_entries;
+  // In overwrite mode, the latest index entry of each key, keyed by its
+  // first index entry, for the column families whose keys are equal only if
+  // their bytes are. This finds the entry to overwrite without reading
+  // skip_list, so that the pending entries stay pending.
+  std::unordered_map<WriteBatchIndexEntry*, WriteBatchIndexEntry*,
+                     IndexEntryKeyHash, IndexEntryKeyEqual>
+      latest_entries;
   bool overwrite_key;
   size_t last_entry_offset;
   // The starting offset of the last sub-batch. A sub-batch starts right before
@@ -70,6 +116,19 @@ struct WriteBatchWithIndex::Rep {
   // put it to skip list.
   void AddNewEntry(uint32_t column_family_id);
 
+  // Whether latest_entries keeps track of the keys of a column family
+  bool TracksLatestEntries(uint32_t column_family_id) const {
+    const Comparator* ucmp = comparator.GetComparator(column_family_id);
+    return overwrite_key && ucmp->timestamp_size() == 0 &&
+           !ucmp->CanKeysWithDifferentByteContentsBeEqual();
+  }
+
+  // Returns an iterator over the index, which sees the pending entries too
+  WBWIIteratorImpl* NewIndexIterator(uint32_t column_family_id) {
+    return new WBWIIteratorImpl(column_family_id, &skip_list, &write_batch,
+                                &comparator, &pending_entries);
+  }
+
   // Clear all updates buffered in this batch.
   void Clear();
   void ClearIndex();
@@ -91,24 +150,35 @@ bool WriteBatchWithIndex::Rep::UpdateExistingEntryWithCfId(
     return false;
   }
 
-  WBWIIteratorImpl iter(column_family_id, &skip_list, &write_batch,
-                        &comparator);
-  iter.Seek(key);
-  if (!iter.Valid()) {
-    return false;
-  } else if (!iter.MatchesKey(column_family_id, key)) {
-    return false;
+  WriteBatchIndexEntry* non_const_entry;
+  if (TracksLatestEntries(column_family_id)) {
+    WriteBatchIndexEntry search_entry(&key, column_family_id,
+                                      true /* is_forward_direction */,
+                                      false /* is_seek_to_first */);
+    auto it = latest_entries.find(&search_entry);
+    if (it == latest_entries.end()) {
+      return false;
+    }
+    non_const_entry = it->second;
   } else {
-    // Move to the end of this key (NextKey-Prev)
-    iter.NextKey();  // Move to the next key
-    if (iter.Valid()) {
-      iter.Prev();  // Move back one entry
+    WBWIIteratorImpl iter(column_family_id, &skip_list, &write_batch,
+                          &comparator, &pending_entries);
+    iter.Seek(key);
+    if (!iter.Valid()) {
+      return false;
+    } else if (!iter.MatchesKey(column_family_id, key)) {
+      return false;
     } else {
-      iter.SeekToLast();
+      // Move to the end of this key (NextKey-Prev)
+      iter.NextKey();  // Move to the next key
+      if (iter.Valid()) {
+        iter.Prev();  // Move back one entry
+      } else {
+        iter.SeekToLast();
+      }
     }
+    non_const_entry = const_cast<WriteBatchIndexEntry*>(iter.GetRawEntry());
   }
-  WriteBatchIndexEntry* non_const_entry =
-      const_cast<WriteBatchIndexEntry*>(iter.GetRawEntry());
   if (LIKELY(last_sub_batch_offset <= non_const_entry->offset)) {
     last_sub_batch_offset = last_entry_offset;
     sub_batch_cnt++;
@@ -164,7 +234,14 @@ void WriteBatchWithIndex::Rep::AddNewEntry(uint32_t column_family_id) {
   auto* index_entry =
       new (mem) WriteBatchIndexEntry(last_entry_offset, column_family_id,
                                      key.data() - wb_data.data(), key.size());
-  skip_list.Insert(index_entry);
+  if (TracksLatestEntries(column_family_id)) {
+    auto r = latest_entries.emplace(index_entry, index_entry);
+    if (!r.second) {
+      // A merge onto an existing key
+      r.first->second = index_entry;
+    }
+  }
+  pending_entries.Add(index_entry);
 }
 
 void WriteBatchWithIndex::Rep::Clear() {
@@ -173,6 +250,8 @@ void WriteBatchWithIndex::Rep::Clear() {
 }
 
 void WriteBatchWithIndex::Rep::ClearIndex() {
+  pending_entries.Clear();
+  latest_entries.clear();
   skip_list.~WriteBatchEntrySkipList();
   arena.~Arena();
   new (&arena) Arena();
@@ -286,23 +365,18 @@ WriteBatch* WriteBatchWithIndex::GetWriteBatch() { return &rep->write_batch; }
 size_t WriteBatchWithIndex::SubBatchCnt() { return rep->sub_batch_cnt; }
 
 WBWIIterator* WriteBatchWithIndex::NewIterator() {
-  return new WBWIIteratorImpl(0, &(rep->skip_list), &rep->write_batch,
-                              &(rep->comparator));
+  return rep->NewIndexIterator(0);
 }
 
 WBWIIterator* WriteBatchWithIndex::NewIterator(
     ColumnFamilyHandle* column_family) {
-  return new WBWIIteratorImpl(GetColumnFamilyID(column_family),
-                              &(rep->skip_list), &rep->write_batch,
-                              &(rep->comparator));
+  return rep->NewIndexIterator(GetColumnFamilyID(column_family));
 }
 
 Iterator* WriteBatchWithIndex::NewIteratorWithBase(
     ColumnFamilyHandle* column_family, Iterator* base_iterator,
     const ReadOptions* read_options) {
-  auto wbwiii =
-      new WBWIIteratorImpl(GetColumnFamilyID(column_family), &(rep->skip_list),
-                           &rep->write_batch, &rep->comparator);
+  auto wbwiii = rep->NewIndexIterator(GetColumnFamilyID(column_family));
   return new BaseDeltaIterator(column_family, base_iterator, wbwiii,
                                GetColumnFamilyUserComparator(column_family),
                                read_options);
@@ -310,8 +384,7 @@ Iterator* WriteBatchWithIndex::NewIteratorWithBase(
 
 Iterator* WriteBatchWithIndex::NewIteratorWithBase(Iterator* base_iterator) {
   // default column family's comparator
-  auto wbwiii = new WBWIIteratorImpl(0, &(rep->skip_list), &rep->write_batch,
-                                     &rep->comparator);
+  auto wbwiii = rep->NewIndexIterator(0);
   return new BaseDeltaIterator(nullptr, base_iterator, wbwiii,
                                rep->comparator.default_comparator());
 }
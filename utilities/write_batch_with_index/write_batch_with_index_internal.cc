@@ -7,6 +7,8 @@
 
 #include "utilities/write_batch_with_index/write_batch_with_index_internal.h"
 
+#include <algorithm>
+
 #include "db/column_family.h"
 #include "db/db_impl/db_impl.h"
 #include "db/merge_context.h"
@@ -601,6 +603,18 @@ const Comparator* WriteBatchEntryComparator::GetComparator(
   return default_comparator_;
 }
 
+void WriteBatchEntryPendingList::FlushSlow() {
+  std::sort(entries_.begin(), entries_.end(),
+            [this](const WriteBatchIndexEntry* a,
+                   const WriteBatchIndexEntry* b) {
+              return (*comparator_)(a, b) < 0;
+            });
+  for (WriteBatchIndexEntry* entry : entries_) {
+    skip_list_->Insert(entry);
+  }
+  entries_.clear();
+}
+
 WriteEntry WBWIIteratorImpl::Entry() const {
   WriteEntry ret;
   Slice blob, xid;
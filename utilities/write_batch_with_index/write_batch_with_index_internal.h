@@ -185,6 +185,36 @@ class WriteBatchEntryComparator {
 using WriteBatchEntrySkipList =
     SkipList<WriteBatchIndexEntry*, const WriteBatchEntryComparator&>;
 
+// Index entries not yet inserted into the skip list. Inserting an entry in
+// the middle of the skip list costs a seek, with a comparison per level, so
+// the entries added between two reads of the index are collected here and
+// inserted in sorted order right before the next read. In sorted order most
+// insertions take the skip list's sequential insertion fast path.
+class WriteBatchEntryPendingList {
+ public:
+  WriteBatchEntryPendingList(WriteBatchEntrySkipList* skip_list,
+                             const WriteBatchEntryComparator* comparator)
+      : skip_list_(skip_list), comparator_(comparator) {}
+
+  void Add(WriteBatchIndexEntry* entry) { entries_.push_back(entry); }
+
+  // Insert all the pending entries into the skip list
+  void Flush() {
+    if (!entries_.empty()) {
+      FlushSlow();
+    }
+  }
+
+  void Clear() { entries_.clear(); }
+
+ private:
+  void FlushSlow();
+
+  WriteBatchEntrySkipList* const skip_list_;
+  const WriteBatchEntryComparator* const comparator_;
+  std::vector<WriteBatchIndexEntry*> entries_;
+};
+
 class WBWIIteratorImpl : public WBWIIterator {
  public:
   enum Result : uint8_t {
@@ -194,14 +224,18 @@ class WBWIIteratorImpl : public WBWIIterator {
     kMergeInProgress,
     kError
   };
+  // The pending entries, if any, are inserted into the skip list before the
+  // iterator moves, so that the iterator sees all the entries in the batch.
   WBWIIteratorImpl(uint32_t column_family_id,
                    WriteBatchEntrySkipList* skip_list,
                    const ReadableWriteBatch* write_batch,
-                   WriteBatchEntryComparator* comparator)
+                   WriteBatchEntryComparator* comparator,
+                   WriteBatchEntryPendingList* pending_entries = nullptr)
       : column_family_id_(column_family_id),
         skip_list_iter_(skip_list),
         write_batch_(write_batch),
-        comparator_(comparator) {}
+        comparator_(comparator),
+        pending_entries_(pending_entries) {}
 
   ~WBWIIteratorImpl() override {}
 
@@ -215,6 +249,7 @@ class WBWIIteratorImpl : public WBWIIterator {
   }
 
   void SeekToFirst() override {
+    FlushPendingEntries();
     WriteBatchIndexEntry search_entry(
         nullptr /* search_key */, column_family_id_,
         true /* is_forward_direction */, true /* is_seek_to_first */);
@@ -222,6 +257,7 @@ class WBWIIteratorImpl : public WBWIIterator {
   }
 
   void SeekToLast() override {
+    FlushPendingEntries();
     WriteBatchIndexEntry search_entry(
         nullptr /* search_key */, column_family_id_ + 1,
         true /* is_forward_direction */, true /* is_seek_to_first */);
@@ -234,6 +270,7 @@ class WBWIIteratorImpl : public WBWIIterator {
   }
 
   void Seek(const Slice& key) override {
+    FlushPendingEntries();
     WriteBatchIndexEntry search_entry(&key, column_family_id_,
                                       true /* is_forward_direction */,
                                       false /* is_seek_to_first */);
@@ -241,15 +278,22 @@ class WBWIIteratorImpl : public WBWIIterator {
   }
 
   void SeekForPrev(const Slice& key) override {
+    FlushPendingEntries();
     WriteBatchIndexEntry search_entry(&key, column_family_id_,
                                       false /* is_forward_direction */,
                                       false /* is_seek_to_first */);
     skip_list_iter_.SeekForPrev(&search_entry);
   }
 
-  void Next() override { skip_list_iter_.Next(); }
+  void Next() override {
+    FlushPendingEntries();
+    skip_list_iter_.Next();
+  }
 
-  void Prev() override { skip_list_iter_.Prev(); }
+  void Prev() override {
+    FlushPendingEntries();
+    skip_list_iter_.Prev();
+  }
 
   WriteEntry Entry() const override;
 
@@ -286,10 +330,17 @@ class WBWIIteratorImpl : public WBWIIterator {
   void AdvanceKey(bool forward);
 
  private:
+  void FlushPendingEntries() {
+    if (pending_entries_ != nullptr) {
+      pending_entries_->Flush();
+    }
+  }
+
   uint32_t column_family_id_;
   WriteBatchEntrySkipList::Iterator skip_list_iter_;
   const ReadableWriteBatch* write_batch_;
   WriteBatchEntryComparator* comparator_;
+  WriteBatchEntryPendingList* pending_entries_;
 };
 
 class WriteBatchWithIndexInternal {
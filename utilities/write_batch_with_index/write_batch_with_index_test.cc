@@ -753,6 +753,61 @@ TEST_P(WriteBatchWithIndexTest, TestWBWIIterator) {
   AssertIterEqual(iter2.get(), {"a", "b", "d", "f"});
 }
 
+TEST_P(WriteBatchWithIndexTest, TestRandomWritesAndReads) {
+  // Entries are indexed lazily, so check that reads interleaved with writes
+  // at random see all the writes before them
+  bool overwrite = GetParam();
+  Random rnd(301);
+  std::map<std::string, std::vector<std::string>> expected;
+  std::unique_ptr<WBWIIterator> live_iter(batch_->NewIterator());
+  for (int i = 0; i < 2000; i++) {
+    std::string key = "k" + std::to_string(rnd.Uniform(300));
+    std::string value;
+    if (rnd.OneIn(5)) {
+      ASSERT_OK(batch_->Delete(key));
+    } else {
+      value = "v" + std::to_string(i);
+      ASSERT_OK(batch_->Put(key, value));
+    }
+    auto& values = expected[key];
+    if (overwrite) {
+      values.clear();
+    }
+    values.push_back(value);
+
+    if (rnd.OneIn(50)) {
+      std::string read_key = "k" + std::to_string(rnd.Uniform(300));
+      std::string read_value;
+      Status s = batch_->GetFromBatch(options_, read_key, &read_value);
+      auto it = expected.find(read_key);
+      if (it == expected.end() || it->second.back().empty()) {
+        ASSERT_TRUE(s.IsNotFound());
+      } else {
+        ASSERT_OK(s);
+        ASSERT_EQ(it->second.back(), read_value);
+      }
+    }
+    if (rnd.OneIn(200)) {
+      live_iter->SeekToFirst();
+      for (const auto& kv : expected) {
+        for (const std::string& v : kv.second) {
+          ASSERT_TRUE(live_iter->Valid());
+          WriteEntry entry = live_iter->Entry();
+          ASSERT_EQ(kv.first, entry.key.ToString());
+          if (v.empty()) {
+            ASSERT_EQ(kDeleteRecord, entry.type);
+          } else {
+            ASSERT_EQ(kPutRecord, entry.type);
+            ASSERT_EQ(v, entry.value.ToString());
+          }
+          live_iter->Next();
+        }
+      }
+      ASSERT_FALSE(live_iter->Valid());
+    }
+  }
+}
+
 TEST_P(WriteBatchWithIndexTest, TestRandomIteraratorWithBase) {
   std::vector<std::string> source_strings = {"a", "b", "c", "d", "e",
                                              "f", "g", "h", "i", "j"};